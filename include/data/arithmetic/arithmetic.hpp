@@ -11,6 +11,7 @@
 #include <data/arithmetic/halves.hpp>
 #include <data/arithmetic/negativity.hpp>
 #include <data/arithmetic/carry.hpp>
+#include <data/arithmetic/limbs.hpp>
 
 #include <iostream>
 
@@ -60,11 +61,36 @@ namespace data::arithmetic {
         return std::strong_ordering::equal;
     }
 
+    namespace detail {
+        template <typename it> struct reversed_contiguous : std::false_type {};
+        template <std::contiguous_iterator it> struct reversed_contiguous<std::reverse_iterator<it>> : std::true_type {};
+
+        // iterators that go forward through contiguous memory, or all backward.
+        template <typename ito, typename sen, typename ... it> concept contiguous_same_direction = std::same_as<ito, sen> &&
+            (((std::contiguous_iterator<ito> && ... && std::contiguous_iterator<it>)) ||
+                ((reversed_contiguous<ito>::value && ... && reversed_contiguous<it>::value))) &&
+            ((sizeof (std::iter_value_t<ito>) == sizeof (std::iter_value_t<it>)) && ...);
+
+        // the lowest address of n elements beginning at i.
+        template <typename it> constexpr auto lowest_address (it i, size_t n) {
+            if constexpr (std::contiguous_iterator<it>) return std::to_address (i);
+            else return std::to_address (i.base ()) - n;
+        }
+    }
+
     template <typename digit,
         std::output_iterator<digit> ito,
         std::sentinel_for<ito> sen,
         std::input_iterator iti>
     constexpr void bit_negate (ito o, sen z, iti i) {
+        // bitwise operations don't care about endianness, so we can
+        // go through memory a limb at a time as long as we can go
+        // through all the inputs and outputs in the same direction.
+        if constexpr (detail::contiguous_same_direction<ito, sen, iti>) if (!std::is_constant_evaluated ()) {
+            size_t n = z - o;
+            return limbs::bit_negate (detail::lowest_address (o, n), detail::lowest_address (i, n), n * sizeof (*o));
+        }
+
         while (o != z) {
             *o = ~ *i;
             o++;
@@ -78,6 +104,12 @@ namespace data::arithmetic {
         std::input_iterator ita,
         std::input_iterator itb>
     constexpr void bit_and (ito i, sen z, ita a, itb b) {
+        if constexpr (detail::contiguous_same_direction<ito, sen, ita, itb>) if (!std::is_constant_evaluated ()) {
+            size_t n = z - i;
+            return limbs::bit_and (detail::lowest_address (i, n),
+                detail::lowest_address (a, n), detail::lowest_address (b, n), n * sizeof (*i));
+        }
+
         while (i != z) {
             *i = *a & *b;
             i++;
@@ -92,6 +124,12 @@ namespace data::arithmetic {
         std::input_iterator ita,
         std::input_iterator itb>
     constexpr void bit_or (ito i, sen z, ita a, itb b) {
+        if constexpr (detail::contiguous_same_direction<ito, sen, ita, itb>) if (!std::is_constant_evaluated ()) {
+            size_t n = z - i;
+            return limbs::bit_or (detail::lowest_address (i, n),
+                detail::lowest_address (a, n), detail::lowest_address (b, n), n * sizeof (*i));
+        }
+
         while (i != z) {
             *i = *a | *b;
             i++;
@@ -106,6 +144,12 @@ namespace data::arithmetic {
         std::input_iterator ita,
         std::input_iterator itb>
     constexpr void bit_xor (ito i, sen z, ita a, itb b) {
+        if constexpr (detail::contiguous_same_direction<ito, sen, ita, itb>) if (!std::is_constant_evaluated ()) {
+            size_t n = z - i;
+            return limbs::bit_xor (detail::lowest_address (i, n),
+                detail::lowest_address (a, n), detail::lowest_address (b, n), n * sizeof (*i));
+        }
+
         while (i != z) {
             *i = *a ^ *b;
             i++;
@@ -491,6 +535,10 @@ namespace data::arithmetic {
     template <negativity c, range X>
     constexpr std::strong_ordering compare (X a, X b) {
         if constexpr (c == negativity::nones) {
+            // Words of digits that fit in a limb are compared a limb
+            // at a time by compare_limbs, which is in words.hpp.
+            if constexpr (requires { compare_limbs (a, b); })
+                if (!std::is_constant_evaluated ()) return compare_limbs (a, b);
 
             auto za = size (a);
             auto zb = size (b);
@@ -0,0 +1,793 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_ARITHMETIC_LIMBS
+#define DATA_ARITHMETIC_LIMBS
+
+#include <bit>
+#include <cstring>
+#include <vector>
+#include <data/types.hpp>
+#include <data/tools/small_vector.hpp>
+
+// add_carry and sub_borrow use the compiler's carry builtins if there are
+// any, or else the x86-64 intrinsics. FORCE_CARRY_FALLBACK turns both off.
+#if !defined(FORCE_CARRY_FALLBACK) && defined(__has_builtin)
+#if __has_builtin(__builtin_addcll) && __has_builtin(__builtin_subcll)
+#define DATA_LIMBS_BUILTIN_CARRY
+#endif
+#endif
+
+#if !defined(FORCE_CARRY_FALLBACK) && !defined(DATA_LIMBS_BUILTIN_CARRY) && defined(__x86_64__)
+#define DATA_LIMBS_X86_CARRY
+#include <immintrin.h>
+#endif
+
+// Arithmetic on little-endian arrays of machine words (limbs).
+//
+// Numbers like N_bytes are stored as strings of bytes in either endian order,
+// which is convenient to work with but slow to do arithmetic on a byte at a
+// time. For expensive operations we copy the digits into limbs, do the work
+// there, and copy the result back.
+namespace data::arithmetic::limbs {
+
+#if defined(__SIZEOF_INT128__)
+    using limb = uint64;
+    using limb_twice = unsigned __int128;
+#else
+    using limb = uint32;
+    using limb_twice = uint64;
+#endif
+
+    constexpr static size_t limb_bits = sizeof (limb) * 8;
+
+    // Below this size (in limbs of the smaller operand) we use schoolbook multiplication.
+    constexpr static size_t karatsuba_threshold = 24;
+
+    // At or above this size we use Toom-3 instead of Karatsuba.
+    constexpr static size_t toom3_threshold = 384;
+
+    // Division by a divisor of at least this many limbs uses Burnikel-Ziegler
+    // recursive division instead of Knuth's algorithm D.
+    constexpr static size_t burnikel_ziegler_threshold = 48;
+
+    // a buffer for limbs that does not allocate for small numbers.
+    using buffer = small_vector<limb, 32>;
+
+    // r = a + b + carry, where carry is 0 or 1, return the carry out.
+    limb add_carry (limb &r, limb a, limb b, limb carry);
+
+    // r = a - b - borrow, where borrow is 0 or 1, return the borrow out.
+    limb sub_borrow (limb &r, limb a, limb b, limb borrow);
+
+    // read and write a limb at an address that need not be aligned.
+    limb load (const void *p);
+    void store (void *p, limb x);
+
+    // bitwise operations on n bytes of memory a limb at a time.
+    // The output may be the same as either input.
+    void bit_negate (void *o, const void *a, size_t n);
+    void bit_and (void *o, const void *a, const void *b, size_t n);
+    void bit_or (void *o, const void *a, const void *b, size_t n);
+    void bit_xor (void *o, const void *a, const void *b, size_t n);
+
+    // r = a + b, return the carry.
+    limb add_n (limb *r, const limb *a, const limb *b, size_t n);
+
+    // r = a - b, return the borrow.
+    limb sub_n (limb *r, const limb *a, const limb *b, size_t n);
+
+    // r[0, rn) += b[0, bn) where bn <= rn, return the carry.
+    limb add_to (limb *r, size_t rn, const limb *b, size_t bn);
+
+    // r[0, rn) -= b[0, bn) where bn <= rn, return the borrow.
+    limb sub_from (limb *r, size_t rn, const limb *b, size_t bn);
+
+    int compare_n (const limb *a, const limb *b, size_t n);
+
+    // r[0, n) = a[0, n) * b, return the high limb.
+    limb mul_1 (limb *r, const limb *a, size_t n, limb b);
+
+    // r[0, n) += a[0, n) * b, return the carry.
+    limb addmul_1 (limb *r, const limb *a, size_t n, limb b);
+
+    // r[0, an + bn) = a * b with the simple quadratic algorithm.
+    void schoolbook (limb *r, const limb *a, size_t an, const limb *b, size_t bn);
+
+    // r[0, 2n) = a * b using Karatsuba's method.
+    void karatsuba (limb *r, const limb *a, const limb *b, size_t n);
+
+    // r[0, 2n) = a * b using Toom-Cook 3-way multiplication.
+    void toom3 (limb *r, const limb *a, const limb *b, size_t n);
+
+    // r[0, an + bn) = a * b, choosing an algorithm by size.
+    // r must not overlap a or b.
+    void multiply (limb *r, const limb *a, size_t an, const limb *b, size_t bn);
+
+    // r[0, 2n) = a * b for operands of equal size.
+    void multiply_n (limb *r, const limb *a, const limb *b, size_t n);
+
+    // r[0, 2n) = a * a.
+    void square_n (limb *r, const limb *a, size_t n);
+
+    // r[0, n) -= a[0, n) * b, return the borrow.
+    limb submul_1 (limb *r, const limb *a, size_t n, limb b);
+
+    // r[0, n) = a[0, n) << s, return the bits shifted out. s < limb_bits.
+    limb shift_left (limb *r, const limb *a, size_t n, unsigned s);
+
+    // r[0, n) = a[0, n) >> s. s < limb_bits.
+    void shift_right (limb *r, const limb *a, size_t n, unsigned s);
+
+    // q[0, n) = a[0, n) / d, return the remainder.
+    limb divide_1 (limb *q, const limb *a, size_t n, limb d);
+
+    // Knuth's algorithm D. v has n >= 2 limbs and its top bit is set. The top
+    // n limbs of u must be less than v. q[0, un - n) is set to u / v and the
+    // remainder is left in u[0, n).
+    void knuth (limb *q, limb *u, size_t un, const limb *v, size_t n);
+
+    // The same, but with recursive division when v is big enough.
+    void divide_normalized (limb *q, limb *u, size_t un, const limb *v, size_t n);
+
+    // q[0, an - bn + 1) = a / b and r[0, bn) = a % b, where an >= bn and the top limb of b is not zero.
+    void divide (limb *q, limb *r, const limb *a, size_t an, const limb *b, size_t bn);
+
+    // -1 / m mod 2^limb_bits for odd m.
+    limb negative_inverse (limb m);
+
+    // Montgomery reduction. With R = 2^(limb_bits n), r[0, n) = t R^-1 mod m,
+    // where t[0, 2n) < m R, m is odd and inv = negative_inverse (m[0]).
+    // t is overwritten and r must not overlap it.
+    void redc (limb *r, limb *t, const limb *m, size_t n, limb inv);
+
+    // r[0, n) = a b R^-1 mod m, where a, b < m. t is scratch space of 2n limbs.
+    void mont_mul (limb *r, const limb *a, const limb *b, const limb *m, size_t n, limb inv, limb *t);
+
+    // the number of digits needed to hold z[0, zn).
+    template <std::unsigned_integral digit>
+    size_t digits (const limb *z, size_t zn);
+
+    // the number of limbs needed to hold the given number of digits.
+    template <std::unsigned_integral digit>
+    constexpr size_t inline size (size_t digits) {
+        constexpr size_t per_limb = sizeof (limb) / sizeof (digit);
+        return (digits + per_limb - 1) / per_limb;
+    }
+
+    template <std::unsigned_integral digit>
+    size_t inline digits (const limb *z, size_t zn) {
+        constexpr size_t per_limb = sizeof (limb) / sizeof (digit);
+        while (zn > 0 && z[zn - 1] == 0) zn--;
+        if (zn == 0) return 0;
+        constexpr size_t digit_bits = sizeof (digit) * 8;
+        return (zn - 1) * per_limb + (std::bit_width (z[zn - 1]) + digit_bits - 1) / digit_bits;
+    }
+
+    // read digits from least to most significant into z, which must be zeroed and big enough.
+    template <std::unsigned_integral digit, typename it, typename sen>
+    void read (limb *z, it i, sen e) {
+        constexpr size_t per_limb = sizeof (limb) / sizeof (digit);
+        if constexpr (per_limb == 1) for (; i != e; i++, z++) *z = *i;
+        else for (size_t n = 0; i != e; i++, n++)
+            z[n / per_limb] |= static_cast<limb> (*i) << (n % per_limb * sizeof (digit) * 8);
+    }
+
+    // write digits from least to most significant, stopping at e.
+    template <std::unsigned_integral digit, typename it, typename sen>
+    void write (it i, sen e, const limb *z, size_t zn) {
+        constexpr size_t per_limb = sizeof (limb) / sizeof (digit);
+        size_t max = zn * per_limb;
+        for (size_t n = 0; i != e; i++, n++)
+            *i = n < max ? static_cast<digit> (z[n / per_limb] >> (n % per_limb * sizeof (digit) * 8)) : digit {0};
+    }
+
+    inline limb add_carry (limb &r, limb a, limb b, limb carry) {
+#if defined(DATA_LIMBS_BUILTIN_CARRY) && defined(__SIZEOF_INT128__)
+        unsigned long long out;
+        r = __builtin_addcll (a, b, carry, &out);
+        return out;
+#elif defined(DATA_LIMBS_X86_CARRY)
+        unsigned long long x;
+        limb out = _addcarry_u64 (static_cast<unsigned char> (carry), a, b, &x);
+        r = x;
+        return out;
+#else
+        limb s = a + carry;
+        limb out = s < carry;
+        r = s + b;
+        return out + (r < s);
+#endif
+    }
+
+    inline limb sub_borrow (limb &r, limb a, limb b, limb borrow) {
+#if defined(DATA_LIMBS_BUILTIN_CARRY) && defined(__SIZEOF_INT128__)
+        unsigned long long out;
+        r = __builtin_subcll (a, b, borrow, &out);
+        return out;
+#elif defined(DATA_LIMBS_X86_CARRY)
+        unsigned long long x;
+        limb out = _subborrow_u64 (static_cast<unsigned char> (borrow), a, b, &x);
+        r = x;
+        return out;
+#else
+        limb d = a - b;
+        limb out = a < b;
+        r = d - borrow;
+        return out + (d < borrow);
+#endif
+    }
+
+    inline limb load (const void *p) {
+        limb x;
+        std::memcpy (&x, p, sizeof (limb));
+        return x;
+    }
+
+    inline void store (void *p, limb x) {
+        std::memcpy (p, &x, sizeof (limb));
+    }
+
+    namespace detail {
+        template <typename f> void inline bitwise (byte *o, const byte *a, const byte *b, size_t n, f op) {
+            size_t i = 0;
+            for (; i + sizeof (limb) <= n; i += sizeof (limb)) store (o + i, op (load (a + i), load (b + i)));
+            for (; i < n; i++) o[i] = static_cast<byte> (op (a[i], b[i]));
+        }
+    }
+
+    inline void bit_negate (void *o, const void *a, size_t n) {
+        const byte *x = static_cast<const byte *> (a);
+        detail::bitwise (static_cast<byte *> (o), x, x, n, [] (limb x, limb) -> limb {
+            return ~x;
+        });
+    }
+
+    inline void bit_and (void *o, const void *a, const void *b, size_t n) {
+        detail::bitwise (static_cast<byte *> (o), static_cast<const byte *> (a), static_cast<const byte *> (b), n,
+            [] (limb x, limb y) -> limb {
+                return x & y;
+            });
+    }
+
+    inline void bit_or (void *o, const void *a, const void *b, size_t n) {
+        detail::bitwise (static_cast<byte *> (o), static_cast<const byte *> (a), static_cast<const byte *> (b), n,
+            [] (limb x, limb y) -> limb {
+                return x | y;
+            });
+    }
+
+    inline void bit_xor (void *o, const void *a, const void *b, size_t n) {
+        detail::bitwise (static_cast<byte *> (o), static_cast<const byte *> (a), static_cast<const byte *> (b), n,
+            [] (limb x, limb y) -> limb {
+                return x ^ y;
+            });
+    }
+
+    inline limb add_n (limb *r, const limb *a, const limb *b, size_t n) {
+        limb carry = 0;
+        for (size_t i = 0; i < n; i++) carry = add_carry (r[i], a[i], b[i], carry);
+        return carry;
+    }
+
+    inline limb sub_n (limb *r, const limb *a, const limb *b, size_t n) {
+        limb borrow = 0;
+        for (size_t i = 0; i < n; i++) borrow = sub_borrow (r[i], a[i], b[i], borrow);
+        return borrow;
+    }
+
+    inline limb add_to (limb *r, size_t rn, const limb *b, size_t bn) {
+        limb carry = add_n (r, r, b, bn);
+        for (size_t i = bn; carry != 0 && i < rn; i++) carry = ++r[i] == 0;
+        return carry;
+    }
+
+    inline limb sub_from (limb *r, size_t rn, const limb *b, size_t bn) {
+        limb borrow = sub_n (r, r, b, bn);
+        for (size_t i = bn; borrow != 0 && i < rn; i++) borrow = r[i]-- == 0;
+        return borrow;
+    }
+
+    inline int compare_n (const limb *a, const limb *b, size_t n) {
+        while (n-- > 0) if (a[n] != b[n]) return a[n] < b[n] ? -1 : 1;
+        return 0;
+    }
+
+    inline limb mul_1 (limb *r, const limb *a, size_t n, limb b) {
+        limb carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb_twice p = static_cast<limb_twice> (a[i]) * b + carry;
+            r[i] = static_cast<limb> (p);
+            carry = static_cast<limb> (p >> limb_bits);
+        }
+
+        return carry;
+    }
+
+    inline limb addmul_1 (limb *r, const limb *a, size_t n, limb b) {
+        limb carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb_twice p = static_cast<limb_twice> (a[i]) * b + r[i] + carry;
+            r[i] = static_cast<limb> (p);
+            carry = static_cast<limb> (p >> limb_bits);
+        }
+
+        return carry;
+    }
+
+    inline void schoolbook (limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+        if (bn == 0) {
+            std::fill (r, r + an, limb {0});
+            return;
+        }
+
+        r[an] = mul_1 (r, a, an, b[0]);
+        for (size_t j = 1; j < bn; j++) r[an + j] = addmul_1 (r + j, a, an, b[j]);
+    }
+
+    // number of limbs without leading zeros.
+    size_t inline trim (const limb *a, size_t n) {
+        while (n > 0 && a[n - 1] == 0) n--;
+        return n;
+    }
+
+    namespace detail {
+        // r[0, rn) += b[0, bn) where b may be longer than r as long as the extra limbs are zero.
+        void inline add_within (limb *r, size_t rn, const limb *b, size_t bn) {
+            add_to (r, rn, b, std::min (trim (b, bn), rn));
+        }
+
+        // |a - b| for operands of size n, return whether a < b.
+        bool inline difference (limb *r, const limb *a, const limb *b, size_t n) {
+            if (compare_n (a, b, n) < 0) {
+                sub_n (r, b, a, n);
+                return true;
+            }
+
+            sub_n (r, a, b, n);
+            return false;
+        }
+    }
+
+    // Let a = a0 + a1 X and b = b0 + b1 X. Then
+    //   a b = a0 b0 + (a0 b0 + a1 b1 - (a0 - a1)(b0 - b1)) X + a1 b1 X^2,
+    // which needs three half-size multiplications instead of four.
+    inline void karatsuba (limb *r, const limb *a, const limb *b, size_t n) {
+        using namespace detail;
+        size_t m = (n + 1) / 2;
+        size_t h = n - m;
+
+        const limb *a0 = a;
+        const limb *a1 = a + m;
+        const limb *b0 = b;
+        const limb *b1 = b + m;
+
+        // a0 b0 and a1 b1 go straight into the result.
+        multiply_n (r, a0, b0, m);
+        multiply_n (r + 2 * m, a1, b1, h);
+
+        buffer scratch (4 * m + 1);
+        limb *da = scratch.data ();
+        limb *db = da + m;
+        limb *t = db + m;
+
+        // |a0 - a1| and |b0 - b1|, with a1 and b1 extended to m limbs.
+        std::copy (a1, a1 + h, t);
+        if (h < m) t[m - 1] = 0;
+        bool na = difference (da, a0, t, m);
+        std::copy (b1, b1 + h, t);
+        if (h < m) t[m - 1] = 0;
+        bool nb = difference (db, b0, t, m);
+
+        multiply_n (t, da, db, m);
+        t[2 * m] = 0;
+
+        // the middle term, a0 b1 + a1 b0, is non-negative and fits in 2m + 1 limbs.
+        buffer mid (2 * m + 1);
+        std::copy (r, r + 2 * m, mid.data ());
+        add_to (mid.data (), 2 * m + 1, r + 2 * m, 2 * h);
+        if (na == nb) sub_from (mid.data (), 2 * m + 1, t, 2 * m + 1);
+        else add_to (mid.data (), 2 * m + 1, t, 2 * m + 1);
+
+        add_within (r + m, 2 * n - m, mid.data (), 2 * m + 1);
+    }
+
+    namespace detail {
+        // a number with a sign, for the intermediate values of Toom-3.
+        struct signed_limbs {
+            buffer Value;
+            bool Negative;
+
+            explicit signed_limbs (size_t n = 0) : Value (n), Negative {false} {}
+
+            signed_limbs (const limb *a, size_t n) : Value (a, a + n), Negative {false} {}
+
+            size_t size () const {
+                return Value.size ();
+            }
+
+            void normalize () {
+                Value.resize (trim (Value.data (), Value.size ()));
+                if (Value.size () == 0) Negative = false;
+            }
+        };
+
+        // a + b, or a - b if subtract is true.
+        signed_limbs inline combine (const signed_limbs &a, const signed_limbs &b, bool subtract) {
+            bool bn = b.Negative != subtract;
+            size_t n = std::max (a.size (), b.size ());
+            signed_limbs z (n + 1);
+            if (a.Negative == bn) {
+                std::copy (a.Value.begin (), a.Value.end (), z.Value.begin ());
+                add_to (z.Value.data (), n + 1, b.Value.data (), b.size ());
+                z.Negative = a.Negative;
+            } else {
+                // subtract the smaller magnitude from the larger.
+                buffer x (n);
+                buffer y (n);
+                std::copy (a.Value.begin (), a.Value.end (), x.begin ());
+                std::copy (b.Value.begin (), b.Value.end (), y.begin ());
+                z.Negative = difference (z.Value.data (), x.data (), y.data (), n) ? bn : a.Negative;
+            }
+
+            z.normalize ();
+            return z;
+        }
+
+        signed_limbs inline operator + (const signed_limbs &a, const signed_limbs &b) {
+            return combine (a, b, false);
+        }
+
+        signed_limbs inline operator - (const signed_limbs &a, const signed_limbs &b) {
+            return combine (a, b, true);
+        }
+
+        signed_limbs inline operator * (const signed_limbs &a, const signed_limbs &b) {
+            signed_limbs z (a.size () + b.size ());
+            if (a.size () >= b.size ()) multiply (z.Value.data (), a.Value.data (), a.size (), b.Value.data (), b.size ());
+            else multiply (z.Value.data (), b.Value.data (), b.size (), a.Value.data (), a.size ());
+            z.Negative = a.Negative != b.Negative;
+            z.normalize ();
+            return z;
+        }
+
+        signed_limbs inline twice (const signed_limbs &a) {
+            signed_limbs z (a.size () + 1);
+            for (size_t i = 0; i < a.size (); i++) {
+                z.Value[i] |= a.Value[i] << 1;
+                z.Value[i + 1] = a.Value[i] >> (limb_bits - 1);
+            }
+
+            z.Negative = a.Negative;
+            z.normalize ();
+            return z;
+        }
+
+        // a / 2, which must be exact.
+        signed_limbs inline half (signed_limbs a) {
+            for (size_t i = 0; i < a.size (); i++)
+                a.Value[i] = (a.Value[i] >> 1) | (i + 1 < a.size () ? a.Value[i + 1] << (limb_bits - 1) : 0);
+            a.normalize ();
+            return a;
+        }
+
+        // a / 3, which must be exact. Since 3 is invertible mod 2^limb_bits,
+        // we can go from the bottom up and multiply by the inverse rather than
+        // divide (Jebelean's exact division).
+        signed_limbs inline third (signed_limbs a) {
+            constexpr limb inverse = limb (~limb {0}) / 3 * 2 + 1;
+            static_assert (static_cast<limb> (inverse * 3) == 1);
+            limb borrow = 0;
+            for (size_t i = 0; i < a.size (); i++) {
+                limb s = a.Value[i];
+                limb x = s - borrow;
+                borrow = x > s;
+                limb q = x * inverse;
+                a.Value[i] = q;
+                borrow += static_cast<limb> ((static_cast<limb_twice> (q) * 3) >> limb_bits);
+            }
+
+            a.normalize ();
+            return a;
+        }
+    }
+
+    // Split a and b into three pieces, a = a0 + a1 X + a2 X^2, and evaluate
+    // them at 0, 1, -1, -2 and infinity. Five multiplications of a third of
+    // the size give us the product at those points, and the product is
+    // recovered by interpolation (Bodrato's sequence).
+    inline void toom3 (limb *r, const limb *a, const limb *b, size_t n) {
+        using namespace detail;
+        size_t k = (n + 2) / 3;
+        size_t top = n - 2 * k;
+
+        auto evaluate = [k, top] (const limb *x, signed_limbs &p0, signed_limbs &p1, signed_limbs &pm1, signed_limbs &pm2, signed_limbs &pinf) {
+            p0 = signed_limbs {x, k};
+            signed_limbs x1 {x + k, k};
+            pinf = signed_limbs {x + 2 * k, top};
+            p0.normalize ();
+            x1.normalize ();
+            pinf.normalize ();
+
+            signed_limbs s = p0 + pinf;
+            p1 = s + x1;
+            pm1 = s - x1;
+            pm2 = twice (pm1 + pinf) - p0;
+        };
+
+        signed_limbs a0, a1, am1, am2, ainf;
+        signed_limbs b0, b1, bm1, bm2, binf;
+        evaluate (a, a0, a1, am1, am2, ainf);
+        evaluate (b, b0, b1, bm1, bm2, binf);
+
+        signed_limbs r0 = a0 * b0;
+        signed_limbs v1 = a1 * b1;
+        signed_limbs vm1 = am1 * bm1;
+        signed_limbs vm2 = am2 * bm2;
+        signed_limbs r4 = ainf * binf;
+
+        signed_limbs r3 = third (vm2 - v1);
+        signed_limbs r1 = half (v1 - vm1);
+        signed_limbs r2 = vm1 - r0;
+        r3 = half (r2 - r3) + twice (r4);
+        r2 = r2 + r1 - r4;
+        r1 = r1 - r3;
+
+        std::fill (r, r + 2 * n, limb {0});
+        add_within (r, 2 * n, r0.Value.data (), r0.size ());
+        add_within (r + k, 2 * n - k, r1.Value.data (), r1.size ());
+        add_within (r + 2 * k, 2 * n - 2 * k, r2.Value.data (), r2.size ());
+        add_within (r + 3 * k, 2 * n - 3 * k, r3.Value.data (), r3.size ());
+        add_within (r + 4 * k, 2 * n - 4 * k, r4.Value.data (), r4.size ());
+    }
+
+    inline void multiply_n (limb *r, const limb *a, const limb *b, size_t n) {
+        if (n < karatsuba_threshold) schoolbook (r, a, n, b, n);
+        else if (n < toom3_threshold) karatsuba (r, a, b, n);
+        else toom3 (r, a, b, n);
+    }
+
+    // Below the Karatsuba threshold, each product a_i a_j with i != j
+    // appears twice, so we compute them once, double, and add the squares.
+    inline void square_n (limb *r, const limb *a, size_t n) {
+        if (n >= karatsuba_threshold) return multiply_n (r, a, a, n);
+
+        std::fill (r, r + 2 * n, limb {0});
+        for (size_t i = 0; i + 1 < n; i++) r[i + n] = addmul_1 (r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        shift_left (r, r, 2 * n, 1);
+
+        limb carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb_twice p = static_cast<limb_twice> (a[i]) * a[i];
+            carry = add_carry (r[2 * i], r[2 * i], static_cast<limb> (p), carry);
+            carry = add_carry (r[2 * i + 1], r[2 * i + 1], static_cast<limb> (p >> limb_bits), carry);
+        }
+    }
+
+    inline void multiply (limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+        if (an < bn) return multiply (r, b, bn, a, an);
+        if (bn < karatsuba_threshold) return schoolbook (r, a, an, b, bn);
+        if (an == bn) return multiply_n (r, a, b, an);
+
+        // a is longer than b, so we multiply b by pieces of a of the same size.
+        std::fill (r, r + an + bn, limb {0});
+        buffer piece (2 * bn);
+        for (size_t i = 0; i < an; i += bn) {
+            size_t size = std::min (bn, an - i);
+            multiply (piece.data (), a + i, size, b, bn);
+            add_to (r + i, an + bn - i, piece.data (), size + bn);
+        }
+    }
+
+    inline limb submul_1 (limb *r, const limb *a, size_t n, limb b) {
+        limb borrow = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb_twice p = static_cast<limb_twice> (a[i]) * b + borrow;
+            limb lesser = static_cast<limb> (p);
+            borrow = static_cast<limb> (p >> limb_bits);
+            limb x = r[i];
+            r[i] = x - lesser;
+            borrow += x < lesser;
+        }
+
+        return borrow;
+    }
+
+    inline limb shift_left (limb *r, const limb *a, size_t n, unsigned s) {
+        if (s == 0) {
+            std::copy (a, a + n, r);
+            return 0;
+        }
+
+        limb out = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb x = a[i];
+            r[i] = (x << s) | out;
+            out = x >> (limb_bits - s);
+        }
+
+        return out;
+    }
+
+    inline void shift_right (limb *r, const limb *a, size_t n, unsigned s) {
+        if (s == 0) {
+            std::copy (a, a + n, r);
+            return;
+        }
+
+        for (size_t i = 0; i < n; i++) r[i] = (a[i] >> s) | (i + 1 < n ? a[i + 1] << (limb_bits - s) : 0);
+    }
+
+    inline limb divide_1 (limb *q, const limb *a, size_t n, limb d) {
+        limb remainder = 0;
+        while (n-- > 0) {
+            limb_twice x = (static_cast<limb_twice> (remainder) << limb_bits) | a[n];
+            q[n] = static_cast<limb> (x / d);
+            remainder = static_cast<limb> (x % d);
+        }
+
+        return remainder;
+    }
+
+    inline void knuth (limb *q, limb *u, size_t un, const limb *v, size_t n) {
+        limb top = v[n - 1];
+        limb next = v[n - 2];
+        for (size_t j = un - n; j-- > 0;) {
+            // estimate the next digit of the quotient from the top of the remainder.
+            // After this loop it is never too small and at most one too big.
+            limb_twice x = (static_cast<limb_twice> (u[j + n]) << limb_bits) | u[j + n - 1];
+            limb_twice qhat = x / top;
+            limb_twice rhat = x - qhat * top;
+            while (qhat >> limb_bits != 0 || qhat * next > ((rhat << limb_bits) | u[j + n - 2])) {
+                qhat--;
+                rhat += top;
+                if (rhat >> limb_bits != 0) break;
+            }
+
+            limb borrow = submul_1 (u + j, v, n, static_cast<limb> (qhat));
+            limb x_top = u[j + n];
+            u[j + n] = x_top - borrow;
+
+            // the estimate was one too big, so add v back.
+            if (x_top < borrow) {
+                qhat--;
+                u[j + n] += add_n (u + j, u + j, v, n);
+            }
+
+            q[j] = static_cast<limb> (qhat);
+        }
+    }
+
+    namespace detail {
+        void divide_2n_1n (limb *q, limb *a, const limb *b, size_t n);
+
+        // divide a[0, 3h) by b[0, 2h), where the top 2h limbs of a are less than b.
+        // q[0, h) is set to the quotient and the remainder is left in a[0, 2h).
+        void inline divide_3n_2n (limb *q, limb *a, const limb *b, size_t h) {
+            const limb *b1 = b + h;
+            limb *a1 = a + 2 * h;
+
+            // r will be the remainder, which may be negative until we correct it.
+            buffer r (2 * h + 1);
+            std::copy (a, a + h, r.data ());
+
+            // estimate the quotient from the top of a and b.
+            if (compare_n (a1, b1, h) < 0) {
+                buffer t (a + h, a + 3 * h);
+                divide_2n_1n (q, t.data (), b1, h);
+                std::copy (t.data (), t.data () + h, r.data () + h);
+            } else {
+                // since a < b X, a1 must equal b1 here, and the remainder of
+                // [a1 a2] - (X - 1) b1 is a2 + b1.
+                std::fill (q, q + h, ~limb {0});
+                r[2 * h] = add_n (r.data () + h, a + h, b1, h);
+            }
+
+            buffer d (2 * h);
+            multiply (d.data (), q, h, b, h);
+            limb negative = sub_from (r.data (), 2 * h + 1, d.data (), 2 * h);
+
+            // the estimate is at most two too big.
+            while (negative != 0) {
+                limb one = 1;
+                sub_from (q, h, &one, 1);
+                if (add_to (r.data (), 2 * h + 1, b, 2 * h) != 0) negative = 0;
+            }
+
+            std::copy (r.data (), r.data () + 2 * h, a);
+            std::fill (a + 2 * h, a + 3 * h, limb {0});
+        }
+
+        // divide a[0, 2n) by b[0, n), where the top n limbs of a are less than b and the
+        // top bit of b is set. q[0, n) is set to the quotient and the remainder is left
+        // in a[0, n), with the rest of a set to zero.
+        void inline divide_2n_1n (limb *q, limb *a, const limb *b, size_t n) {
+            if (n % 2 != 0 || n < burnikel_ziegler_threshold) return knuth (q, a, 2 * n, b, n);
+
+            size_t h = n / 2;
+            divide_3n_2n (q + h, a + h, b, h);
+            divide_3n_2n (q, a, b, h);
+        }
+    }
+
+    // Burnikel and Ziegler, Fast Recursive Division (1998). Division of 2n
+    // limbs by n is done as two divisions of 3n/2 by n, each of which is a
+    // division of n by n/2 and a multiplication of size n/2. This makes
+    // division about as fast as multiplication.
+    inline void divide_normalized (limb *q, limb *u, size_t un, const limb *v, size_t vn) {
+        if (vn < burnikel_ziegler_threshold || un - vn < burnikel_ziegler_threshold) return knuth (q, u, un, v, vn);
+
+        // pad v with zeros at the bottom so that its size can be divided
+        // by two until it is below the threshold.
+        size_t m = 1;
+        while ((vn + m - 1) / m >= burnikel_ziegler_threshold) m *= 2;
+        size_t n = (vn + m - 1) / m * m;
+        size_t d = n - vn;
+
+        // split u, padded the same way, into blocks of n limbs. Since the top vn
+        // limbs of u are less than v, the top block is less than the padded v.
+        size_t blocks = (un + d + n - 1) / n;
+        buffer a (blocks * n);
+        buffer b (n);
+        buffer quotient ((blocks - 1) * n);
+        std::copy (u, u + un, a.data () + d);
+        std::copy (v, v + vn, b.data () + d);
+
+        for (size_t i = blocks - 1; i-- > 0;) detail::divide_2n_1n (quotient.data () + i * n, a.data () + i * n, b.data (), n);
+
+        std::copy (quotient.data (), quotient.data () + (un - vn), q);
+        std::copy (a.data () + d, a.data () + n, u);
+        std::fill (u + vn, u + un, limb {0});
+    }
+
+    inline void divide (limb *q, limb *r, const limb *a, size_t an, const limb *b, size_t bn) {
+        if (bn == 1) {
+            r[0] = divide_1 (q, a, an, b[0]);
+            return;
+        }
+
+        // shift so that the top bit of the divisor is set, which
+        // makes the estimates in Knuth's algorithm accurate.
+        unsigned s = std::countl_zero (b[bn - 1]);
+        buffer v (bn);
+        buffer u (an + 1);
+        shift_left (v.data (), b, bn, s);
+        u[an] = shift_left (u.data (), a, an, s);
+
+        divide_normalized (q, u.data (), an + 1, v.data (), bn);
+        shift_right (r, u.data (), bn, s);
+    }
+
+    // Newton's iteration x -> x (2 - m x) doubles the number of correct
+    // bits, and m is its own inverse mod 8.
+    inline limb negative_inverse (limb m) {
+        limb x = m;
+        for (int i = 0; i < 5; i++) x *= 2 - m * x;
+        return -x;
+    }
+
+    // At step i, add a multiple of m that clears limb i of t. The carry of
+    // each step is added to limb i + n and the bit carried out of that is
+    // added in the next step, so that at the end t / R is in t[n, 2n) plus
+    // one extra bit. This is less than 2m, so one subtraction is enough.
+    inline void redc (limb *r, limb *t, const limb *m, size_t n, limb inv) {
+        limb top = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb c = addmul_1 (t + i, m, n, t[i] * inv);
+            top = add_carry (t[i + n], t[i + n], c, top);
+        }
+
+        if (top != 0 || compare_n (t + n, m, n) >= 0) sub_n (r, t + n, m, n);
+        else std::copy (t + n, t + 2 * n, r);
+    }
+
+    inline void mont_mul (limb *r, const limb *a, const limb *b, const limb *m, size_t n, limb inv, limb *t) {
+        if (a == b) square_n (t, a, n);
+        else multiply_n (t, a, b, n);
+        redc (r, t, m, n, inv);
+    }
+
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include <data/exception.hpp>
 #include <data/slice.hpp>
 #include <data/arithmetic/arithmetic.hpp>
+#include <data/arithmetic/limbs.hpp>
 #include <data/tools/index_iterator.hpp>
 
 namespace data::arithmetic {
@@ -95,6 +96,102 @@ namespace data::arithmetic {
         
     };
 
+    namespace limbs {
+        // reverse the order of the digits in a limb.
+        template <std::unsigned_integral digit> constexpr limb reverse_digits (limb x) {
+            if constexpr (sizeof (digit) == 1) return std::byteswap (x);
+            else if constexpr (sizeof (digit) >= sizeof (limb)) return x;
+            else {
+                constexpr size_t digit_bits = sizeof (digit) * 8;
+                limb y = 0;
+                for (size_t i = 0; i < sizeof (limb) / sizeof (digit); i++) {
+                    y = (y << digit_bits) | static_cast<digit> (x);
+                    x >>= digit_bits;
+                }
+
+                return y;
+            }
+        }
+
+        // Read and write the digits of a number stored in endian order r a
+        // limb at a time. Whole limbs are loaded straight from memory and
+        // byte-swapped if r is not the native order; only the top limb, if
+        // it is partial, is assembled digit by digit.
+        template <endian::order r, std::unsigned_integral digit> struct view {
+            constexpr static size_t per_limb = sizeof (limb) / sizeof (digit);
+            constexpr static size_t digit_bits = sizeof (digit) * 8;
+            constexpr static bool swap = (r == endian::little) != (std::endian::native == std::endian::little);
+
+            digit *Data;
+            size_t Size;
+
+            view (Words<r, digit> w) : Data {w.Data.data ()}, Size {w.size ()} {}
+
+            // the number of limbs, including a partial top limb.
+            size_t limbs () const {
+                return size<digit> (Size);
+            }
+
+            // digits past the end are read as zero.
+            limb get (size_t i) const {
+                size_t first = i * per_limb;
+                if (first + per_limb <= Size) {
+                    limb x = load (r == endian::little ? Data + first : Data + Size - first - per_limb);
+                    if constexpr (swap) return reverse_digits<digit> (x);
+                    else return x;
+                }
+
+                limb x = 0;
+                for (size_t j = 0; first + j < Size; j++) x |= static_cast<limb> (at (first + j)) << (j * digit_bits);
+                return x;
+            }
+
+            // digits past the end are not written.
+            void set (size_t i, limb x) {
+                size_t first = i * per_limb;
+                if (first + per_limb <= Size) {
+                    if constexpr (swap) x = reverse_digits<digit> (x);
+                    store (r == endian::little ? Data + first : Data + Size - first - per_limb, x);
+                    return;
+                }
+
+                for (size_t j = 0; first + j < Size; j++) at (first + j) = static_cast<digit> (x >> (j * digit_bits));
+            }
+
+        private:
+            digit &at (size_t j) const {
+                return r == endian::little ? Data[j] : Data[Size - j - 1];
+            }
+        };
+
+        // the value of the bit just above the digits in the top limb of
+        // a number of the given size, which is where a carry ends up if
+        // the top limb is partial.
+        template <std::unsigned_integral digit> bool inline overflow (size_t size, limb top, limb carry) {
+            constexpr size_t per_limb = sizeof (limb) / sizeof (digit);
+            size_t extra = size % per_limb;
+            return extra == 0 ? carry != 0 : ((top >> (extra * sizeof (digit) * 8)) & 1) != 0;
+        }
+    }
+
+    // These do the same as plus, minus, compare and the bit shift
+    // operations below a limb at a time. They are used outside of constant
+    // evaluation for digits that fit in a limb.
+    template <endian::order r, std::unsigned_integral digit>
+    digit plus_limbs (Words<r, digit> &o, const Words<r, digit> &a, const Words<r, digit> &b);
+
+    template <endian::order r, std::unsigned_integral digit>
+    digit minus_limbs (Words<r, digit> &o, const Words<r, digit> &a, const Words<r, digit> &b);
+
+    template <endian::order r, std::unsigned_integral digit> requires (sizeof (digit) <= sizeof (limbs::limb))
+    std::strong_ordering compare_limbs (const Words<r, digit> &a, const Words<r, digit> &b);
+
+    template <endian::order r, std::unsigned_integral digit>
+    void bit_shift_left_limbs (Words<r, digit> &w, uint32 x, bool fill);
+
+    template <endian::order r, std::unsigned_integral digit>
+    void bit_shift_right_limbs (Words<r, digit> &w, uint32 x, bool fill);
+
     // must check that the input has at least size 1 to use.
     template <endian::order r, typename digit> constexpr void inline flip_sign_bit (Words<r, digit> x) {
         if (x[-1] & get_sign_bit<digit>::value) x[-1] &= ~get_sign_bit<digit>::value;
@@ -148,6 +245,9 @@ namespace data::arithmetic {
         if (a.size () < b.size ()) return plus (o, b, a);
         if (o.size () < a.size ()) throw exception {"need a bigger space to add numbers"};
 
+        if constexpr (std::unsigned_integral<digit> && sizeof (digit) <= sizeof (limbs::limb))
+            if (!std::is_constant_evaluated ()) return plus_limbs (o, a, b);
+
         auto oit = o.begin ();
         auto ait = a.begin ();
         auto bit = b.begin ();
@@ -169,6 +269,10 @@ namespace data::arithmetic {
     template <endian::order r, typename digit>
     constexpr digit minus (Words<r, digit> &o, const Words<r, digit> &a, const Words<r, digit> &b) {
 
+        if constexpr (std::unsigned_integral<digit> && sizeof (digit) <= sizeof (limbs::limb))
+            if (!std::is_constant_evaluated () && o.size () == a.size () && b.size () <= a.size ())
+                return minus_limbs (o, a, b);
+
         auto oit = o.begin ();
         auto ait = a.begin ();
         auto bit = b.begin ();
@@ -184,6 +288,15 @@ namespace data::arithmetic {
 
     }
 
+    template <endian::order r, std::unsigned_integral digit>
+    void times_limbs (Words<r, digit> &o, const Words<r, digit> &a, const Words<r, digit> &b);
+
+    template <endian::order r, typename digit>
+    constexpr void times_schoolbook (Words<r, digit> &o, const Words<r, digit> &a, const Words<r, digit> &b);
+
+    // o = a * b, truncated to the size of o, which must be at least as big as a and b.
+    // Outside of constant evaluation, the digits are copied into machine words and
+    // multiplied with Karatsuba or Toom-3 if they are big enough.
     template <endian::order r, typename digit>
     constexpr void times (Words<r, digit> &o, const Words<r, digit> &a, const Words<r, digit> &b) {
 
@@ -197,6 +310,134 @@ namespace data::arithmetic {
         if (a.size () < b.size ()) return times (o, b, a);
         if (a.size () > o.size ()) throw exception {} << "multiplication output must be at least as big as inputs";
 
+        if constexpr (std::unsigned_integral<digit> && sizeof (digit) <= sizeof (limbs::limb))
+            if (!std::is_constant_evaluated ()) return times_limbs (o, a, b);
+
+        for (auto io = o.begin (); io != o.end (); io++) *io = 0;
+        times_schoolbook (o, a, b);
+    }
+
+    template <endian::order r, std::unsigned_integral digit>
+    void times_limbs (Words<r, digit> &o, const Words<r, digit> &a, const Words<r, digit> &b) {
+        size_t an = limbs::size<digit> (a.size ());
+        size_t bn = limbs::size<digit> (b.size ());
+
+        limbs::buffer x (2 * (an + bn));
+        limbs::limb *la = x.data ();
+        limbs::limb *lb = la + an;
+        limbs::limb *lo = lb + bn;
+
+        limbs::read<digit> (la, a.begin (), a.end ());
+        limbs::read<digit> (lb, b.begin (), b.end ());
+
+        // leading zeros would only slow us down.
+        an = limbs::trim (la, an);
+        bn = limbs::trim (lb, bn);
+
+        if (an == 0 || bn == 0) return limbs::write<digit> (o.begin (), o.end (), lo, 0);
+
+        limbs::multiply (lo, la, an, lb, bn);
+        limbs::write<digit> (o.begin (), o.end (), lo, an + bn);
+    }
+
+    template <endian::order r, std::unsigned_integral digit>
+    digit plus_limbs (Words<r, digit> &o, const Words<r, digit> &a, const Words<r, digit> &b) {
+        limbs::view<r, digit> lo {o};
+        limbs::view<r, digit> la {a};
+        limbs::view<r, digit> lb {b};
+
+        size_t n = lo.limbs ();
+        if (n == 0) return 0;
+
+        limbs::limb carry = 0;
+        limbs::limb x;
+        for (size_t i = 0; i < n; i++) {
+            carry = limbs::add_carry (x, la.get (i), lb.get (i), carry);
+            lo.set (i, x);
+        }
+
+        return limbs::overflow<digit> (o.size (), x, carry) ? 1 : 0;
+    }
+
+    template <endian::order r, std::unsigned_integral digit>
+    digit minus_limbs (Words<r, digit> &o, const Words<r, digit> &a, const Words<r, digit> &b) {
+        limbs::view<r, digit> lo {o};
+        limbs::view<r, digit> la {a};
+        limbs::view<r, digit> lb {b};
+
+        size_t n = lo.limbs ();
+        if (n == 0) return 0;
+
+        limbs::limb borrow = 0;
+        limbs::limb x;
+        for (size_t i = 0; i < n; i++) {
+            borrow = limbs::sub_borrow (x, la.get (i), lb.get (i), borrow);
+            lo.set (i, x);
+        }
+
+        return limbs::overflow<digit> (o.size (), x, borrow) ? 1 : 0;
+    }
+
+    template <endian::order r, std::unsigned_integral digit> requires (sizeof (digit) <= sizeof (limbs::limb))
+    std::strong_ordering compare_limbs (const Words<r, digit> &a, const Words<r, digit> &b) {
+        limbs::view<r, digit> la {a};
+        limbs::view<r, digit> lb {b};
+
+        for (size_t i = std::max (la.limbs (), lb.limbs ()); i-- > 0;) {
+            limbs::limb x = la.get (i);
+            limbs::limb y = lb.get (i);
+            if (x != y) return x < y ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+
+        return std::strong_ordering::equal;
+    }
+
+    // Each limb of the result only depends on limbs of the input that
+    // are less significant (for left shifts) or more significant (for
+    // right shifts), so we can go through in the other direction in place.
+    template <endian::order r, std::unsigned_integral digit>
+    void bit_shift_left_limbs (Words<r, digit> &w, uint32 x, bool fill) {
+        using limbs::limb;
+        limbs::view<r, digit> d {w};
+        size_t n = d.limbs ();
+        size_t q = x / limbs::limb_bits;
+        unsigned s = x % limbs::limb_bits;
+        limb filler = fill ? ~limb {0} : limb {0};
+
+        for (size_t i = n; i-- > 0;) {
+            limb greater = i >= q ? d.get (i - q) : filler;
+            if (s == 0) d.set (i, greater);
+            else d.set (i, (greater << s) | ((i >= q + 1 ? d.get (i - q - 1) : filler) >> (limbs::limb_bits - s)));
+        }
+    }
+
+    template <endian::order r, std::unsigned_integral digit>
+    void bit_shift_right_limbs (Words<r, digit> &w, uint32 x, bool fill) {
+        using limbs::limb;
+        limbs::view<r, digit> d {w};
+        size_t n = d.limbs ();
+        size_t q = x / limbs::limb_bits;
+        unsigned s = x % limbs::limb_bits;
+        limb filler = fill ? ~limb {0} : limb {0};
+
+        // bits above the top digit are filled too.
+        size_t extra = w.size () % limbs::view<r, digit>::per_limb;
+        limb top = fill && extra != 0 ? ~limb {0} << (extra * sizeof (digit) * 8) : limb {0};
+        auto get = [&d, n, filler, top] (size_t j) -> limb {
+            return j < n - 1 ? d.get (j) : j == n - 1 ? d.get (j) | top : filler;
+        };
+
+        for (size_t i = 0; i < n; i++) {
+            limb lesser = get (i + q);
+            if (s == 0) d.set (i, lesser);
+            else d.set (i, (lesser >> s) | (get (i + q + 1) << (limbs::limb_bits - s)));
+        }
+    }
+
+    // add a * b to o digit by digit, where a is at least as big as b and neither is empty.
+    template <endian::order r, typename digit>
+    constexpr void times_schoolbook (Words<r, digit> &o, const Words<r, digit> &a, const Words<r, digit> &b) {
+
         auto io = o.begin ();
         auto ia = a.begin ();
         auto ib = b.begin ();
@@ -411,6 +652,9 @@ namespace data::arithmetic {
 
     template <typename digit>
     constexpr void Words<endian::little, digit>::bit_shift_left (uint32 x, bool fill) {
+        if constexpr (std::unsigned_integral<digit> && sizeof (digit) <= sizeof (limbs::limb))
+            if (!std::is_constant_evaluated ()) return bit_shift_left_limbs (*this, x, fill);
+
         arithmetic::bit_shift_left<digit> (
             std::reverse_iterator {Data.begin () + Data.size ()},
             std::reverse_iterator {Data.begin ()}, x, fill);
@@ -418,18 +662,27 @@ namespace data::arithmetic {
 
     template <typename digit>
     constexpr void Words<endian::little, digit>::bit_shift_right (uint32 x, bool fill) {
+        if constexpr (std::unsigned_integral<digit> && sizeof (digit) <= sizeof (limbs::limb))
+            if (!std::is_constant_evaluated ()) return bit_shift_right_limbs (*this, x, fill);
+
         auto it = Data.begin ();
         arithmetic::bit_shift_right<digit> (it, it + Data.size (), x, fill);
     }
     
     template <typename digit>
     constexpr void Words<endian::big, digit>::bit_shift_left (uint32 x, bool fill) {
+        if constexpr (std::unsigned_integral<digit> && sizeof (digit) <= sizeof (limbs::limb))
+            if (!std::is_constant_evaluated ()) return bit_shift_left_limbs (*this, x, fill);
+
         auto it = Data.begin ();
         arithmetic::bit_shift_left<digit> (it, it + Data.size (), x, fill);
     }
 
     template <typename digit>
     constexpr void Words<endian::big, digit>::bit_shift_right (uint32 x, bool fill) {
+        if constexpr (std::unsigned_integral<digit> && sizeof (digit) <= sizeof (limbs::limb))
+            if (!std::is_constant_evaluated ()) return bit_shift_right_limbs (*this, x, fill);
+
         arithmetic::bit_shift_right<digit> (
             std::reverse_iterator {Data.begin () + Data.size ()},
             std::reverse_iterator {Data.begin ()}, x, fill);
@@ -6,14 +6,29 @@
 #define DATA_BYTES
 
 #include <data/cross.hpp>
+#include <data/tools/small_vector.hpp>
 #include <data/array.hpp>
 #include <data/arithmetic/arithmetic.hpp>
 #include <data/arithmetic/words.hpp>
 #include <data/encoding/hex.hpp>
 #include <data/tools/lazy_writer.hpp>
 
+// bytestrings of up to this many bytes are stored without an allocation.
+// Set to zero to store all of them in a std::vector. This is set by the
+// BYTES_INLINE_CAPACITY option in CMake and comes with Data::core. It
+// changes the layout of bytestring, so it must be the same for the library
+// and everything that uses it, and there is no default.
+#ifndef DATA_BYTES_INLINE_CAPACITY
+#error "DATA_BYTES_INLINE_CAPACITY is not defined. Link against Data::core or define it as the library was built."
+#endif
+
 namespace data {
 
+    template <std::integral word> using bytes_storage = std::conditional_t<
+        (DATA_BYTES_INLINE_CAPACITY >= sizeof (word)),
+        small_vector<word, std::max<size_t> (DATA_BYTES_INLINE_CAPACITY / sizeof (word), 1)>,
+        std::vector<word>>;
+
     template <std::integral word> struct bytestring;
 
     using bytes = bytestring<byte>;
@@ -31,8 +46,8 @@ namespace data {
     bytestring<word> operator >> (const bytestring<word> &b, int32 i);
 
     template <std::integral word>
-    struct bytestring : public cross<word> {
-        using cross<word>::cross;
+    struct bytestring : public cross<word, bytes_storage<word>> {
+        using cross<word, bytes_storage<word>>::cross;
         bytestring (slice<const word> v);
 
         operator slice<const word> () const;
@@ -84,8 +99,8 @@ namespace data {
     };
 
     template <std::integral word>
-    inline bytestring<word>::bytestring (slice<const word> v) : cross<word> (v.size ()) {
-        std::copy (v.begin (), v.end (), this->begin ());
+    inline bytestring<word>::bytestring (slice<const word> v) {
+        this->assign (v.begin (), v.end ());
     }
 
     template <std::integral word>
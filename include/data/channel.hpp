@@ -0,0 +1,387 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_CHANNEL
+#define DATA_CHANNEL
+
+#include <array>
+#include <bit>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <data/async.hpp>
+#include <data/maybe.hpp>
+#include <data/exception.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+namespace data {
+
+    // A golang style channel for passing values between coroutines and threads.
+    //
+    // A bounded channel is a lock-free multi-producer, multi-consumer ring
+    // buffer (Vyukov's bounded MPMC queue). An unbounded channel is a queue
+    // behind a mutex. Unlike golang, there are no unbuffered channels.
+    //
+    // try_send and try_receive never block. send and receive are awaitable:
+    // a coroutine that cannot proceed is suspended until another thread
+    // receives or sends something, so that no thread is blocked while it waits.
+    //
+    // After close is called, send throws channel_closed and try_send returns
+    // false. Values that were already sent may still be received, after which
+    // receive returns an empty maybe.
+    template <std::movable X> class channel;
+
+    // thrown by send on a closed channel.
+    struct channel_closed : exception::base<channel_closed> {};
+
+    // receive from whichever of several channels has something first. Returns
+    // the index of the channel and the value received, which is empty if that
+    // channel is closed and there is nothing left in it.
+    template <std::movable X, typename... Y> requires (Same<Y, channel<X>> && ...)
+    awaitable<std::pair<size_t, maybe<X>>> select (channel<X> &, Y &...);
+
+    namespace detail {
+
+        // a one-time notification that resumes a suspended coroutine.
+        class channel_signal {
+        public:
+            // returns false if the signal was already fired. source
+            // identifies whatever fired the signal.
+            bool fire (const void *source);
+
+            const void *source () const {
+                return Source;
+            }
+
+            // complete when the signal is fired, which may have already happened.
+            template <typename token> auto wait (token &&t);
+
+        private:
+            struct handler {
+                virtual ~handler () {}
+                virtual void complete () = 0;
+            };
+
+            template <typename H> struct handler_of final : handler {
+                H Handler;
+                // keeps the executor running while we wait.
+                exec Work;
+
+                handler_of (H &&h): Handler {std::move (h)}, Work {boost::asio::prefer (
+                    boost::asio::get_associated_executor (Handler),
+                    boost::asio::execution::outstanding_work.tracked)} {}
+
+                void complete () override {
+                    boost::asio::post (Work, std::move (Handler));
+                }
+            };
+
+            std::mutex Mutex;
+            bool Fired {false};
+            const void *Source {nullptr};
+            std::unique_ptr<handler> Waiting;
+        };
+
+        // coroutines waiting on one end of a channel.
+        class channel_waiters {
+        public:
+            void add (ptr<channel_signal>);
+
+            // returns false if the signal was not found because it has already been fired.
+            bool remove (const ptr<channel_signal> &);
+
+            // fire the first signal that has not already been fired by another channel.
+            void notify_one (const void *source);
+            void notify_all (const void *source);
+
+        private:
+            std::mutex Mutex;
+            std::deque<ptr<channel_signal>> Signals;
+            std::atomic<size_t> Count {0};
+        };
+
+    }
+
+    template <std::movable X> class channel {
+    public:
+        // an unbounded channel.
+        channel ();
+
+        // a bounded channel. The capacity is rounded up to a power of two.
+        explicit channel (size_t capacity);
+
+        channel (const channel &) = delete;
+        channel &operator = (const channel &) = delete;
+
+        ~channel ();
+
+        // 0 for an unbounded channel.
+        size_t capacity () const {
+            return Capacity;
+        }
+
+        bool closed () const {
+            return Closed.load (std::memory_order_acquire);
+        }
+
+        // return false if the channel is full or closed.
+        bool try_send (const X &);
+        bool try_send (X &&);
+
+        // return an empty maybe if the channel is empty.
+        maybe<X> try_receive ();
+
+        // throw channel_closed if the channel is closed.
+        awaitable<void> send (X);
+
+        // return an empty maybe if the channel is closed and empty.
+        awaitable<maybe<X>> receive ();
+
+        // wake all waiting coroutines. Subsequent sends will fail.
+        void close ();
+
+    private:
+        struct cell {
+            std::atomic<size_t> Sequence;
+            alignas (X) byte Data[sizeof (X)];
+        };
+
+        size_t Capacity;
+        std::unique_ptr<cell[]> Cells;
+
+        // position of the next send and receive in the ring buffer.
+        alignas (64) std::atomic<size_t> Tail {0};
+        alignas (64) std::atomic<size_t> Head {0};
+
+        // used by unbounded channels.
+        std::mutex Mutex;
+        std::deque<X> Queue;
+
+        std::atomic<bool> Closed {false};
+
+        detail::channel_waiters Senders;
+        detail::channel_waiters Receivers;
+
+        template <typename Y> bool push (Y &&);
+        maybe<X> pop ();
+
+        bool can_send ();
+        bool can_receive ();
+
+        template <std::movable Z, typename... Y> requires (Same<Y, channel<Z>> && ...)
+        friend awaitable<std::pair<size_t, maybe<Z>>> select (channel<Z> &, Y &...);
+    };
+
+    template <typename token> auto detail::channel_signal::wait (token &&t) {
+        return boost::asio::async_initiate<token, void ()> ([this] (auto h) {
+            std::unique_ptr<handler> w = std::make_unique<handler_of<decltype (h)>> (std::move (h));
+            {
+                std::lock_guard<std::mutex> lock {Mutex};
+                if (!Fired) {
+                    Waiting = std::move (w);
+                    return;
+                }
+            }
+
+            // the waiting coroutine may resume and destroy this signal
+            // as soon as the handler is completed, so we must not hold
+            // the lock when we do it.
+            w->complete ();
+        }, t);
+    }
+
+    template <std::movable X>
+    inline channel<X>::channel (): Capacity {0}, Cells {} {}
+
+    template <std::movable X>
+    channel<X>::channel (size_t capacity): Capacity {std::bit_ceil (std::max (capacity, size_t {2}))}, Cells {new cell[Capacity]} {
+        for (size_t i = 0; i < Capacity; i++) Cells[i].Sequence.store (i, std::memory_order_relaxed);
+    }
+
+    template <std::movable X>
+    channel<X>::~channel () {
+        if (Capacity != 0) while (pop ());
+    }
+
+    template <std::movable X>
+    template <typename Y> bool channel<X>::push (Y &&y) {
+        if (Capacity == 0) {
+            std::lock_guard<std::mutex> lock {Mutex};
+            Queue.emplace_back (std::forward<Y> (y));
+            return true;
+        }
+
+        size_t pos = Tail.load (std::memory_order_relaxed);
+        while (true) {
+            cell &c = Cells[pos & (Capacity - 1)];
+            size_t seq = c.Sequence.load (std::memory_order_acquire);
+            int64 diff = int64 (seq) - int64 (pos);
+            if (diff == 0) {
+                if (Tail.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed)) {
+                    new (c.Data) X (std::forward<Y> (y));
+                    c.Sequence.store (pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) return false;
+            else pos = Tail.load (std::memory_order_relaxed);
+        }
+    }
+
+    template <std::movable X>
+    maybe<X> channel<X>::pop () {
+        if (Capacity == 0) {
+            std::lock_guard<std::mutex> lock {Mutex};
+            if (Queue.empty ()) return {};
+            maybe<X> x {std::move (Queue.front ())};
+            Queue.pop_front ();
+            return x;
+        }
+
+        size_t pos = Head.load (std::memory_order_relaxed);
+        while (true) {
+            cell &c = Cells[pos & (Capacity - 1)];
+            size_t seq = c.Sequence.load (std::memory_order_acquire);
+            int64 diff = int64 (seq) - int64 (pos + 1);
+            if (diff == 0) {
+                if (Head.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed)) {
+                    X *p = std::launder (reinterpret_cast<X *> (c.Data));
+                    maybe<X> x {std::move (*p)};
+                    p->~X ();
+                    c.Sequence.store (pos + Capacity, std::memory_order_release);
+                    return x;
+                }
+            } else if (diff < 0) return {};
+            else pos = Head.load (std::memory_order_relaxed);
+        }
+    }
+
+    template <std::movable X>
+    bool channel<X>::can_send () {
+        if (Capacity == 0) return true;
+        size_t pos = Tail.load (std::memory_order_seq_cst);
+        return Cells[pos & (Capacity - 1)].Sequence.load (std::memory_order_seq_cst) == pos;
+    }
+
+    template <std::movable X>
+    bool channel<X>::can_receive () {
+        if (Capacity == 0) {
+            std::lock_guard<std::mutex> lock {Mutex};
+            return !Queue.empty ();
+        }
+
+        size_t pos = Head.load (std::memory_order_seq_cst);
+        return Cells[pos & (Capacity - 1)].Sequence.load (std::memory_order_seq_cst) == pos + 1;
+    }
+
+    template <std::movable X>
+    bool channel<X>::try_send (const X &x) {
+        if (closed () || !push (x)) return false;
+        Receivers.notify_one (this);
+        return true;
+    }
+
+    template <std::movable X>
+    bool channel<X>::try_send (X &&x) {
+        if (closed () || !push (std::move (x))) return false;
+        Receivers.notify_one (this);
+        return true;
+    }
+
+    template <std::movable X>
+    maybe<X> channel<X>::try_receive () {
+        maybe<X> x = pop ();
+        if (bool (x)) Senders.notify_one (this);
+        return x;
+    }
+
+    template <std::movable X>
+    awaitable<void> channel<X>::send (X x) {
+        while (true) {
+            if (closed ()) throw channel_closed {} << "send on closed channel";
+            // x is only moved if it is sent.
+            if (try_send (std::move (x))) co_return;
+
+            auto s = std::make_shared<detail::channel_signal> ();
+            Senders.add (s);
+            // check again in case a receiver took something before we were
+            // added, in which case it did not know to wake us.
+            if (can_send () || closed ()) {
+                if (!Senders.remove (s)) Senders.notify_one (this);
+                continue;
+            }
+
+            co_await s->wait (boost::asio::use_awaitable);
+        }
+    }
+
+    template <std::movable X>
+    awaitable<maybe<X>> channel<X>::receive () {
+        while (true) {
+            maybe<X> x = try_receive ();
+            if (bool (x)) co_return x;
+            if (closed ()) {
+                // something may have been sent just before the channel was closed.
+                x = try_receive ();
+                co_return x;
+            }
+
+            auto s = std::make_shared<detail::channel_signal> ();
+            Receivers.add (s);
+            if (can_receive () || closed ()) {
+                if (!Receivers.remove (s)) Receivers.notify_one (this);
+                continue;
+            }
+
+            co_await s->wait (boost::asio::use_awaitable);
+        }
+    }
+
+    template <std::movable X>
+    void channel<X>::close () {
+        Closed.store (true, std::memory_order_seq_cst);
+        Senders.notify_all (this);
+        Receivers.notify_all (this);
+    }
+
+    template <std::movable X, typename... Y> requires (Same<Y, channel<X>> && ...)
+    awaitable<std::pair<size_t, maybe<X>>> select (channel<X> &a, Y &...b) {
+        std::array<channel<X> *, 1 + sizeof... (Y)> c {&a, &b...};
+        // the channel that woke us, which we check first.
+        size_t first = 0;
+        while (true) {
+            for (size_t j = 0; j < c.size (); j++) {
+                size_t i = (first + j) % c.size ();
+                maybe<X> x = c[i]->try_receive ();
+                if (bool (x)) co_return std::pair<size_t, maybe<X>> {i, std::move (x)};
+            }
+
+            for (size_t i = 0; i < c.size (); i++) if (c[i]->closed ()) {
+                maybe<X> x = c[i]->try_receive ();
+                co_return std::pair<size_t, maybe<X>> {i, std::move (x)};
+            }
+
+            auto s = std::make_shared<detail::channel_signal> ();
+            for (size_t i = 0; i < c.size (); i++) c[i]->Receivers.add (s);
+
+            bool ready = false;
+            for (size_t i = 0; i < c.size (); i++) if (c[i]->can_receive () || c[i]->closed ()) ready = true;
+
+            if (!ready) co_await s->wait (boost::asio::use_awaitable);
+
+            // a channel that fired the signal after we stopped waiting must pass its notification on.
+            for (size_t i = 0; i < c.size (); i++)
+                if (!c[i]->Receivers.remove (s) && ready) c[i]->Receivers.notify_one (c[i]);
+
+            for (size_t i = 0; i < c.size (); i++) if (c[i] == s->source ()) first = i;
+        }
+    }
+
+}
+
+#endif
@@ -16,10 +16,12 @@ namespace data {
     // Cross resembles a vector with the ability to resize removed.
     // Other improvements include: being able to index from the end with
     // negative numbers as well as from the beginning.
+    // The storage is a std::vector by default. Any container with the
+    // same interface can be used instead, such as small_vector.
     // TODO: intead of using a vector, we need something
     // that will lazily initilize the pointer so that
     // the empty cross can be used in a constexpr expression.
-    template <std::default_initializable X> struct cross : std::vector<wrapped<X>> {
+    template <std::default_initializable X, typename storage = std::vector<wrapped<X>>> struct cross : storage {
         constexpr cross ();
         explicit cross (size_t size);
         explicit cross (size_t size, X fill);
@@ -44,7 +46,7 @@ namespace data {
         slice<const X> range (int) const;
         slice<const X> range (int, int) const;
         
-        cross (std::vector<X> &&v) : std::vector<X> {v} {}
+        cross (std::vector<X> &&v) : storage (std::move (v)) {}
         
     protected:
         void fill (const X &x) {
@@ -53,9 +55,9 @@ namespace data {
         
     };
     
-    template <typename X>
-    cross<X> drop (const cross<X> &x, size_t size) {
-        cross<X> n;
+    template <typename X, typename storage>
+    cross<X, storage> drop (const cross<X, storage> &x, size_t size) {
+        cross<X, storage> n;
         if (size >= x.size ()) return n;
         n.resize (x.size () - size);
         auto i = x.begin () + size;
@@ -66,33 +68,33 @@ namespace data {
         return n;
     }
 
-    template <typename X>
-    std::ostream &operator << (std::ostream &o, const cross<X> &s);
+    template <typename X, typename storage>
+    std::ostream &operator << (std::ostream &o, const cross<X, storage> &s);
 
-    template <std::default_initializable X>
-    X &cross<X>::operator [] (int i) {
+    template <std::default_initializable X, typename storage>
+    X &cross<X, storage>::operator [] (int i) {
         size_t size = this->size ();
         if (size == 0) throw out_of_range {"cross size 0"};
         if (i < 0 || i >= size) return this->operator [] ((i + size) % size);
-        return std::vector<X>::operator [] (i);
+        return storage::operator [] (i);
     }
 
-    template <std::default_initializable X>
-    bool cross<X>::valid () const {
+    template <std::default_initializable X, typename storage>
+    bool cross<X, storage>::valid () const {
         for (const X &x : *this) if (!data::valid (x)) return false;
         return true;
     }
 
-    template <std::default_initializable X>
-    const X &cross<X>::operator [] (int i) const {
+    template <std::default_initializable X, typename storage>
+    const X &cross<X, storage>::operator [] (int i) const {
         size_t size = this->size ();
         if (size == 0) throw out_of_range {"cross size 0"};
         if (i < 0 || i >= size) return this->operator [] ((i + size) % size);
-        return std::vector<X>::operator [] (i);
+        return storage::operator [] (i);
     }
     
-    template <std::default_initializable X>
-    std::ostream &operator << (std::ostream &o, const cross<X> &s) {
+    template <typename X, typename storage>
+    std::ostream &operator << (std::ostream &o, const cross<X, storage> &s) {
         auto b = s.begin ();
         o << "[";
         while (true) {
@@ -103,25 +105,25 @@ namespace data {
         }
     }
     
-    template <std::default_initializable X>
-    constexpr inline cross<X>::cross () : std::vector<X> {} {}
+    template <std::default_initializable X, typename storage>
+    constexpr inline cross<X, storage>::cross () : storage {} {}
     
-    template <std::default_initializable X>
-    inline cross<X>::cross (size_t size) : std::vector<X> (size) {}
+    template <std::default_initializable X, typename storage>
+    inline cross<X, storage>::cross (size_t size) : storage (size) {}
     
-    template <std::default_initializable X>
-    inline cross<X>::cross (size_t size, X fill) : std::vector<X> (size) {
-        for (auto it = std::vector<X>::begin (); it < std::vector<X>::end (); it++) *it = fill;
+    template <std::default_initializable X, typename storage>
+    inline cross<X, storage>::cross (size_t size, X fill) : storage (size) {
+        for (auto it = storage::begin (); it < storage::end (); it++) *it = fill;
     }
     
-    template <std::default_initializable X>
-    inline cross<X>::cross (std::initializer_list<X> x) : std::vector<X> {x} {}
+    template <std::default_initializable X, typename storage>
+    inline cross<X, storage>::cross (std::initializer_list<X> x) : storage (x.begin (), x.end ()) {}
     
-    template <std::default_initializable X>
+    template <std::default_initializable X, typename storage>
     template<Sequence list>
-    cross<X>::cross (list l) : cross {} {
-        std::vector<X>::resize (data::size (l));
-        auto b = std::vector<X>::begin ();
+    cross<X, storage>::cross (list l) : cross {} {
+        storage::resize (data::size (l));
+        auto b = storage::begin ();
         while (!l.empty ()) {
             *b = l.first ();
             l = l.rest ();
@@ -129,18 +131,18 @@ namespace data {
         }
     }
     
-    template <std::default_initializable X>
-    inline cross<X>::operator slice<X> () {
-        return slice<X> (static_cast<std::vector<X> &> (*this));
+    template <std::default_initializable X, typename storage>
+    inline cross<X, storage>::operator slice<X> () {
+        return slice<X> {this->data (), this->size ()};
     }
     
-    template <std::default_initializable X>
-    inline slice<X> cross<X>::range (int e) {
+    template <std::default_initializable X, typename storage>
+    inline slice<X> cross<X, storage>::range (int e) {
         return operator slice<X> ().range (e);
     }
     
-    template <std::default_initializable X>
-    inline slice<X> cross<X>::range (int b, int e) {
+    template <std::default_initializable X, typename storage>
+    inline slice<X> cross<X, storage>::range (int b, int e) {
         return operator slice<X> ().range (e);
     }
     
@@ -446,7 +446,7 @@ namespace data::crypto::NIST {
             do {
                 this->V = MAC::calculate<HMAC<H>> (this->Key, this->V);
                 w << this->V;
-            } while (w.TotalSize < size);
+            } while (w.size () < size);
         });
 
         std::copy (result.data (), result.data () + size, b);
@@ -45,19 +45,19 @@ namespace data {
 
     template <typename K, typename V>
     map<K, list<const V &>> to_map (const dispatch<K, V> d) {
-        map<K, list<const V &>> map;
+        typename map<K, list<const V &>>::transient m {};
         for (const auto &[key, val] : d)
-            map = map.insert (key, {val}, [] (list<const V &> old_value, list<const V &> new_value) {
+            m.insert (key, {val}, [] (list<const V &> old_value, list<const V &> new_value) {
                 return old_value + new_value;
             });
-        return map;
+        return m.freeze ();
     }
 
     template <typename K, typename V>
     set<const K &> get_keys (const dispatch<K, V> d) {
-        set<const K &> keys {};
-        for (const auto &[key, _] : d) keys = keys.insert (key);
-        return keys;
+        typename set<const K &>::transient keys {};
+        for (const auto &[key, _] : d) keys.insert (key);
+        return keys.freeze ();
     }
 
 }
@@ -11,9 +11,9 @@
 #include <data/ordered.hpp>
     
 namespace data {
-    template <Ordered K, typename V> struct entry;
+    template <std::equality_comparable K, typename V> struct entry;
 
-    template <Ordered K, typename V>
+    template <std::equality_comparable K, typename V>
     bool operator == (const entry<K, V> &l, const entry<K, V> &r);
 
     template <Ordered K, typename V>
@@ -22,7 +22,7 @@ namespace data {
     template <typename K, typename V>
     std::ostream &operator << (std::ostream &o, const entry<K, V> &e);
 
-    template <Ordered K, typename V>
+    template <std::equality_comparable K, typename V>
     struct entry {
         K Key;
         V Value;
@@ -89,7 +89,7 @@ namespace data {
 
     // equal if the keys are equal.
     // NOTE this totally breaks some things.
-    template <Ordered K, typename V>
+    template <std::equality_comparable K, typename V>
     bool inline operator == (const entry<K, V> &l, const entry<K, V> &r) {
         return l.Key == r.Key;
     }
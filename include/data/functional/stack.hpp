@@ -138,7 +138,7 @@ namespace data::functional {
     };
     
     template <typename X, typename Y>
-    inline stack_node<X, Y>::stack_node (inserted<X> x, Y r) : First (x), Rest (r), Size {data::size (r) + 1} {}
+    inline stack_node<X, Y>::stack_node (inserted<X> x, Y r) : First (x), Rest (std::move (r)), Size {data::size (Rest) + 1} {}
     
     template <typename X, typename Y>
     inline stack_node<X, Y>::stack_node (inserted<X> x) : First (x), Rest {}, Size {1} {}
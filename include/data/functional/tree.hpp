@@ -186,7 +186,7 @@ namespace data::functional {
         value Value;
         tree Left;
         tree Right;
-        tree_node (const value &v, tree l, tree r) : Value {v}, Left {l}, Right {r} {}
+        tree_node (const value &v, tree l, tree r) : Value {v}, Left {std::move (l)}, Right {std::move (r)} {}
     };
 
     // an iterator for a tree that treats it as a binary search tree
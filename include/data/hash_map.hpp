@@ -0,0 +1,21 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_HASH_MAP
+#define DATA_HASH_MAP
+
+#include <data/tools/hamt.hpp>
+#include <data/hash.hpp>
+
+namespace data {
+
+    // a functional map implemented as a hash array mapped trie. Use this instead
+    // of map for keys that have no meaningful order, such as hash digests.
+    // Lookup takes a few pointer hops and one key comparison instead of
+    // O(log n) key comparisons. Iteration order is unspecified.
+    template <typename K, typename V, typename hasher = key_hash<K>> using hash_map = HAMT<K, V, hasher>;
+
+}
+
+#endif
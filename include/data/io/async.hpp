@@ -2,21 +2,66 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#ifndef DATA_IO_ASYNC
+#define DATA_IO_ASYNC
+
 #include <data/io/multithreaded.hpp>
 #include <data/async.hpp>
 
 namespace data {
-    
+
     boost::asio::io_context IO;
 
-    void async_main (function<awaitable<void> ()> f, uint16 num_threads = 1) {
-        for (int i = 0; i < num_threads; i++) data::spawn (IO.get_executor (), f);
+    enum class io_mode {
+        // all threads run IO.
+        shared,
+        // every thread runs its own io_context, on which one copy of
+        // the main coroutine is spawned. Nothing is shared between
+        // threads unless the program shares it.
+        per_thread
+    };
+
+    // how often threads running an io_context check whether a shutdown has been requested.
+    constexpr millisecond ShutdownPoll {50};
+
+    // run a copy of f on each thread and return when they have all finished
+    // or a shutdown has been requested.
+    void async_main (function<awaitable<void> ()> f, thread_pool::options o, io_mode mode = io_mode::shared) {
+        if (o.Threads < 1) throw data::exception {} << "We cannot run with zero threads.";
+
+        std::vector<std::unique_ptr<boost::asio::io_context>> contexts {};
+        if (mode == io_mode::per_thread) for (uint32 i = 0; i < o.Threads; i++)
+            contexts.emplace_back (std::make_unique<boost::asio::io_context> (1));
+
+        auto context = [&] (uint32 i) -> boost::asio::io_context & {
+            return mode == io_mode::shared ? IO : *contexts[i];
+        };
+
+        for (uint32 i = 0; i < o.Threads; i++) data::spawn (context (i).get_executor (), f);
+
+        thread_pool pool {o};
+        for (uint32 i = 0; i < o.Threads; i++) pool.post ([&, c = &context (i)] () {
+            while (!ShutdownRequested && !c->stopped ()) c->run_for (ShutdownPoll);
+        });
+
+        try {
+            pool.wait ();
+        } catch (...) {
+            ShutdownRequested = true;
+            shutdown ();
+            IO.stop ();
+            for (auto &c : contexts) c->stop ();
+            throw;
+        }
 
-        multi_main ([&IO] () {
-            IO.run ();
-        }, num_threads);
-        
         IO.stop ();
+        for (auto &c : contexts) c->stop ();
     }
 
-}
\ No newline at end of file
+    void async_main (function<awaitable<void> ()> f, uint16 num_threads = 1) {
+        async_main (f, thread_pool::options {num_threads});
+    }
+
+}
+
+#endif
@@ -2,14 +2,17 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#ifndef DATA_IO_MULTITHREADED
+#define DATA_IO_MULTITHREADED
+
 #include <data/io/main.hpp>
-#include <data/synchronized.hpp>
+#include <data/tools/thread_pool.hpp>
 
 namespace data {
-    
+
     // Indicate globally that a shutdown request has been received.
     // Use extern std::atomic<bool> ShutdownRequested to access
-    // this variable from another translation unit. 
+    // this variable from another translation unit.
     std::atomic<bool> ShutdownRequested {false};
 
     // ensure that all threads will wake up and reach a halt state.
@@ -23,44 +26,42 @@ namespace data {
         }
     }
 
+    // Run f over and over on a thread pool until a shutdown is requested.
+    // Each call to f is a task on the pool, so f may post other tasks to
+    // thread_pool::current () and they will be run alongside it. If f
+    // throws, a shutdown is requested and the exception is rethrown here.
     // surround with catch_all or your own version
-    void multi_main (function<void ()> f, uint16 num_threads) {
-        if (num_threads < 1) throw data::exception {} << 
+    void multi_main (function<void ()> f, thread_pool::options o) {
+        if (o.Threads < 1) throw data::exception {} <<
             "We cannot run with zero threads. There is already one thread running to read in the input you have provided.";
 
-        if (nome_threads > 20) throw data::exception {} << 
-            "Do you really need more than 20 threads? "
-            "This is an experimental feature now. "
-            "Please make an issue on the github repo if you need more and we will strive to expedite this feature.";
-        
-        // Logic for handling exceptions thrown by threads.
-        std::exception_ptr stored_exception = nullptr;
-        std::mutex exception_mutex;
+        thread_pool pool {o};
 
-        std::vector<std::thread> threads {};
+        function<void ()> loop = [&] () {
+            if (ShutdownRequested) return;
 
-        auto main_loop = [&]() {
             try {
-                while (!Shutdown) f ();
-            // catch all exceptions 
+                f ();
             } catch (...) {
-                std::lock_guard<std::mutex> lock (exception_mutex);
-                // Capture first exception
-                if (!stored_exception) stored_exception = std::current_exception (); 
-                Shutdown = true;
+                ShutdownRequested = true;
+                shutdown ();
+                throw;
             }
-                
-            shutdown ();
+
+            // going back to the pool rather than looping here gives
+            // other tasks a turn on this thread.
+            if (!ShutdownRequested) pool.post (loop);
         };
-        
-        for (int i = 1; i < num_threads; i++) threads.emplace_back (main_loop);
 
-        main_loop ();
+        for (uint32 i = 0; i < o.Threads; i++) pool.post (loop);
 
-        for (int i = 1; i < num_threads; i++) threads[i - 1].join ();
+        pool.wait ();
+    }
 
-        if (stored_exception) std::rethrow_exception (stored_exception);
-    
+    void multi_main (function<void ()> f, uint16 num_threads) {
+        multi_main (f, thread_pool::options {num_threads});
     }
 
-}
\ No newline at end of file
+}
+
+#endif
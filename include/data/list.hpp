@@ -195,6 +195,29 @@
  *        sorted (z)             -> bool
  *
  *    ---------------------------------------------------------------------------
+ *    RANDOM ACCESS
+ *    ---------------------------------------------------------------------------
+ *
+ *    operator [], take, drop and + are linear for data::list. data::rrb_vector<X>
+ *    is also a persistent List, but these operations take O(log n). first,
+ *    rest, prepend and append are slower for rrb_vector than for list.
+ *
+ *    ---------------------------------------------------------------------------
+ *    WORST-CASE LATENCY
+ *    ---------------------------------------------------------------------------
+ *
+ *    By default, rest is amortized O(1) for data::list but an individual call
+ *    may take O(n) when the back of the queue must be reversed. Since lists are
+ *    persistent, that call can be repeated on the same list (for example, by
+ *    several threads sharing it). data::list<X, data::realtime_queue> selects a
+ *    queue in which first, rest, append and prepend are O(1) in the worst case,
+ *    at the cost of a constant factor.
+ *
+ *    The third parameter selects the underlying stack. For example,
+ *    data::list<X, data::functional_queue, data::unrolled_stack<X>> stores
+ *    several elements in each node.
+ *
+ *    ---------------------------------------------------------------------------
 */
 
 #include <data/stack.hpp>
@@ -202,10 +225,21 @@
 // implementation of List
 #include <data/tools/functional_queue.hpp>
 
+// persistent vector with fast indexing and concatenation.
+#include <data/tools/rrb_vector.hpp>
+
+// queue with worst-case O(1) operations.
+#include <data/tools/realtime_queue.hpp>
+
 namespace data {
 
-    // functional queue built using the list. 
-    template <typename X> using list = functional_queue<data::stack<X>, X>;
+    // functional queue built using the list. The queue implementation may
+    // be replaced with realtime_queue to avoid O(n) worst-case operations,
+    // and the stack may be replaced with unrolled_stack.
+    template <typename X,
+        template <Stack S, typename E> requires Sequence<S, E> class queue = functional_queue,
+        Stack stack = data::stack<X>>
+    using list = queue<stack, X>;
 
     template <typename X>
     requires requires (X a, X b) {
@@ -41,16 +41,17 @@ namespace data {
 
     template <typename K, typename V, typename F>
     map<K, V> select (const map<K, V> &m, F &&fun) {
-        map<K, V> selected;
-        for (const auto &[key, value]: m) if (fun (value)) selected = selected.insert (key, value);
-        return selected;
+        typename map<K, V>::transient selected {};
+        for (const auto &[key, value]: m) if (fun (value)) selected.insert (key, value);
+        return selected.freeze ();
     }
 
+    // remove all entries with the given value.
     template <typename K, typename V, typename E>
-    map<K, V> inline erase (const map<K, V> &m, E &&e) {
-        return select (m, [&e] (const V &v) -> bool {
-            return e != v;
-        });
+    map<K, V> erase (const map<K, V> &m, E &&e) {
+        map<K, V> erased = m;
+        for (const auto &[key, value]: m) if (!(e != value)) erased = erased.remove (key);
+        return erased;
     }
 
     template <typename K, typename V, typename E>
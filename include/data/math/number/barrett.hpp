@@ -0,0 +1,142 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_MATH_NUMBER_BARRETT
+#define DATA_MATH_NUMBER_BARRETT
+
+#include <array>
+#include <data/math/number/bounded/bounded.hpp>
+#include <data/math/number/division.hpp>
+
+namespace data::math::number {
+
+    template <typename X> struct is_uint : std::false_type {};
+
+    template <endian::order r, size_t size, std::unsigned_integral word>
+    struct is_uint<bounded<false, r, size, word>> : std::true_type {
+        constexpr static size_t digits = size;
+    };
+
+    // Barrett reduction modulo a uint known at compile time. Let k be the
+    // number of limbs in m and b = 2^limb_bits. With mu = floor (b^(2k) / m),
+    // a number t < m^2 is reduced by estimating the quotient as
+    //   floor (floor (t / b^(k - 1)) mu / b^(k + 1)),
+    // which is at most 2 less than the true quotient. Thus we need two
+    // multiplications and at most two subtractions, and no division.
+    template <auto mod> requires is_uint<std::remove_cv_t<decltype (mod)>>::value
+    struct barrett {
+        using X = std::remove_cv_t<decltype (mod)>;
+        using digit = digit_of<X>;
+        using limb = arithmetic::limbs::limb;
+
+        // number of limbs needed to hold any X.
+        constexpr static size_t Capacity = arithmetic::limbs::size<digit> (is_uint<X>::digits);
+
+        constexpr static std::array<limb, Capacity> read (const X &x) {
+            constexpr size_t per_limb = sizeof (limb) / sizeof (digit);
+            std::array<limb, Capacity> z {};
+            size_t i = 0;
+            for (digit d : x.words ()) {
+                z[i / per_limb] |= static_cast<limb> (d) << (sizeof (digit) * 8 * (i % per_limb));
+                i++;
+            }
+
+            return z;
+        }
+
+        // number of limbs in the modulus.
+        constexpr static size_t Size = [] {
+            std::array<limb, Capacity> z = read (mod);
+            size_t n = Capacity;
+            while (n > 0 && z[n - 1] == 0) n--;
+            return n;
+        } ();
+
+        constexpr static std::array<limb, Size> Modulus = [] {
+            std::array<limb, Capacity> z = read (mod);
+            std::array<limb, Size> m {};
+            for (size_t i = 0; i < Size; i++) m[i] = z[i];
+            return m;
+        } ();
+
+        // mu fits in k + 1 limbs unless m is a power of b.
+        constexpr static bool Usable = [] {
+            if (Size == 0 || Modulus[Size - 1] != 1) return Size != 0;
+            for (size_t i = 0; i + 1 < Size; i++) if (Modulus[i] != 0) return true;
+            return false;
+        } ();
+
+        // floor (b^(2k) / m) by binary long division.
+        constexpr static std::array<limb, Size + 1> Mu = [] {
+            constexpr size_t bits = arithmetic::limbs::limb_bits;
+            std::array<limb, Size + 1> q {};
+            std::array<limb, Size + 1> r {};
+            for (size_t i = 2 * Size * bits + 1; i-- > 0;) {
+                for (size_t j = Size; j > 0; j--) r[j] = (r[j] << 1) | (r[j - 1] >> (bits - 1));
+                r[0] = (r[0] << 1) | (i == 2 * Size * bits ? 1 : 0);
+
+                bool greater = r[Size] != 0;
+                if (!greater) {
+                    greater = true;
+                    for (size_t j = Size; j-- > 0;) if (r[j] != Modulus[j]) {
+                        greater = r[j] > Modulus[j];
+                        break;
+                    }
+                }
+
+                if (!greater) continue;
+
+                limb borrow = 0;
+                for (size_t j = 0; j <= Size; j++) {
+                    limb m = j < Size ? Modulus[j] : 0;
+                    limb d = r[j] - m - borrow;
+                    borrow = r[j] < m || (r[j] == m && borrow) ? 1 : 0;
+                    r[j] = d;
+                }
+
+                if (i / bits <= Size) q[i / bits] |= limb {1} << (i % bits);
+            }
+
+            return q;
+        } ();
+
+        // r[0, k) = t[0, 2k) mod m, where t < m^2.
+        static void reduce (limb *r, const limb *t) {
+            namespace limbs = arithmetic::limbs;
+            std::array<limb, 2 * Size + 2> q;
+            limbs::multiply (q.data (), t + Size - 1, Size + 1, Mu.data (), Size + 1);
+
+            std::array<limb, 2 * Size + 1> qm;
+            limbs::multiply (qm.data (), q.data () + Size + 1, Size + 1, Modulus.data (), Size);
+
+            std::array<limb, Size + 1> x;
+            limbs::sub_n (x.data (), t, qm.data (), Size + 1);
+            while (x[Size] != 0 || limbs::compare_n (x.data (), Modulus.data (), Size) >= 0)
+                limbs::sub_from (x.data (), Size + 1, Modulus.data (), Size);
+
+            std::copy (x.begin (), x.begin () + Size, r);
+        }
+
+        // a * b mod m, where a, b < m.
+        static X times (const X &a, const X &b) {
+            namespace limbs = arithmetic::limbs;
+            std::array<limb, Capacity> x {};
+            std::array<limb, Capacity> y {};
+            limbs::read<digit> (x.data (), a.words ().begin (), a.words ().end ());
+            limbs::read<digit> (y.data (), b.words ().begin (), b.words ().end ());
+
+            std::array<limb, 2 * Size> t;
+            limbs::multiply_n (t.data (), x.data (), y.data (), Size);
+            reduce (x.data (), t.data ());
+            return detail::read_limbs<X> (x.data (), Size);
+        }
+    };
+
+    // moduli for which modular arithmetic uses Barrett reduction.
+    template <auto mod, typename X> concept barrett_modulus =
+        std::same_as<X, std::remove_cv_t<decltype (mod)>> && is_uint<X>::value && barrett<mod>::Usable;
+
+}
+
+#endif
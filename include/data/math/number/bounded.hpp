@@ -9,6 +9,7 @@
 #include <iterator>
 #include <data/math/number/bounded/bounded.hpp>
 #include <data/math/number/gmp/mpz.hpp>
+#include <data/math/number/montgomery.hpp>
 #include <data/math/number/extended_euclidian.hpp>
 #include <data/encoding/integer.hpp>
 #include <data/encoding/digits.hpp>
@@ -159,6 +160,7 @@ namespace data::math::def {
         const bounded<a, r, x, word> &m,
         const bounded<b, r, x, word> &n,
         const nonzero<uint<r, x, word>> &q) {
+        if constexpr (!a && !b) if (!std::is_constant_evaluated ()) return number::limb_times_mod (m, n, q);
         return uint<r, x, word> (binary_accumulate_times_mod (
             bounded<a, r, x + 1, word> (m),
             bounded<b, r, x + 1, word> (n),
@@ -170,6 +172,7 @@ namespace data::math::def {
         const bounded<a, r, x, word> &m,
         const bounded<b, r, x, word> &n,
         const nonzero<uint<r, x, word>> &q) {
+        if constexpr (!a && !b) if (!std::is_constant_evaluated ()) return number::limb_pow_mod (m, n, q);
         return uint<r, x, word> (binary_accumulate_pow_mod (
             bounded<a, r, x * 2, word> (m),
             bounded<b, r, x * 2, word> (n),
@@ -1537,38 +1537,30 @@ namespace data {
         template <bool u, endian::order r, size_t x, std::unsigned_integral word>
         constexpr bounded<u, r, x, word> operator + (const bounded<u, r, x, word> &a, const bounded<u, r, x, word> &b) {
             bounded<u, r, x, word> z {};
-            auto i = z.words ().begin ();
-            auto j = a.words ().begin ();
-            auto k = b.words ().begin ();
-            arithmetic::add_with_carry<word> (z.words ().end (), i, j, k);
+            auto w = z.words ();
+            arithmetic::plus (w, a.words (), b.words ());
             return z;
         }
 
         template <bool u, endian::order r, size_t x, std::unsigned_integral word>
         constexpr bounded<u, r, x, word> operator - (const bounded<u, r, x, word> &a, const bounded<u, r, x, word> &b) {
             bounded<u, r, x, word> z {};
-            auto i = z.words ().begin ();
-            auto j = a.words ().begin ();
-            auto k = b.words ().begin ();
-            arithmetic::subtract_with_carry<word> (z.words ().end (), i, j, k);
+            auto w = z.words ();
+            arithmetic::minus (w, a.words (), b.words ());
             return z;
         }
 
         template <bool u, endian::order r, size_t x, std::unsigned_integral word>
         constexpr bounded<u, r, x, word> &operator += (bounded<u, r, x, word> &a, const bounded<u, r, x, word> &b) {
-            auto awb = a.words ().begin ();
-            auto cawb = const_cast<const bounded<u, r, x, word> &> (a).words ().begin ();
-            auto bwb = b.words ().begin ();
-            arithmetic::add_with_carry<word> (a.words ().end (), awb, cawb, bwb);
+            auto w = a.words ();
+            arithmetic::plus (w, w, b.words ());
             return a;
         }
 
         template <bool u, endian::order r, size_t x, std::unsigned_integral word>
         constexpr bounded<u, r, x, word> &operator -= (bounded<u, r, x, word> &a, const bounded<u, r, x, word> &b) {
-            auto awb = a.words ().begin ();
-            auto cawb = const_cast<const bounded<u, r, x, word> &> (a).words ().begin ();
-            auto bwb = b.words ().begin ();
-            arithmetic::subtract_with_carry<word> (a.words ().end (), awb, cawb, bwb);
+            auto w = a.words ();
+            arithmetic::minus (w, w, b.words ());
             return a;
         }
 
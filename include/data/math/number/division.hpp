@@ -8,14 +8,37 @@
 #include <data/increment.hpp>
 #include <data/arithmetic.hpp>
 #include <data/exception.hpp>
+#include <data/arithmetic/limbs.hpp>
 
 namespace data::math::number {
 
+    // numbers like N_bytes and uint that are stored as strings of digits
+    // and which can therefore be divided a machine word at a time.
+    template <typename N> concept has_words = requires (N &n, const N &c) {
+        typename N::words_type;
+        { n.words () } -> std::same_as<typename N::words_type>;
+        c.words ();
+        { c.size () } -> std::convertible_to<size_t>;
+    };
+
+    template <has_words N> using digit_of = std::remove_cvref_t<decltype (*std::declval<N &> ().words ().begin ())>;
+
+    template <typename N> concept digit_string = has_words<N> && Unsigned<N> &&
+        std::unsigned_integral<digit_of<N>> && sizeof (digit_of<N>) <= sizeof (arithmetic::limbs::limb);
+
+    // divide with Knuth's algorithm D or with Burnikel-Ziegler. The result has
+    // the minimal size for variable-sized numbers.
+    template <digit_string N> division<N> limb_divmod (const N &Dividend, const N &Divisor);
+
     // Generic division algorithm.
     template <MultiplicativeNumber N>
     constexpr division<N> natural_divmod (const N &Dividend, const N &Divisor) {
 
         if (Divisor == 0) throw division_by_zero {};
+
+        if constexpr (digit_string<N>)
+            if (!std::is_constant_evaluated ()) return limb_divmod (Dividend, Divisor);
+
         if (Divisor == 1) return {Dividend, 0u};
         if (Divisor == 2) return {div_2 (Dividend), mod_2 (Dividend)};
 
@@ -67,6 +90,46 @@ namespace data::math::number {
         return result;
     }
 
+    namespace detail {
+        template <digit_string N> N read_limbs (const arithmetic::limbs::limb *z, size_t zn) {
+            using digit = digit_of<N>;
+            N n = [z, zn] {
+                if constexpr (requires { N::zero (size_t {}); }) return N::zero (arithmetic::limbs::digits<digit> (z, zn));
+                else return N {};
+            } ();
+
+            auto w = n.words ();
+            arithmetic::limbs::write<digit> (w.begin (), w.end (), z, zn);
+            return n;
+        }
+    }
+
+    template <digit_string N> division<N> limb_divmod (const N &Dividend, const N &Divisor) {
+        namespace limbs = arithmetic::limbs;
+        using digit = digit_of<N>;
+
+        size_t an = limbs::size<digit> (Dividend.size ());
+        size_t bn = limbs::size<digit> (Divisor.size ());
+
+        limbs::buffer x (an + bn);
+        limbs::limb *a = x.data ();
+        limbs::limb *b = a + an;
+        limbs::read<digit> (a, Dividend.words ().begin (), Dividend.words ().end ());
+        limbs::read<digit> (b, Divisor.words ().begin (), Divisor.words ().end ());
+        an = limbs::trim (a, an);
+        bn = limbs::trim (b, bn);
+
+        if (bn == 0) throw division_by_zero {};
+        if (an < bn) return {detail::read_limbs<N> (a, 0), detail::read_limbs<N> (a, an)};
+
+        limbs::buffer y (an + 1);
+        limbs::limb *q = y.data ();
+        limbs::limb *r = q + an - bn + 1;
+        limbs::divide (q, r, a, an, b, bn);
+
+        return {detail::read_limbs<N> (q, an - bn + 1), detail::read_limbs<N> (r, bn)};
+    }
+
     template <MultiplicativeNumber Z, MultiplicativeNumber N>
     constexpr division<Z, N> integer_natural_divmod (const Z &Dividend, const N &Divisor) {
         division<N> d {natural_divmod<N> (abs (Dividend), Divisor)};
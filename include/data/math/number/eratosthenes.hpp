@@ -12,7 +12,9 @@
 
 namespace data::math::number {
     
-    template <WholeNumber N>
+    // heap_type is the priority queue used by the sieve. It may be
+    // any template with the interface of priority_queue.
+    template <WholeNumber N, template <typename> class heap_type>
     struct eratosthenes {
         // stack of primes generated by the sieve in reverse order.
         stack<prime<N>> Primes;
@@ -44,7 +46,7 @@ namespace data::math::number {
             }
         };
         
-        using heap = priority_queue<entry>;
+        using heap = heap_type<entry>;
         heap Sieve;
         
         eratosthenes (stack<prime<N>> p, N m, heap sieve) : Primes {p}, Next {m}, Sieve {sieve} {}
@@ -78,27 +80,27 @@ namespace data::math::number {
         primes (stack<prime<N>> p, eratosthenes<N> x);
     };
 
-    template <WholeNumber N>
-    eratosthenes<N>::eratosthenes () : Primes {}, Next {2}, Sieve {} {}
+    template <WholeNumber N, template <typename> class heap_type>
+    eratosthenes<N, heap_type>::eratosthenes () : Primes {}, Next {2}, Sieve {} {}
 
-    template <WholeNumber N>
-    eratosthenes<N>::eratosthenes (N n) : eratosthenes {eratosthenes {}.next (n)} {}
+    template <WholeNumber N, template <typename> class heap_type>
+    eratosthenes<N, heap_type>::eratosthenes (N n) : eratosthenes {eratosthenes {}.next (n)} {}
 
-    template <WholeNumber N>
-    eratosthenes<N> eratosthenes<N>::next (N n) const {
+    template <WholeNumber N, template <typename> class heap_type>
+    eratosthenes<N, heap_type> eratosthenes<N, heap_type>::next (N n) const {
         N required = n + Primes.size ();
         eratosthenes e = *this;
         while (required > e.Primes.size ()) e = e.step ();
         return e;
     }
 
-    template <WholeNumber N>
-    eratosthenes<N> eratosthenes<N>::next () const {
+    template <WholeNumber N, template <typename> class heap_type>
+    eratosthenes<N, heap_type> eratosthenes<N, heap_type>::next () const {
         return next (1);
     }
     
-    template <WholeNumber N>
-    bool eratosthenes<N>::test_next_prime (const N next, heap &q) {
+    template <WholeNumber N, template <typename> class heap_type>
+    bool eratosthenes<N, heap_type>::test_next_prime (const N next, heap &q) {
         if (q.empty ()) return true;
         N multiple;
         while (true) {
@@ -109,8 +111,8 @@ namespace data::math::number {
         } 
     }
     
-    template <WholeNumber N>
-    eratosthenes<N> eratosthenes<N>::step () const {
+    template <WholeNumber N, template <typename> class heap_type>
+    eratosthenes<N, heap_type> eratosthenes<N, heap_type>::step () const {
         heap q = Sieve;
         if (test_next_prime (Next, q))
             return {Primes >> prime<N> {Next, prime<N>::certain}, Next + 1u, insert_prime (q, Next)};
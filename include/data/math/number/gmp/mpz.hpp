@@ -306,6 +306,15 @@ namespace data::math::def {
         Z operator () (const Z &a);
     };
 
+    // GMP does its own windowed Montgomery exponentiation.
+    template <> struct pow_mod<N, N, N> {
+        N operator () (const N &x, const N &y, const nonzero<N> &z);
+    };
+
+    template <std::integral Exp> struct pow_mod<N, Exp, N> {
+        N operator () (const N &x, Exp y, const nonzero<N> &z);
+    };
+
 }
 
 namespace data::math::number {
@@ -904,6 +913,19 @@ namespace data::math::def {
     Z inline bit_xor<Z>::operator () (const Z &a, const Z &b) {
         return a ^ b;
     }
+
+    N inline pow_mod<N, N, N>::operator () (const N &x, const N &y, const nonzero<N> &z) {
+        N n {};
+        mpz_powm (n.Value.MPZ, x.Value.MPZ, y.Value.MPZ, z.Value.Value.MPZ);
+        return n;
+    }
+
+    template <std::integral Exp> N inline pow_mod<N, Exp, N>::operator () (const N &x, Exp y, const nonzero<N> &z) {
+        if constexpr (std::signed_integral<Exp>) if (y < 0) throw exception {} << "cannot take a negative power";
+        N n {};
+        mpz_powm_ui (n.Value.MPZ, x.Value.MPZ, static_cast<unsigned long> (y), z.Value.Value.MPZ);
+        return n;
+    }
 }
 
 #endif
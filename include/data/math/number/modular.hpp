@@ -9,6 +9,7 @@
 #include <data/integral.hpp>
 #include <data/math/algebra.hpp>
 #include <data/math/number/extended_euclidian.hpp>
+#include <data/math/number/barrett.hpp>
 
 namespace data::math::number {
     template <typename X> concept mod_base = RingNumber<X>;
@@ -82,6 +83,10 @@ namespace data::math::number {
         constexpr modular (const X &v): Value (v) {
             Value %= mod;
         }
+
+        // for a value that is already less than mod.
+        struct reduced {};
+        constexpr modular (const X &v, reduced): Value (v) {}
         
         constexpr bool valid () const {
             return data::valid (Value) && Value >= 0 && Value < mod;;
@@ -172,24 +177,36 @@ namespace data::math::number {
         return a % mod == b.Value;
     }*/
     
+    // when mod is a uint, both arguments are less than mod, so we can
+    // reduce with a subtraction instead of a division.
     template <auto mod, mod_base X>
     constexpr modular<mod, X> inline operator + (const modular<mod, X> &a, const modular<mod, X> &b) {
-        return data::plus_mod (a.Value, b.Value, nonzero {mod});
+        if constexpr (barrett_modulus<mod, X>) {
+            X x = a.Value + b.Value;
+            if (x < a.Value || x >= mod) x -= mod;
+            return {x, typename modular<mod, X>::reduced {}};
+        } else return data::plus_mod (a.Value, b.Value, nonzero {mod});
     }
     
     template <auto mod, mod_base X>
     constexpr modular<mod, X> inline operator * (const modular<mod, X> &a, const modular<mod, X> &b) {
+        if constexpr (barrett_modulus<mod, X>) if (!std::is_constant_evaluated ())
+            return {barrett<mod>::times (a.Value, b.Value), typename modular<mod, X>::reduced {}};
         return data::times_mod (a.Value, b.Value, nonzero {mod});
     }
     
     template <auto mod, mod_base X>
     constexpr modular<mod, X> inline operator - (const modular<mod, X> &a, const modular<mod, X> &b) {
+        if constexpr (barrett_modulus<mod, X>)
+            return {a.Value < b.Value ? X (mod - (b.Value - a.Value)) : X (a.Value - b.Value), typename modular<mod, X>::reduced {}};
         if (a.Value < b.Value) return mod - (b.Value - a.Value);
         return data::minus_mod (a.Value, b.Value, nonzero {mod});
     }
     
     template <auto mod, mod_base X>
     constexpr modular<mod, X> inline operator - (const modular<mod, X> &a) {
+        if constexpr (barrett_modulus<mod, X>)
+            return {a.Value == 0 ? a.Value : X (mod - a.Value), typename modular<mod, X>::reduced {}};
         return data::negate_mod (a.Value, nonzero {mod});
     }
     
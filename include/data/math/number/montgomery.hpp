@@ -0,0 +1,303 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_MATH_NUMBER_MONTGOMERY
+#define DATA_MATH_NUMBER_MONTGOMERY
+
+#include <data/math/number/division.hpp>
+#include <data/math/number/gmp/mpz.hpp>
+
+namespace data::math::number {
+
+    // natural numbers that can be read and written a limb at a time.
+    template <typename N> concept limb_string = digit_string<N> || std::same_as<N, GMP::N>;
+
+    // exponents for pow_mod.
+    template <typename N> concept limb_exponent = std::integral<N> || limb_string<N>;
+
+    // Multiplication modulo a fixed odd number n without division. A number x
+    // is represented in Montgomery form as x R mod n, where R is the power of
+    // 2^limb_bits just above n. The constants needed are computed once, so a
+    // context should be reused for many operations with the same modulus.
+    template <limb_string N> struct montgomery_context {
+        using limb = arithmetic::limbs::limb;
+
+        // throws if the modulus is even.
+        explicit montgomery_context (const nonzero<N> &);
+
+        const N &modulus () const {
+            return Modulus;
+        }
+
+        N to_mont (const N &) const;
+        N from_mont (const N &) const;
+
+        // arguments and results are in Montgomery form.
+        N mul (const N &, const N &) const;
+        N sqr (const N &) const;
+
+        // x ^ y mod n with sliding windows. x and the result are in normal form.
+        template <limb_exponent Exp> N pow_mod (const N &x, const Exp &y) const;
+
+    private:
+        N Modulus;
+
+        // number of limbs in the modulus.
+        size_t Size;
+
+        // -1 / n mod 2^limb_bits.
+        limb Inverse;
+
+        // the modulus, R^2 mod n, and R mod n, each Size limbs.
+        arithmetic::limbs::buffer Limbs;
+        arithmetic::limbs::buffer R2;
+        arithmetic::limbs::buffer One;
+
+        // r[0, Size) = x mod n.
+        void reduce (limb *r, const N &x) const;
+    };
+
+    // x ^ y mod n on limbs, using Montgomery multiplication for an odd modulus.
+    template <limb_string N, limb_exponent Exp> N limb_pow_mod (const N &x, const Exp &y, const nonzero<N> &n);
+
+    // x * y mod n on limbs.
+    template <limb_string N> N limb_times_mod (const N &x, const N &y, const nonzero<N> &n);
+
+    namespace detail {
+        using arithmetic::limbs::limb;
+
+        // the limbs of n without leading zeros.
+        template <limb_string N> arithmetic::limbs::buffer limbs_of (const N &n) {
+            namespace limbs = arithmetic::limbs;
+            if constexpr (digit_string<N>) {
+                using digit = digit_of<N>;
+                limbs::buffer z (limbs::size<digit> (n.size ()));
+                limbs::read<digit> (z.data (), n.words ().begin (), n.words ().end ());
+                z.resize (limbs::trim (z.data (), z.size ()));
+                return z;
+            } else return limbs::buffer (n.Value.begin (), n.Value.end ());
+        }
+
+        template <limb_string N> N from_limbs (const limb *z, size_t zn) {
+            if constexpr (digit_string<N>) return read_limbs<N> (z, zn);
+            else {
+                N n {};
+                mpz_import (n.Value.MPZ, zn, -1, sizeof (limb), 0, 0, z);
+                return n;
+            }
+        }
+
+        template <limb_exponent Exp> arithmetic::limbs::buffer exponent_limbs (const Exp &y) {
+            if constexpr (std::integral<Exp>) {
+                if constexpr (std::signed_integral<Exp>) if (y < 0) throw exception {} << "cannot take a negative power";
+                if (y == 0) return {};
+                return {static_cast<limb> (y)};
+            } else return limbs_of (y);
+        }
+
+        // r[0, mn) = x[0, xn) mod m[0, mn), where the top limb of m is not zero.
+        void inline reduce (limb *r, const limb *x, size_t xn, const limb *m, size_t mn) {
+            namespace limbs = arithmetic::limbs;
+            if (xn < mn || (xn == mn && limbs::compare_n (x, m, mn) < 0)) {
+                std::copy (x, x + xn, r);
+                std::fill (r + xn, r + mn, limb {0});
+                return;
+            }
+
+            limbs::buffer q (xn - mn + 1);
+            limbs::divide (q.data (), r, x, xn, m, mn);
+        }
+
+        // the window size for an exponent with the given number of bits.
+        // Each extra bit halves the number of multiplications but doubles
+        // the size of the table of odd powers.
+        unsigned inline window_size (size_t bits) {
+            return bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : bits > 6 ? 2 : 1;
+        }
+
+        // r[0, mn) = x ^ e mod m by squaring and multiplying, for a modulus
+        // that may be even. x must be less than m.
+        void inline plain_pow_mod (limb *r, const limb *x, const limb *e, size_t en, const limb *m, size_t mn) {
+            namespace limbs = arithmetic::limbs;
+            limbs::buffer base (x, x + mn);
+            limbs::buffer t (2 * mn);
+            limbs::buffer one (1, limb {1});
+            reduce (r, one.data (), 1, m, mn);
+
+            for (size_t i = 0; i < en; i++) for (size_t j = 0; j < limbs::limb_bits; j++) {
+                if ((e[i] >> j) & 1) {
+                    limbs::multiply_n (t.data (), r, base.data (), mn);
+                    reduce (r, t.data (), 2 * mn, m, mn);
+                }
+
+                if (i + 1 == en && (e[i] >> j) <= 1) return;
+                limbs::square_n (t.data (), base.data (), mn);
+                reduce (base.data (), t.data (), 2 * mn, m, mn);
+            }
+        }
+    }
+
+    template <limb_string N> montgomery_context<N>::montgomery_context (const nonzero<N> &n) :
+        Modulus {n.Value}, Size {0}, Inverse {0}, Limbs {detail::limbs_of (n.Value)} {
+        namespace limbs = arithmetic::limbs;
+        Size = Limbs.size ();
+        if (Size == 0) throw division_by_zero {};
+        if ((Limbs[0] & 1) == 0) throw exception {} << "Montgomery multiplication requires an odd modulus";
+
+        Inverse = limbs::negative_inverse (Limbs[0]);
+
+        limbs::buffer x (2 * Size + 1);
+        x[2 * Size] = 1;
+        R2 = limbs::buffer (Size);
+        detail::reduce (R2.data (), x.data (), 2 * Size + 1, Limbs.data (), Size);
+
+        x[2 * Size] = 0;
+        x[Size] = 1;
+        One = limbs::buffer (Size);
+        detail::reduce (One.data (), x.data (), Size + 1, Limbs.data (), Size);
+    }
+
+    template <limb_string N> void montgomery_context<N>::reduce (limb *r, const N &x) const {
+        arithmetic::limbs::buffer z = detail::limbs_of (x);
+        detail::reduce (r, z.data (), z.size (), Limbs.data (), Size);
+    }
+
+    template <limb_string N> N montgomery_context<N>::to_mont (const N &x) const {
+        arithmetic::limbs::buffer z (4 * Size);
+        reduce (z.data (), x);
+        arithmetic::limbs::mont_mul (z.data (), z.data (), R2.data (), Limbs.data (), Size, Inverse, z.data () + 2 * Size);
+        return detail::from_limbs<N> (z.data (), Size);
+    }
+
+    template <limb_string N> N montgomery_context<N>::from_mont (const N &x) const {
+        arithmetic::limbs::buffer z (3 * Size);
+        reduce (z.data () + Size, x);
+        arithmetic::limbs::redc (z.data (), z.data () + Size, Limbs.data (), Size, Inverse);
+        return detail::from_limbs<N> (z.data (), Size);
+    }
+
+    template <limb_string N> N montgomery_context<N>::mul (const N &x, const N &y) const {
+        arithmetic::limbs::buffer z (4 * Size);
+        reduce (z.data (), x);
+        reduce (z.data () + Size, y);
+        arithmetic::limbs::mont_mul (z.data (), z.data (), z.data () + Size, Limbs.data (), Size, Inverse, z.data () + 2 * Size);
+        return detail::from_limbs<N> (z.data (), Size);
+    }
+
+    template <limb_string N> N montgomery_context<N>::sqr (const N &x) const {
+        arithmetic::limbs::buffer z (3 * Size);
+        reduce (z.data (), x);
+        arithmetic::limbs::mont_mul (z.data (), z.data (), z.data (), Limbs.data (), Size, Inverse, z.data () + Size);
+        return detail::from_limbs<N> (z.data (), Size);
+    }
+
+    // We precompute x, x^3, x^5 ... x^(2^w - 1) and then read the exponent from
+    // the top down in windows of at most w bits that begin and end with a 1.
+    // Between windows we square once for each zero bit.
+    template <limb_string N> template <limb_exponent Exp>
+    N montgomery_context<N>::pow_mod (const N &x, const Exp &y) const {
+        namespace limbs = arithmetic::limbs;
+        limbs::buffer e = detail::exponent_limbs (y);
+        size_t bits = e.size () == 0 ? 0 : e.size () * limbs::limb_bits - std::countl_zero (e[e.size () - 1]);
+        unsigned w = detail::window_size (bits);
+        size_t n = Size;
+
+        // table of odd powers, followed by the accumulator and scratch space.
+        limbs::buffer z (((size_t {1} << (w - 1)) + 3) * n);
+        limb *acc = z.data ();
+        limb *t = acc + n;
+        limb *table = t + 2 * n;
+
+        reduce (acc, x);
+        limbs::mont_mul (table, acc, R2.data (), Limbs.data (), n, Inverse, t);
+        if (w > 1) {
+            limbs::mont_mul (acc, table, table, Limbs.data (), n, Inverse, t);
+            for (size_t i = 1; i < (size_t {1} << (w - 1)); i++)
+                limbs::mont_mul (table + i * n, table + (i - 1) * n, acc, Limbs.data (), n, Inverse, t);
+        }
+
+        auto bit = [&e] (size_t i) -> limb {
+            return (e[i / limbs::limb_bits] >> (i % limbs::limb_bits)) & 1;
+        };
+
+        std::copy (One.begin (), One.end (), acc);
+        bool started = false;
+        size_t i = bits;
+        while (i > 0) {
+            if (bit (i - 1) == 0) {
+                limbs::mont_mul (acc, acc, acc, Limbs.data (), n, Inverse, t);
+                i--;
+                continue;
+            }
+
+            size_t l = i > w ? i - w : 0;
+            while (bit (l) == 0) l++;
+
+            limb u = 0;
+            for (size_t j = i; j > l; j--) {
+                u = (u << 1) | bit (j - 1);
+                if (started) limbs::mont_mul (acc, acc, acc, Limbs.data (), n, Inverse, t);
+            }
+
+            if (started) limbs::mont_mul (acc, acc, table + (u >> 1) * n, Limbs.data (), n, Inverse, t);
+            else std::copy (table + (u >> 1) * n, table + (u >> 1) * n + n, acc);
+
+            started = true;
+            i = l;
+        }
+
+        std::copy (acc, acc + n, t);
+        std::fill (t + n, t + 2 * n, limb {0});
+        limbs::redc (acc, t, Limbs.data (), n, Inverse);
+        return detail::from_limbs<N> (acc, n);
+    }
+
+    template <limb_string N, limb_exponent Exp> N limb_pow_mod (const N &x, const Exp &y, const nonzero<N> &n) {
+        namespace limbs = arithmetic::limbs;
+        limbs::buffer m = detail::limbs_of (n.Value);
+        if (m.size () == 0) throw division_by_zero {};
+        if ((m[0] & 1) == 1) return montgomery_context<N> {n}.pow_mod (x, y);
+
+        limbs::buffer e = detail::exponent_limbs (y);
+        limbs::buffer a = detail::limbs_of (x);
+        limbs::buffer z (2 * m.size ());
+        detail::reduce (z.data (), a.data (), a.size (), m.data (), m.size ());
+        detail::plain_pow_mod (z.data () + m.size (), z.data (), e.data (), e.size (), m.data (), m.size ());
+        return detail::from_limbs<N> (z.data () + m.size (), m.size ());
+    }
+
+    template <limb_string N> N limb_times_mod (const N &x, const N &y, const nonzero<N> &n) {
+        namespace limbs = arithmetic::limbs;
+        limbs::buffer m = detail::limbs_of (n.Value);
+        if (m.size () == 0) throw division_by_zero {};
+
+        limbs::buffer a = detail::limbs_of (x);
+        limbs::buffer b = detail::limbs_of (y);
+        if (a.size () == 0 || b.size () == 0) return detail::from_limbs<N> (a.data (), 0);
+
+        limbs::buffer z (a.size () + b.size () + m.size ());
+        limbs::multiply (z.data (), a.data (), a.size (), b.data (), b.size ());
+        detail::reduce (z.data () + a.size () + b.size (), z.data (), a.size () + b.size (), m.data (), m.size ());
+        return detail::from_limbs<N> (z.data () + a.size () + b.size (), m.size ());
+    }
+
+}
+
+namespace data::math::def {
+
+    template <endian::order r, std::unsigned_integral word, number::limb_exponent Exp>
+    struct pow_mod<number::N_bytes<r, word>, Exp, number::N_bytes<r, word>> {
+        number::N_bytes<r, word> operator () (
+            const number::N_bytes<r, word> &x, const Exp &y, const nonzero<number::N_bytes<r, word>> &z);
+    };
+
+    template <endian::order r, std::unsigned_integral word, number::limb_exponent Exp>
+    number::N_bytes<r, word> inline pow_mod<number::N_bytes<r, word>, Exp, number::N_bytes<r, word>>::operator () (
+        const number::N_bytes<r, word> &x, const Exp &y, const nonzero<number::N_bytes<r, word>> &z) {
+        return number::limb_pow_mod (x, y, z);
+    }
+
+}
+
+#endif
@@ -7,6 +7,7 @@
 
 #include <data/arithmetic.hpp>
 #include <data/random.hpp>
+#include <data/priority_queue.hpp>
 #include <iostream> // required by windows.
 
 namespace data::math::number {
@@ -14,7 +15,8 @@ namespace data::math::number {
     // because it requires bit operations.
     template <WholeNumber N> struct prime;
 
-    template <WholeNumber N> struct eratosthenes;
+    // the sieve of eratosthenes, using heap_type as its priority queue.
+    template <WholeNumber N, template <typename> class heap_type = pairing_heap> struct eratosthenes;
     template <WholeNumber N> struct primes;
     template <WholeNumber N> struct AKS;
 
@@ -57,7 +59,7 @@ namespace data::math::number {
     private:
         prime (N p, likelihood l) : Prime {p}, Likelihood {l} {}
 
-        friend struct eratosthenes<N>;
+        template <WholeNumber M, template <typename> class heap_type> friend struct eratosthenes;
         friend struct AKS<N>;
         friend factorization<N> factorize<N> (nonzero<N>, eratosthenes<N> &);
         friend prime<N> is_prime<N> (random::source &, const N &, int rounds);
@@ -91,6 +91,12 @@ namespace data {
 
 namespace data::meta {
 
+    // a persistent structure that provides a mutable builder, called
+    // a transient, for constructing a new structure efficiently.
+    template <typename X> concept has_transient = requires {
+        typename X::transient;
+    };
+
     template <typename X, typename Y> struct rule;
 
     template <typename X, typename... rule> struct replace_with;
@@ -7,6 +7,7 @@
 
 #include <data/net/stream.hpp>
 #include <data/bytes.hpp>
+#include <data/tools/rope.hpp>
 #include <data/string.hpp>
 #include <boost/asio.hpp>
 
@@ -30,9 +31,20 @@ namespace data::net::asio {
 
     template <typename async_read_stream, typename mutable_buffer_sequence>
     concept AsyncReadStream = requires (async_read_stream stream, mutable_buffer_sequence m) {
-        { stream.async_read_some (buffer (m), use_awaitable) } -> Same<awaitable<size_t>>;
+        { stream.async_read_some (buffer (m.data (), m.size ()), use_awaitable) } -> Same<awaitable<size_t>>;
     };
 
+    // the segments of a rope as a ConstBufferSequence, so that
+    // it can be sent in a single vectored write.
+    template <std::integral word> std::vector<const_buffer> buffers (const rope<word> &r) {
+        std::vector<const_buffer> z {};
+        r.each ([&z] (slice<const word> s) {
+            z.emplace_back (s.data (), s.size () * sizeof (word));
+        });
+
+        return z;
+    }
+
     template <AsyncWriteStream X, typename bytes, typename byte_slice> requires AsyncReadStream<X, bytes> class stream;
 
     template <AsyncWriteStream X> using byte_stream = stream<X, bytes, byte_slice>;
@@ -75,6 +87,16 @@ namespace data::net::asio {
             }
         }
 
+        // send every segment of a rope without copying them together first.
+        awaitable<void> send (const rope<byte> &x) {
+            error ec;
+            co_await async_write (*Stream, buffers (x), asio::redirect_error (asio::use_awaitable, ec));
+            if (ec) {
+                close ();
+                throw exception {ec};
+            }
+        }
+
         void close () final override {
             if (Closed) return;
             Closed = true;
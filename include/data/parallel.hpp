@@ -0,0 +1,211 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_PARALLEL
+#define DATA_PARALLEL
+
+#include <data/lift.hpp>
+#include <data/fold.hpp>
+#include <data/select.hpp>
+#include <data/tools/thread_pool.hpp>
+
+/*
+ *  Parallel versions of for_each, lift, fold and select that run on a
+ *  thread_pool. Each of them divides a sequence into segments of equal
+ *  size and gives each segment to one task. There are several segments
+ *  per thread so that threads which finish early can take another.
+ *
+ *  A random-access sequence such as cross or slice is divided by index.
+ *  A persistent sequence such as stack or list, which can only be walked
+ *  from the front, is walked once to find where each segment begins.
+ *
+ *  The functions passed to these must be safe to call from several threads
+ *  at once. Results are always in the same order as the input.
+ */
+
+namespace data {
+
+    // call f on every element of x.
+    template <typename F, ConstIterable X>
+    void parallel_for_each (thread_pool &, F &&f, const X &x);
+
+    // like lift with one sequence. Returns a cross for a cross, a list
+    // for a list and a stack for any other sequence.
+    template <typename F, ConstIterable X>
+    auto parallel_lift (thread_pool &, F &&f, const X &x);
+
+    // like fold, but f must be associative, since the elements are
+    // combined in a tree rather than from left to right. Each segment is
+    // folded starting from its first element, so the elements must be
+    // convertible to the result type.
+    template <typename F, typename V, ConstIterable X>
+    V parallel_fold (thread_pool &, F &&f, V init, const X &x);
+
+    // like select, with the elements that satisfy the predicate in
+    // the same order as in x. Works on cross and on any Pendable sequence.
+    template <ConstIterable X, typename F>
+    X parallel_select (thread_pool &, const X &x, F &&satisfies);
+
+    namespace detail {
+
+        // divide a sequence into segments of about equal size.
+        template <ConstIterable X> struct segments {
+            using iterator = decltype (std::declval<const X &> ().begin ());
+
+            struct segment {
+                iterator Begin;
+                size_t Size;
+            };
+
+            std::vector<segment> Segments;
+
+            segments (const X &x, size_t pieces) : Segments {} {
+                size_t n = data::size (x);
+                pieces = std::max<size_t> (std::min (pieces, n), 1);
+                iterator i = x.begin ();
+                size_t at = 0;
+                for (size_t p = 0; p < pieces; p++) {
+                    size_t end = n * (p + 1) / pieces;
+                    Segments.push_back (segment {i, end - at});
+                    if constexpr (std::random_access_iterator<iterator>) i += end - at;
+                    else for (; at < end; at++) ++i;
+                    at = end;
+                }
+            }
+
+            size_t size () const {
+                return Segments.size ();
+            }
+
+            template <typename F> void each (size_t s, F &&f) const {
+                iterator i = Segments[s].Begin;
+                for (size_t j = 0; j < Segments[s].Size; j++, ++i) f (*i);
+            }
+        };
+
+        // enough segments that threads that finish early have something else to do.
+        inline size_t segment_count (const thread_pool &pool) {
+            return 4 * (pool.size () + 1);
+        }
+
+        template <typename X> struct is_cross : std::false_type {};
+        template <typename X, typename S> struct is_cross<cross<X, S>> : std::true_type {};
+
+        template <typename X> struct is_list : std::false_type {};
+        template <typename X> struct is_list<list<X>> : std::true_type {};
+
+        // build a sequence of the same kind as X from segments of results.
+        // If the results have the same type as the elements of X, and X can
+        // be built up one element at a time, the result is an X.
+        template <typename X, typename R> auto rebuild (std::vector<std::vector<R>> &parts) {
+            using element = std::remove_cvref_t<decltype (*std::declval<const X &> ().begin ())>;
+
+            size_t n = 0;
+            for (const auto &p : parts) n += p.size ();
+
+            if constexpr (is_cross<X>::value) {
+                std::conditional_t<std::same_as<R, element>, X, cross<R>> z (n);
+                size_t i = 0;
+                for (auto &p : parts) for (auto &r : p) z[i++] = std::move (r);
+                return z;
+            } else if constexpr (std::same_as<R, element> && Pendable<X>) {
+                X z {};
+                if constexpr (Stack<X>) {
+                    for (auto p = parts.rbegin (); p != parts.rend (); p++)
+                        for (auto r = p->rbegin (); r != p->rend (); r++) z = prepend (z, *r);
+                } else for (auto &p : parts) for (auto &r : p) z = append (z, r);
+                return z;
+            } else if constexpr (is_list<X>::value) {
+                list<R> z {};
+                for (auto &p : parts) for (auto &r : p) z <<= r;
+                return z;
+            } else {
+                stack<R> z {};
+                for (auto p = parts.rbegin (); p != parts.rend (); p++)
+                    for (auto r = p->rbegin (); r != p->rend (); r++) z = prepend (z, *r);
+                return z;
+            }
+        }
+    }
+
+    template <typename F, ConstIterable X>
+    void parallel_for_each (thread_pool &pool, F &&f, const X &x) {
+        detail::segments<X> s {x, detail::segment_count (pool)};
+        parallel_for (pool, s.size (), [&] (size_t i) {
+            s.each (i, f);
+        });
+    }
+
+    template <typename F, ConstIterable X>
+    auto parallel_lift (thread_pool &pool, F &&f, const X &x) {
+        using result = std::remove_cvref_t<decltype (f (*x.begin ()))>;
+        detail::segments<X> s {x, detail::segment_count (pool)};
+
+        if constexpr (detail::is_cross<X>::value) {
+            // write straight into the result.
+            cross<result> z (data::size (x));
+            parallel_for (pool, s.size (), [&] (size_t i) {
+                size_t at = s.Segments[i].Begin - x.begin ();
+                s.each (i, [&] (const auto &e) {
+                    z[at++] = f (e);
+                });
+            });
+
+            return z;
+        } else {
+            std::vector<std::vector<result>> parts (s.size ());
+            parallel_for (pool, s.size (), [&] (size_t i) {
+                parts[i].reserve (s.Segments[i].Size);
+                s.each (i, [&] (const auto &e) {
+                    parts[i].push_back (f (e));
+                });
+            });
+
+            return detail::rebuild<X, result> (parts);
+        }
+    }
+
+    template <typename F, typename V, ConstIterable X>
+    V parallel_fold (thread_pool &pool, F &&f, V init, const X &x) {
+        if (data::empty (x)) return init;
+
+        detail::segments<X> s {x, detail::segment_count (pool)};
+        std::vector<maybe<V>> partial (s.size ());
+        parallel_for (pool, s.size (), [&] (size_t i) {
+            maybe<V> &z = partial[i];
+            s.each (i, [&] (const auto &e) {
+                if (bool (z)) z = f (*z, e);
+                else z = V (e);
+            });
+        });
+
+        // combine neighbors in rounds, so that the partial
+        // results are also combined in parallel.
+        for (size_t width = 1; width < partial.size (); width *= 2)
+            parallel_for (pool, (partial.size () + 2 * width - 1) / (2 * width), [&] (size_t i) {
+                size_t a = 2 * width * i;
+                size_t b = a + width;
+                if (b < partial.size ()) partial[a] = f (*partial[a], *partial[b]);
+            });
+
+        return f (init, *partial[0]);
+    }
+
+    template <ConstIterable X, typename F>
+    X parallel_select (thread_pool &pool, const X &x, F &&satisfies) {
+        using element = std::remove_cvref_t<decltype (*x.begin ())>;
+        detail::segments<X> s {x, detail::segment_count (pool)};
+        std::vector<std::vector<element>> parts (s.size ());
+        parallel_for (pool, s.size (), [&] (size_t i) {
+            s.each (i, [&] (const auto &e) {
+                if (satisfies (e)) parts[i].push_back (e);
+            });
+        });
+
+        return detail::rebuild<X, element> (parts);
+    }
+
+}
+
+#endif
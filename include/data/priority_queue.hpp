@@ -6,6 +6,7 @@
 #define DATA_PRIORITY_QUEUE
 
 #include <data/tools/priority_queue.hpp>
+#include <data/tools/pairing_heap.hpp>
 #include <data/tree.hpp>
 
 namespace data {
@@ -13,6 +14,9 @@ namespace data {
     // priority queue.
     template <typename X> using priority_queue = tool::priority_queue<tree<X>, X>;
 
+    // priority queue with O(1) insert and merge.
+    template <typename X> using pairing_heap = tool::pairing_heap<X>;
+
 }
 
 #endif
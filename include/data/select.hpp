@@ -19,19 +19,39 @@ namespace data {
     template <typename T, typename F>
     requires ConstIterable<T>
     T inline select (const T &x, F &&satisfies) {
-        T result;
-        if constexpr (IterableQueue<T>) {
+        if constexpr (IterableQueue<T> && meta::has_transient<T>) {
+            typename T::transient result {};
+            for (const auto &z : x) if (satisfies (z)) result <<= z;
+            return result.freeze ();
+        } else if constexpr (IterableQueue<T>) {
+            T result;
             for (const auto &z : x) if (satisfies (z)) result <<= z;
             return result;
-        } else if constexpr (IterableStack<T> ) {
+        } else if constexpr (IterableStack<T> && meta::has_transient<T>) {
+            // the transient can append, so there is no need to reverse.
+            typename T::transient result {};
+            for (const auto &z : x) if (satisfies (z)) result.append (z);
+            return result.freeze ();
+        } else if constexpr (IterableStack<T>) {
+            T result;
             for (const auto &z : x) if (satisfies (z)) result >>= z;
             return reverse (result);
+        } else if constexpr (IterableSack<T> && meta::has_transient<T>) {
+            typename T::transient result {};
+            for (const auto &z : x) if (satisfies (z)) result.insert (z);
+            return result.freeze ();
         } else if constexpr (IterableSack<T>) {
+            T result;
             for (const auto &z : x) if (satisfies (z)) result = insert (result, z);
             return result;
         // TODO there is a problem here because x.begin ()->Key doesn't necessarily exist.
         // if it doesn't, then this function won't compile even if another case is ok.
+        } else if constexpr (IterableMap<T> && meta::has_transient<T>) {
+            typename T::transient result {};
+            for (const auto &[k, v] : x) if (satisfies (v)) result.insert (k, v);
+            return result.freeze ();
         } else if constexpr (IterableMap<T>) {
+            T result;
             for (const auto &[k, v] : x) if (satisfies (v)) result = insert (result, k, v);
             return result;
         } else {
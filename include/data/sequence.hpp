@@ -117,7 +117,7 @@ namespace data {
     }
     
     template <Sequence list> 
-    list drop (const list &x, uint32 n) {
+    list drop (const list &x, size_t n) {
         return data::empty (x) || n == 0 ? x : drop (rest (x), n - 1);
     }
 
@@ -7,6 +7,9 @@
 
 #include <data/functional/list.hpp>
 #include <data/iterable.hpp>
+#include <data/tools/thread_pool.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace data {
 
@@ -32,6 +35,25 @@ namespace data {
         }
     }
 
+    // Sort a random-access range on the threads of a pool and the calling
+    // thread. The range is divided into one block per thread, which are
+    // sorted with std::sort and then merged in rounds. Each merge is divided
+    // into pieces of about equal size by a binary search for where each
+    // piece of the output begins in each input, so that all threads are
+    // busy in every round, including the last one.
+    template <std::random_access_iterator it, typename compare = std::less<>>
+    void parallel_sort (thread_pool &pool, it begin, it end, compare less = {});
+
+    // the same on a given number of threads, including the calling thread.
+    template <std::random_access_iterator it, typename compare = std::less<>>
+    void parallel_sort (uint32 threads, it begin, it end, compare less = {});
+
+    // sort using a thread pool. A Pendable list is copied into a
+    // contiguous buffer, sorted there, and then rebuilt once.
+    template <typename L> L sort (const L &x, thread_pool &pool);
+
+    template <typename L> L sort (const L &x, uint32 threads);
+
     template <typename L>
     bool sorted (const L &x) {
         if constexpr (Sequence<L>/* && Ordered<decltype (std::declval<L> ().first ())>*/) {
@@ -41,6 +63,158 @@ namespace data {
         }
     }
 
+    namespace detail {
+
+        // ranges smaller than this are not worth dividing between threads.
+        constexpr size_t parallel_sort_minimum = 1 << 14;
+
+        // the number of elements of a that come before the k-th
+        // element of the stable merge of a and b.
+        template <typename it, typename compare>
+        size_t merge_split (it a, size_t na, it b, size_t nb, size_t k, compare &less) {
+            size_t lo = k > nb ? k - nb : 0;
+            size_t hi = std::min (k, na);
+            while (lo < hi) {
+                size_t i = lo + (hi - lo) / 2;
+                if (!less (b[k - i - 1], a[i])) lo = i + 1;
+                else hi = i;
+            }
+
+            return lo;
+        }
+
+    }
+
+    template <std::random_access_iterator it, typename compare>
+    void parallel_sort (thread_pool &pool, it begin, it end, compare less) {
+        using value = std::iter_value_t<it>;
+        size_t n = end - begin;
+        size_t threads = pool.size () + 1;
+        if (threads < 2 || n < detail::parallel_sort_minimum) {
+            std::sort (begin, end, less);
+            return;
+        }
+
+        std::vector<value> buffer (std::make_move_iterator (begin), std::make_move_iterator (end));
+
+        // boundaries of the sorted runs.
+        std::vector<size_t> runs {};
+        for (size_t i = 0; i <= threads; i++) runs.push_back (n * i / threads);
+
+        parallel_for (pool, threads, [&] (size_t i) {
+            std::sort (buffer.begin () + runs[i], buffer.begin () + runs[i + 1], less);
+        });
+
+        std::vector<value> other (buffer.size ());
+        std::vector<value> *from = &buffer;
+        std::vector<value> *to = &other;
+
+        // a part of the merge of runs[r], runs[r + 1], runs[r + 2], starting at output position k.
+        struct piece {
+            size_t Run;
+            size_t Begin;
+            size_t End;
+        };
+
+        while (runs.size () > 2) {
+            std::vector<piece> pieces {};
+            std::vector<size_t> next {};
+            for (size_t r = 0; r + 1 < runs.size (); r += 2) {
+                next.push_back (runs[r]);
+                if (r + 2 >= runs.size ()) {
+                    // an odd run out is copied over.
+                    pieces.push_back (piece {r, runs[r], runs[r + 1]});
+                    continue;
+                }
+
+                size_t size = runs[r + 2] - runs[r];
+                size_t parts = std::max<size_t> (1, size * threads / n);
+                for (size_t p = 0; p < parts; p++)
+                    pieces.push_back (piece {r, runs[r] + size * p / parts, runs[r] + size * (p + 1) / parts});
+            }
+
+            next.push_back (n);
+
+            parallel_for (pool, pieces.size (), [&] (size_t i) {
+                const piece &p = pieces[i];
+                auto in = from->begin ();
+                auto out = to->begin ();
+                size_t a = runs[p.Run];
+                if (p.Run + 2 >= runs.size ()) {
+                    std::move (in + p.Begin, in + p.End, out + p.Begin);
+                    return;
+                }
+
+                size_t b = runs[p.Run + 1];
+                size_t na = b - a;
+                size_t nb = runs[p.Run + 2] - b;
+                size_t i0 = detail::merge_split (in + a, na, in + b, nb, p.Begin - a, less);
+                size_t i1 = detail::merge_split (in + a, na, in + b, nb, p.End - a, less);
+                size_t j0 = p.Begin - a - i0;
+                size_t j1 = p.End - a - i1;
+                std::merge (std::make_move_iterator (in + a + i0), std::make_move_iterator (in + a + i1),
+                    std::make_move_iterator (in + b + j0), std::make_move_iterator (in + b + j1), out + p.Begin, less);
+            });
+
+            runs = std::move (next);
+            std::swap (from, to);
+        }
+
+        std::vector<value> &result = *from;
+        parallel_for (pool, threads, [&] (size_t i) {
+            std::move (result.begin () + n * i / threads, result.begin () + n * (i + 1) / threads, begin + n * i / threads);
+        });
+    }
+
+    template <std::random_access_iterator it, typename compare>
+    void parallel_sort (uint32 threads, it begin, it end, compare less) {
+        if (threads < 2 || size_t (end - begin) < detail::parallel_sort_minimum) {
+            std::sort (begin, end, less);
+            return;
+        }
+
+        thread_pool pool {threads - 1};
+        parallel_sort (pool, begin, end, less);
+    }
+
+    namespace detail {
+
+        // sort x with a function that sorts a random-access range.
+        template <typename L, typename sorter> requires Pendable<L> || Iterable<L>
+        L sort_with (const L &x, sorter &&sort_range) {
+            if constexpr (Pendable<L>) {
+                using value = std::remove_cvref_t<decltype (data::first (x))>;
+                std::vector<value> buffer {};
+                buffer.reserve (data::size (x));
+                for (L y = x; !data::empty (y); y = data::rest (y)) buffer.push_back (data::first (y));
+
+                sort_range (buffer.begin (), buffer.end ());
+
+                L z {};
+                if constexpr (Stack<L>) for (auto i = buffer.rbegin (); i != buffer.rend (); i++) z = prepend (z, *i);
+                else for (const value &v : buffer) z = append (z, v);
+                return z;
+            } else {
+                auto z = x;
+                sort_range (z.begin (), z.end ());
+                return z;
+            }
+        }
+
+    }
+
+    template <typename L> L inline sort (const L &x, thread_pool &pool) {
+        return detail::sort_with (x, [&pool] (auto begin, auto end) {
+            parallel_sort (pool, begin, end);
+        });
+    }
+
+    template <typename L> L inline sort (const L &x, uint32 threads) {
+        return detail::sort_with (x, [threads] (auto begin, auto end) {
+            parallel_sort (threads, begin, end);
+        });
+    }
+
 }
 
 #endif
@@ -191,6 +191,23 @@
      *        sorted (z)             -> bool
      *
      *    ---------------------------------------------------------------------------
+     *    NODE STORAGE
+     *    ---------------------------------------------------------------------------
+     *
+     *    data::stack<X> holds its nodes in std::shared_ptr. The underlying type
+     *    data::linked_stack<X, alloc> accepts a storage policy from
+     *    data/tools/pool.hpp:
+     *
+     *        linked_stack<X, pool::concurrent>  pooled nodes, atomic count
+     *        linked_stack<X, pool::local>       pooled nodes, non-atomic count;
+     *                                           must not be shared between threads.
+     *
+     *    data::unrolled_stack<X, chunk_size, alloc> is an alternative
+     *    implementation of Stack that keeps up to chunk_size elements in each
+     *    node, which is much faster to iterate over and uses less memory. It
+     *    can be used as the underlying stack of data::list.
+     *
+     *    ---------------------------------------------------------------------------
 */
 
 // basic types
@@ -208,10 +225,11 @@
 
 // Implementation of Stack.
 #include <data/tools/linked_stack.hpp>
+#include <data/tools/unrolled_stack.hpp>
 
 namespace data {
 
-    template <typename X> using stack = linked_stack<X>;
+    template <typename X, typename alloc = pool::shared> using stack = linked_stack<X, alloc>;
 }
 
 #endif
@@ -0,0 +1,165 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_ATOMIC_SNAPSHOT
+#define DATA_TOOLS_ATOMIC_SNAPSHOT
+
+#include <atomic>
+#include <memory>
+#include <concepts>
+#include <data/types.hpp>
+
+namespace data {
+
+    // A cell holding a value that may be read and replaced concurrently. This
+    // is intended for persistent data structures such as data::map, where a
+    // copy is O(1) and a version that has been read will never change.
+    //
+    // Readers take a snapshot, which is a pointer to an immutable version of
+    // the value. Writers compute a new version from the current one and install
+    // it with compare-and-swap, retrying if another writer got there first.
+    // Old versions are released when the last snapshot of them is dropped.
+    // Writers never hold anything while they compute the new version.
+    //
+    // Loading or swapping the pointer is not lock-free on most standard
+    // libraries. libstdc++ guards std::atomic<std::shared_ptr> with a spin lock
+    // and std::atomic_load with a mutex from a global pool. These are held only
+    // for as long as it takes to copy the pointer, which is a short critical
+    // section, but a reader can still be delayed by another thread that holds
+    // it. is_lock_free says whether this is the case.
+    //
+    // Taking a snapshot also requires an atomic increment of a reference count
+    // that all readers share. For read-heavy loops, a reader caches its snapshot
+    // and only loads a new one when the version number has changed, so in the
+    // common case a read is just an atomic load of the version, which is lock-free.
+    template <typename X> class atomic_snapshot {
+    public:
+        using snapshot = ptr<const X>;
+
+        template <typename... Args> requires std::constructible_from<X, Args...>
+        atomic_snapshot (Args &&...args): Value {std::make_shared<const X> (std::forward<Args> (args)...)}, Version {0} {}
+
+        atomic_snapshot (const atomic_snapshot &) = delete;
+        atomic_snapshot &operator = (const atomic_snapshot &) = delete;
+
+        // the current version of the value.
+        snapshot load () const;
+
+        // incremented every time the value is replaced.
+        uint64 version () const;
+
+        // whether load and update work without a lock. See above.
+        bool is_lock_free () const;
+
+        // apply f to the current value.
+        template <typename fun> requires std::regular_invocable<fun, const X &>
+        auto operator () (fun &&f) const {
+            snapshot x = load ();
+            return f (*x);
+        }
+
+        void store (X x);
+
+        // replace the value with f (x), where x is the current value. f may be
+        // called more than once if there are other writers, so it should have
+        // no side effects. Returns the version that was installed.
+        template <typename fun> requires std::regular_invocable<fun, const X &>
+        snapshot update (fun &&f);
+
+        // a cached view of the cell for use by a single thread.
+        class reader {
+            const atomic_snapshot *Cell;
+            uint64 Version;
+            snapshot Value;
+
+        public:
+            reader (const atomic_snapshot &a): Cell {&a}, Version {a.version ()}, Value {a.load ()} {}
+
+            // the current value, which remains valid until the next call.
+            const X &operator * ();
+
+            const X *operator -> () {
+                return &**this;
+            }
+        };
+
+    private:
+#ifdef __cpp_lib_atomic_shared_ptr
+        std::atomic<snapshot> Value;
+#else
+        snapshot Value;
+#endif
+        std::atomic<uint64> Version;
+
+        bool compare_exchange (snapshot &expected, snapshot desired);
+    };
+
+    template <typename X>
+    typename atomic_snapshot<X>::snapshot inline atomic_snapshot<X>::load () const {
+#ifdef __cpp_lib_atomic_shared_ptr
+        return Value.load (std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit (&Value, std::memory_order_acquire);
+#endif
+    }
+
+    template <typename X>
+    uint64 inline atomic_snapshot<X>::version () const {
+        return Version.load (std::memory_order_acquire);
+    }
+
+    template <typename X>
+    bool inline atomic_snapshot<X>::is_lock_free () const {
+#ifdef __cpp_lib_atomic_shared_ptr
+        return Value.is_lock_free ();
+#else
+        return std::atomic_is_lock_free (&Value);
+#endif
+    }
+
+    template <typename X>
+    bool inline atomic_snapshot<X>::compare_exchange (snapshot &expected, snapshot desired) {
+#ifdef __cpp_lib_atomic_shared_ptr
+        return Value.compare_exchange_weak (expected, std::move (desired), std::memory_order_acq_rel, std::memory_order_acquire);
+#else
+        return std::atomic_compare_exchange_weak_explicit (&Value, &expected, std::move (desired),
+            std::memory_order_acq_rel, std::memory_order_acquire);
+#endif
+    }
+
+    template <typename X>
+    void atomic_snapshot<X>::store (X x) {
+        update ([&x] (const X &) -> X {
+            return x;
+        });
+    }
+
+    template <typename X>
+    template <typename fun> requires std::regular_invocable<fun, const X &>
+    typename atomic_snapshot<X>::snapshot atomic_snapshot<X>::update (fun &&f) {
+        snapshot old = load ();
+        while (true) {
+            snapshot next = std::make_shared<const X> (f (*old));
+            // on failure, old is replaced with the current value.
+            if (compare_exchange (old, next)) {
+                Version.fetch_add (1, std::memory_order_release);
+                return next;
+            }
+        }
+    }
+
+    template <typename X>
+    const X &atomic_snapshot<X>::reader::operator * () {
+        uint64 v = Cell->version ();
+        if (v != Version) {
+            Version = v;
+            Value = Cell->load ();
+        }
+
+        return *Value;
+    }
+
+}
+
+#endif
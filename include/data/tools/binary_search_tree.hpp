@@ -97,6 +97,26 @@ namespace data {
         binary_search_map (const tree &t): tree {t} {}
         binary_search_map (tree &&t): tree {t} {}
 
+        // construct a map from entries in increasing order of key. If the
+        // tree supports it, this takes O(n). from_sorted throws key_already_exists
+        // if a key is repeated and throws if the keys are out of order.
+        // from_sorted_unique does not check its input.
+        template <std::forward_iterator I, std::sentinel_for<I> S>
+        static binary_search_map from_sorted (I b, S e);
+
+        template <std::forward_iterator I, std::sentinel_for<I> S>
+        static binary_search_map from_sorted_unique (I b, S e);
+
+        template <std::ranges::forward_range R>
+        static binary_search_map from_sorted (const R &r) {
+            return from_sorted (std::ranges::begin (r), std::ranges::end (r));
+        }
+
+        template <std::ranges::forward_range R>
+        static binary_search_map from_sorted_unique (const R &r) {
+            return from_sorted_unique (std::ranges::begin (r), std::ranges::end (r));
+        }
+
         const value &operator [] (inserted<key>) const;
         value &operator [] (inserted<key>);
 
@@ -141,6 +161,10 @@ namespace data {
         requires ExplicitlyConvertible<value, X>
         explicit operator binary_search_map<key, X, T> () const;
 
+        // a builder for inserting many entries. If the underlying tree has
+        // a transient, nodes are modified in place where they are not shared.
+        struct transient;
+
         binary_search_map operator & (binary_search_map x) const;
         binary_search_map operator | (binary_search_map x) const;
         binary_search_map operator ^ (binary_search_map x) const;
@@ -174,6 +198,61 @@ namespace data {
         static const value &default_key_already_exists (const value & old_v, const value & new_v);
     };
     
+    template <Ordered key, typename value, functional::search_tree<data::entry<const key, value>> tree>
+    requires interface::has_insert_method<tree, data::entry<const key, value>>
+    struct binary_search_map<key, value, tree>::transient {
+        transient (): Map {} {}
+        transient (binary_search_map m): Map {static_cast<tree &&> (m)} {}
+
+        size_t size () const {
+            return Map.size ();
+        }
+
+        bool empty () const {
+            return Map.size () == 0;
+        }
+
+        transient &insert (const key &k, const value &v) {
+            return insert (k, v, &default_key_already_exists);
+        }
+
+        transient &insert (const entry &e) {
+            return insert (e.Key, e.Value);
+        }
+
+        transient &operator <<= (const entry &e) {
+            return insert (e);
+        }
+
+        template <typename already_exists> requires requires (already_exists f, const value &old_v, const value &new_v) {
+            { f (old_v, new_v) } -> ImplicitlyConvertible<value>;
+        } transient &insert (const key &k, const value &v, already_exists f) {
+            auto g = [f] (const entry &old_e, const entry &new_e) {
+                return entry {old_e.Key, f (old_e.Value, new_e.Value)};
+            };
+
+            if constexpr (meta::has_transient<tree>) Map.insert (entry {k, v}, g);
+            else Map = Map.insert (entry {k, v}, g);
+            return *this;
+        }
+
+        binary_search_map freeze () {
+            if constexpr (meta::has_transient<tree>) return binary_search_map {Map.freeze ()};
+            else return binary_search_map {std::move (Map)};
+        }
+
+    private:
+        template <typename X> struct builder {
+            using type = X;
+        };
+
+        template <meta::has_transient X> struct builder<X> {
+            using type = typename X::transient;
+        };
+
+        typename builder<tree>::type Map;
+    };
+
     template <Ordered key, typename value, typename tree>
     bool inline empty (binary_search_map<key, value, tree> x) {
         return x.empty ();
@@ -282,7 +361,9 @@ namespace data {
     template <Ordered key, typename value, functional::search_tree<data::entry<const key, value>> tree>
     requires interface::has_insert_method<tree, data::entry<const key, value>>
     inline binary_search_map<key, value, tree>::binary_search_map (std::initializer_list<entry> init) : tree {} {
-        for (const auto &p : init) *this = insert (p);
+        transient m {};
+        for (const auto &p : init) m.insert (p);
+        *this = m.freeze ();
     }
 
     template <typename key, std::equality_comparable value, typename tree,
@@ -306,18 +387,18 @@ namespace data {
     requires interface::has_insert_method<tree, data::entry<const key, value>>
     template <typename X, typename T> requires ImplicitlyConvertible<value, X>
     binary_search_map<key, value, tree>::operator binary_search_map<key, X, T> () const {
-        binary_search_map<key, X, T> m;
-        for (const auto &e : *this) m = m.insert (e);
-        return m;
+        typename binary_search_map<key, X, T>::transient m {};
+        for (const auto &e : *this) m.insert (e.Key, X (e.Value));
+        return m.freeze ();
     }
 
     template <Ordered key, typename value, functional::search_tree<data::entry<const key, value>> tree>
     requires interface::has_insert_method<tree, data::entry<const key, value>>
     template <typename X, typename T> requires ExplicitlyConvertible<value, X>
     binary_search_map<key, value, tree>::operator binary_search_map<key, X, T> () const {
-        binary_search_map<key, X, T> m;
-        for (const auto &e : *this) m = m.insert (e);
-        return m;
+        typename binary_search_map<key, X, T>::transient m {};
+        for (const auto &e : *this) m.insert (e.Key, X (e.Value));
+        return m.freeze ();
     }
 
     template <Ordered key, typename value, functional::search_tree<data::entry<const key, value>> tree>
@@ -462,9 +543,46 @@ namespace data {
     template <Ordered key, typename value, functional::search_tree<data::entry<const key, value>> tree>
     requires interface::has_insert_method<tree, data::entry<const key, value>>
     binary_search_map<key, value, tree> binary_search_map<key, value, tree>::remove (const key &k) const {
-        binary_search_map t;
-        for (const auto &e : *this) if (e.Key != k) t = t.insert (e);
-        return t;
+        auto cmp = [&k] (const entry &e) -> int {
+            return k < e.Key ? -1 : e.Key < k ? 1 : 0;
+        };
+
+        // RB::tree can remove an entry by key in O(log n).
+        if constexpr (requires (const tree &t) {
+            { t.remove_by (cmp) } -> ImplicitlyConvertible<tree>;
+        }) return static_cast<const tree &> (*this).remove_by (cmp);
+        else {
+            binary_search_map t;
+            for (const auto &e : *this) if (e.Key != k) t = t.insert (e);
+            return t;
+        }
+    }
+
+    template <Ordered key, typename value, functional::search_tree<data::entry<const key, value>> tree>
+    requires interface::has_insert_method<tree, data::entry<const key, value>>
+    template <std::forward_iterator I, std::sentinel_for<I> S>
+    binary_search_map<key, value, tree> binary_search_map<key, value, tree>::from_sorted_unique (I b, S e) {
+        // RB::tree can be built directly from sorted input.
+        if constexpr (requires (I i, S j) {
+            { tree::from_sorted_unique (i, j) } -> ImplicitlyConvertible<tree>;
+        }) return binary_search_map {tree::from_sorted_unique (b, e)};
+        else {
+            binary_search_map m;
+            for (; b != e; ++b) m = m.insert (*b);
+            return m;
+        }
+    }
+
+    template <Ordered key, typename value, functional::search_tree<data::entry<const key, value>> tree>
+    requires interface::has_insert_method<tree, data::entry<const key, value>>
+    template <std::forward_iterator I, std::sentinel_for<I> S>
+    binary_search_map<key, value, tree> binary_search_map<key, value, tree>::from_sorted (I b, S e) {
+        if (b != e) for (I last = b, i = std::next (b); i != e; last = i++) {
+            if ((*i).Key < (*last).Key) throw exception {} << "binary_search_map::from_sorted: input is not sorted";
+            if (!((*last).Key < (*i).Key)) throw key_already_exists {};
+        }
+
+        return from_sorted_unique (b, e);
     }
 
     template <typename key, typename value, typename tree>
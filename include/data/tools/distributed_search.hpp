@@ -9,6 +9,10 @@
 #include <data/cross.hpp>
 #include <data/function.hpp>
 #include <future>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
 
 namespace data::distributed {
 
@@ -26,6 +30,12 @@ namespace data::distributed {
     template <typename X, std::forward_iterator it>
     maybe<X> search (uint32 threads, test<X, it> trial, it begin, it end, int iteration_range = 10000);
 
+    // For random-access iterators, the search is done by the work-stealing
+    // backend below, in which case iteration_range is only the size of the
+    // first chunk that each thread claims.
+    template <typename X, std::random_access_iterator it>
+    maybe<X> search (uint32 threads, test<X, it> trial, it begin, it end, int iteration_range = 10000);
+
     template <typename it> struct parameter_range {
         it Begin;
         it End;
@@ -169,7 +179,7 @@ namespace data::distributed {
 
     template <typename X, std::forward_iterator it>
     maybe<X> running<X, it>::wait () {
-        for (auto &w: Workers) w.join ();
+        for (auto &w: Workers) if (w.joinable ()) w.join ();
         if (Searcher->solved ()) return Future.get ();
         return {};
     }
@@ -177,7 +187,7 @@ namespace data::distributed {
     template <typename X, std::forward_iterator it>
     inline running<X, it>::~running () {
         Searcher->close ();
-        for (auto &w: Workers) w.join ();
+        for (auto &w: Workers) if (w.joinable ()) w.join ();
     }
 
     template <typename X, std::forward_iterator it>
@@ -188,6 +198,290 @@ namespace data::distributed {
         for (int i = 0; i < threads; i++) Workers.emplace_back (search_thread<X, it>, x.get (), trial, i);
     }
 
+    // how far a search has gotten.
+    struct progress {
+        // number of candidates that have been tested.
+        uint64 Tested;
+        // size of the search space.
+        uint64 Total;
+        // time since the search began.
+        double Seconds;
+
+        // candidates tested per second.
+        double throughput () const {
+            return Seconds > 0 ? Tested / Seconds : 0;
+        }
+
+        double fraction () const {
+            return Total == 0 ? 1 : double (Tested) / double (Total);
+        }
+    };
+
+    // A work-stealing search over a random-access range.
+    //
+    // Threads claim chunks of the range from a shared atomic counter, so no
+    // thread ever waits for a lock. The size of a chunk is chosen from the
+    // measured time per candidate so that a chunk takes about ChunkTime to
+    // search. A thread works through its chunk in smaller batches, so that
+    // once the shared counter is exhausted, a thread with nothing to do can
+    // steal the upper half of whatever is left of another thread's chunk.
+    //
+    // All threads check for cancellation before every candidate, so the
+    // search stops promptly once a solution is found or cancel is called.
+    template <typename X, std::random_access_iterator it> class stealing {
+    public:
+        static constexpr std::chrono::nanoseconds ChunkTime = std::chrono::milliseconds {20};
+        static constexpr std::chrono::nanoseconds BatchTime = std::chrono::milliseconds {1};
+
+        stealing (uint32 threads, test<X, it> trial, it begin, it end, int initial_chunk = 10000);
+
+        // cancel the search and wait for all threads to stop.
+        ~stealing ();
+
+        // wait for all threads to finish. Rethrows the first exception
+        // thrown by any trial.
+        maybe<X> wait ();
+
+        // stop searching without a solution.
+        void cancel ();
+
+        // true if a solution has been found, the search has been
+        // cancelled, or a trial has thrown an exception.
+        bool stopped () const;
+
+        distributed::progress progress () const;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        // the part of a chunk that its owner has not yet searched, stored as
+        // offsets from Base in a single word so that the owner and thieves
+        // can both claim parts of it with compare-and-swap. The generation
+        // changes every time the owner starts a new chunk so that a thief
+        // cannot pair the offsets of one chunk with the base of another.
+        struct alignas (64) worker {
+            std::atomic<uint64> Base {0};
+            std::atomic<uint64> Range {0};
+        };
+
+        static constexpr uint64 OffsetBits = 24;
+        static constexpr uint64 MaxChunk = (uint64 {1} << OffsetBits) - 1;
+
+        static uint64 pack (uint64 next, uint64 end, uint64 generation) {
+            return next | (end << OffsetBits) | (generation << (2 * OffsetBits));
+        }
+
+        static uint64 next_of (uint64 r) {
+            return r & MaxChunk;
+        }
+
+        static uint64 end_of (uint64 r) {
+            return (r >> OffsetBits) & MaxChunk;
+        }
+
+        static uint64 generation_of (uint64 r) {
+            return r >> (2 * OffsetBits);
+        }
+
+        test<X, it> Trial;
+        it Begin;
+        uint64 Total;
+        uint64 InitialChunk;
+        clock::time_point Start;
+
+        std::unique_ptr<worker[]> Workers;
+        uint32 Count;
+
+        alignas (64) std::atomic<uint64> Next {0};
+        alignas (64) std::atomic<uint64> Tested {0};
+        alignas (64) std::atomic<bool> Stop {false};
+
+        // set by whichever thread first finds a solution or throws an exception.
+        std::atomic<bool> Settled {false};
+        maybe<X> Solution {};
+        std::exception_ptr Error {};
+
+        cross<thread> Pool;
+        bool Joined {false};
+
+        void run (uint32 index);
+        void install (uint32 index, uint64 begin, uint64 size);
+        // claim up to max candidates from a worker's chunk, returning the number claimed.
+        uint64 take (uint32 index, uint64 max, uint64 &begin);
+        bool steal (uint32 index);
+        void join ();
+    };
+
+    template <typename X, std::random_access_iterator it>
+    ptr<stealing<X, it>> inline search_in_background
+        (uint32 threads, test<X, it> trial, it begin, it end, int iteration_range = 10000) {
+        return std::make_shared<stealing<X, it>> (threads, trial, begin, end, iteration_range);
+    }
+
+    template <typename X, std::random_access_iterator it>
+    maybe<X> inline search (uint32 threads, test<X, it> trial, it begin, it end, int iteration_range) {
+        return search_in_background (threads, trial, begin, end, iteration_range)->wait ();
+    }
+
+    template <typename X, std::random_access_iterator it>
+    stealing<X, it>::stealing (uint32 threads, test<X, it> trial, it begin, it end, int initial_chunk):
+        Trial {trial}, Begin {begin}, Total {static_cast<uint64> (end - begin)},
+        InitialChunk {std::clamp<uint64> (initial_chunk, 1, MaxChunk)}, Start {clock::now ()},
+        Workers {new worker[threads == 0 ? 1 : threads]}, Count {threads == 0 ? 1 : threads} {
+        for (uint32 i = 0; i < Count; i++) Pool.emplace_back (&stealing::run, this, i);
+    }
+
+    template <typename X, std::random_access_iterator it>
+    inline stealing<X, it>::~stealing () {
+        cancel ();
+        join ();
+    }
+
+    template <typename X, std::random_access_iterator it>
+    void inline stealing<X, it>::join () {
+        if (Joined) return;
+        for (auto &w: Pool) w.join ();
+        Joined = true;
+    }
+
+    template <typename X, std::random_access_iterator it>
+    maybe<X> stealing<X, it>::wait () {
+        join ();
+        if (Error) std::rethrow_exception (Error);
+        return Solution;
+    }
+
+    template <typename X, std::random_access_iterator it>
+    void inline stealing<X, it>::cancel () {
+        Stop.store (true, std::memory_order_relaxed);
+    }
+
+    template <typename X, std::random_access_iterator it>
+    bool inline stealing<X, it>::stopped () const {
+        return Stop.load (std::memory_order_relaxed);
+    }
+
+    template <typename X, std::random_access_iterator it>
+    progress stealing<X, it>::progress () const {
+        return distributed::progress {Tested.load (std::memory_order_relaxed), Total,
+            std::chrono::duration<double> (clock::now () - Start).count ()};
+    }
+
+    template <typename X, std::random_access_iterator it>
+    void stealing<X, it>::install (uint32 index, uint64 begin, uint64 size) {
+        worker &w = Workers[index];
+        uint64 g = generation_of (w.Range.load (std::memory_order_relaxed));
+        // empty the chunk under a new generation before changing the base, so
+        // that a thief that read the old base cannot claim anything.
+        w.Range.store (pack (0, 0, g + 1), std::memory_order_seq_cst);
+        w.Base.store (begin, std::memory_order_seq_cst);
+        w.Range.store (pack (0, size, g + 2), std::memory_order_seq_cst);
+    }
+
+    template <typename X, std::random_access_iterator it>
+    uint64 stealing<X, it>::take (uint32 index, uint64 max, uint64 &begin) {
+        worker &w = Workers[index];
+        uint64 r = w.Range.load (std::memory_order_seq_cst);
+        while (true) {
+            uint64 n = next_of (r);
+            uint64 e = end_of (r);
+            if (n >= e) return 0;
+            uint64 k = std::min (max, e - n);
+            if (w.Range.compare_exchange_weak (r, pack (n + k, e, generation_of (r)), std::memory_order_seq_cst)) {
+                begin = w.Base.load (std::memory_order_seq_cst) + n;
+                return k;
+            }
+        }
+    }
+
+    template <typename X, std::random_access_iterator it>
+    bool stealing<X, it>::steal (uint32 index) {
+        while (!stopped ()) {
+            // choose the worker with the most left to do.
+            uint32 victim = index;
+            uint64 most = 1;
+            for (uint32 i = 0; i < Count; i++) {
+                if (i == index) continue;
+                uint64 r = Workers[i].Range.load (std::memory_order_relaxed);
+                uint64 left = end_of (r) > next_of (r) ? end_of (r) - next_of (r) : 0;
+                if (left > most) {
+                    most = left;
+                    victim = i;
+                }
+            }
+
+            // nobody has more than one candidate left, which its owner will handle.
+            if (victim == index) return false;
+
+            worker &w = Workers[victim];
+            uint64 r = w.Range.load (std::memory_order_seq_cst);
+            uint64 base = w.Base.load (std::memory_order_seq_cst);
+            uint64 n = next_of (r);
+            uint64 e = end_of (r);
+            if (n >= e || e - n < 2) continue;
+
+            uint64 middle = n + (e - n) / 2;
+            // fails if the owner or another thief has changed the chunk, including
+            // if the owner has installed a new chunk since we read the base.
+            if (w.Range.compare_exchange_strong (r, pack (n, middle, generation_of (r)), std::memory_order_seq_cst)) {
+                install (index, base + middle, e - middle);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename X, std::random_access_iterator it>
+    void stealing<X, it>::run (uint32 index) {
+        // measured time per candidate, used to size chunks and batches.
+        double nanoseconds = 0;
+        uint64 chunk = InitialChunk;
+        uint64 batch = std::max<uint64> (1, chunk / 16);
+
+        try {
+            while (!stopped ()) {
+                uint64 begin;
+                uint64 claimed = take (index, batch, begin);
+                if (claimed == 0) {
+                    uint64 next = Next.fetch_add (chunk, std::memory_order_relaxed);
+                    if (next < Total) install (index, next, std::min (chunk, Total - next));
+                    else if (!steal (index)) return;
+                    continue;
+                }
+
+                auto start = clock::now ();
+                uint64 tried = 0;
+                for (; tried < claimed; tried++) {
+                    if (stopped ()) break;
+                    maybe<X> solution = Trial (Begin + static_cast<std::iter_difference_t<it>> (begin + tried));
+                    if (bool (solution)) {
+                        bool expected = false;
+                        if (Settled.compare_exchange_strong (expected, true)) Solution = solution;
+                        cancel ();
+                        tried++;
+                        break;
+                    }
+                }
+
+                Tested.fetch_add (tried, std::memory_order_relaxed);
+                if (tried == 0) continue;
+
+                // the first measurement replaces the estimate entirely.
+                double measured = std::chrono::duration<double, std::nano> (clock::now () - start).count () / tried;
+                nanoseconds = nanoseconds == 0 ? measured : (3 * nanoseconds + measured) / 4;
+                if (nanoseconds > 0) {
+                    chunk = std::clamp<uint64> (uint64 (ChunkTime.count () / nanoseconds), 1, MaxChunk);
+                    batch = std::clamp<uint64> (uint64 (BatchTime.count () / nanoseconds), 1, chunk);
+                }
+            }
+        } catch (...) {
+            bool expected = false;
+            if (Settled.compare_exchange_strong (expected, true)) Error = std::current_exception ();
+            cancel ();
+        }
+    }
+
 }
 
 #endif
@@ -35,8 +35,20 @@ namespace data {
         { o << e } -> Same<std::ostream &>;
     } std::ostream &operator << (std::ostream &o, const functional_queue<stack, element> n);
     
+    namespace detail {
+        // provides functional_queue::transient if the stack has one.
+        template <typename stack, typename element> struct queue_transient {};
+
+        template <typename stack, typename element> requires requires {
+            typename stack::transient;
+        } struct queue_transient<stack, element> {
+            // a mutable builder that appends in place. See linked_stack::transient.
+            class transient;
+        };
+    }
+
     template <Stack stack, typename element> requires Sequence<stack, element>
-    struct functional_queue {
+    struct functional_queue : detail::queue_transient<stack, element> {
         
         functional_queue ();
         explicit functional_queue (const element &x);
@@ -123,6 +135,7 @@ namespace data {
         static functional_queue check (const stack l, const stack r);
         
         template <Stack Z, typename E> requires Sequence<Z, E> friend struct functional_queue;
+        friend struct detail::queue_transient<stack, element>;
 
         template <bool is_const>
         struct it {
@@ -194,6 +207,51 @@ namespace data {
         }
     };
 
+    template <typename stack, typename element> requires requires {
+        typename stack::transient;
+    } class detail::queue_transient<stack, element>::transient {
+        using functional_queue = data::functional_queue<stack, element>;
+        typename stack::transient Stack;
+
+    public:
+        transient (): Stack {} {}
+
+        // the right side of the queue is put in order on the end of the left side.
+        transient (functional_queue q): Stack {std::move (q.Left)} {
+            for (const auto &e : reverse (q.Right)) Stack.append (e);
+        }
+
+        size_t size () const {
+            return Stack.size ();
+        }
+
+        bool empty () const {
+            return Stack.empty ();
+        }
+
+        transient &append (const element &e) {
+            Stack.append (e);
+            return *this;
+        }
+
+        transient &prepend (const element &e) {
+            Stack.prepend (e);
+            return *this;
+        }
+
+        transient &operator <<= (const element &e) {
+            return append (e);
+        }
+
+        transient &operator >>= (const element &e) {
+            return prepend (e);
+        }
+
+        functional_queue freeze () {
+            return functional_queue {Stack.freeze ()};
+        }
+    };
+
     template <typename X, typename E> const E &last (const functional_queue<X, E> &x) {
         return x.last ();
     }
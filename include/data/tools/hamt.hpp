@@ -0,0 +1,721 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_HAMT
+#define DATA_TOOLS_HAMT
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <data/functional/map.hpp>
+#include <data/stack.hpp>
+
+// A persistent hash array mapped trie (Bagwell, "Ideal Hash Trees", 2001)
+// with the separate entry and child bitmaps of CHAMP (Steindorfer and Vinju, 2015).
+//
+// Each node covers 5 bits of the hash of the key and has up to 32 slots, each
+// of which may be either an entry or a child node. Only the occupied slots are
+// stored. Once all 64 bits of the hash have been used up, keys with the same
+// hash are kept in a list. Like the other functional data structures in this
+// library, every operation returns a new map which shares all but the changed
+// path with the old one.
+
+namespace data::hash {
+    template <size_t s> struct digest;
+}
+
+namespace data {
+
+    // the default hash function for keys in a HAMT.
+    template <typename K> struct key_hash {
+        size_t operator () (const K &k) const {
+            if constexpr (requires { std::hash<K> {} (k); }) return std::hash<K> {} (k);
+            else if constexpr (std::convertible_to<const K &, std::string_view>) return std::hash<std::string_view> {} (std::string_view (k));
+            else return std::hash<std::string_view> {} (std::string_view {reinterpret_cast<const char *> (std::data (k)), std::size (k) * sizeof (*std::data (k))});
+        }
+    };
+
+    // a digest is already uniformly distributed, so we can use its bytes directly.
+    // This is declared here rather than with hash::digest so that it is seen
+    // before key_hash is ever instantiated for a digest.
+    template <size_t size> requires (size >= sizeof (size_t))
+    struct key_hash<hash::digest<size>> {
+        size_t operator () (const hash::digest<size> &d) const {
+            size_t h;
+            std::memcpy (&h, d.data (), sizeof (size_t));
+            return h;
+        }
+    };
+
+    template <std::equality_comparable K, typename V, typename hasher = key_hash<K>> struct HAMT;
+
+    template <typename K, typename V, typename H>
+    bool operator == (const HAMT<K, V, H> &, const HAMT<K, V, H> &);
+
+    template <typename K, typename V, typename H>
+    std::ostream &operator << (std::ostream &, const HAMT<K, V, H> &);
+
+    template <typename K, typename V, typename H> bool empty (const HAMT<K, V, H> &);
+    template <typename K, typename V, typename H> size_t size (const HAMT<K, V, H> &);
+
+    template <typename K, typename V, typename H>
+    HAMT<K, V, H> insert (const HAMT<K, V, H> &, const K &, const V &);
+
+    template <typename K, typename V, typename H>
+    HAMT<K, V, H> remove (const HAMT<K, V, H> &, const K &);
+
+    template <std::equality_comparable K, typename V, typename hasher> struct HAMT {
+        using key = K;
+        using value = V;
+        using entry = data::entry<const K, V>;
+
+        HAMT ();
+        HAMT (std::initializer_list<entry>);
+
+        size_t size () const;
+        bool empty () const;
+        bool valid () const;
+
+        const V *contains (const K &) const;
+        bool contains (const entry &) const;
+
+        const V &operator [] (const K &) const;
+
+        HAMT insert (const K &k, const V &v) const {
+            return insert (k, v, &default_key_already_exists);
+        }
+
+        HAMT insert (const entry &e) const {
+            return insert (e.Key, e.Value);
+        }
+
+        HAMT operator << (const entry &) const;
+        HAMT &operator <<= (const entry &);
+
+        // if the key already exists, f (old_v, new_v) is put in the map.
+        template <typename already_exists> requires requires (already_exists f, const V &old_v, const V &new_v) {
+            { f (old_v, new_v) } -> ImplicitlyConvertible<V>;
+        } HAMT insert (const K &k, const V &v, already_exists f) const;
+
+        // return the same map if the key is not present.
+        HAMT remove (const K &) const;
+
+        stack<const K &> keys () const;
+        stack<const entry &> values () const;
+
+        struct iterator;
+
+        iterator begin () const;
+        iterator end () const;
+
+        struct key_does_not_exist : exception {
+            key_does_not_exist () : exception {"key does not exist"} {}
+        };
+
+        struct key_already_exists : exception {
+            key_already_exists () : exception {"key already exists"} {}
+        };
+
+    private:
+        struct item {
+            size_t Hash;
+            entry Entry;
+        };
+
+        // A node is allocated in one block together with its entries and
+        // children, which follow it in that order. Only the occupied slots
+        // are stored. Nodes are reference counted and each child pointer
+        // holds a reference.
+        struct node {
+            std::atomic<size_t> Count;
+            uint32 EntryMap;
+            uint32 ChildMap;
+            uint32 Items;
+            uint32 Children;
+
+            item *items () const;
+            node **children () const;
+        };
+
+        // the entries follow the node and the children follow the entries.
+        struct layout {
+            constexpr static size_t align = std::max ({alignof (node), alignof (item), alignof (node *)});
+
+            constexpr static size_t round (size_t x, size_t a) {
+                return (x + a - 1) / a * a;
+            }
+
+            constexpr static size_t items = round (sizeof (node), alignof (item));
+
+            constexpr static size_t children (size_t i) {
+                return round (items + i * sizeof (item), alignof (node *));
+            }
+
+            constexpr static size_t size (size_t i, size_t c) {
+                return children (i) + c * sizeof (node *);
+            }
+
+            static void free (node *n) {
+                size_t z = size (n->Items, n->Children);
+                n->~node ();
+                ::operator delete (static_cast<void *> (n), z, std::align_val_t {align});
+            }
+        };
+
+        // an owning pointer to a node.
+        class link {
+            node *Node;
+
+        public:
+            link () : Node {nullptr} {}
+
+            // take over a reference to n.
+            explicit link (node *n) : Node {n} {}
+
+            link (const link &l) : Node {retain (l.Node)} {}
+            link (link &&l) noexcept : Node {std::exchange (l.Node, nullptr)} {}
+
+            ~link () {
+                drop (Node);
+            }
+
+            link &operator = (const link &l) {
+                node *n = retain (l.Node);
+                drop (Node);
+                Node = n;
+                return *this;
+            }
+
+            link &operator = (link &&l) noexcept {
+                node *n = std::exchange (l.Node, nullptr);
+                drop (Node);
+                Node = n;
+                return *this;
+            }
+
+            node *get () const {
+                return Node;
+            }
+
+            node *operator -> () const {
+                return Node;
+            }
+
+            // give up the reference without dropping it.
+            node *release () {
+                return std::exchange (Node, nullptr);
+            }
+
+            bool operator == (const link &l) const {
+                return Node == l.Node;
+            }
+
+            bool operator == (std::nullptr_t) const {
+                return Node == nullptr;
+            }
+
+            static node *retain (node *n) {
+                if (n != nullptr) n->Count.fetch_add (1, std::memory_order_relaxed);
+                return n;
+            }
+
+            static void drop (node *n) {
+                if (n == nullptr || n->Count.fetch_sub (1, std::memory_order_acq_rel) != 1) return;
+                for (size_t i = 0; i < n->Items; i++) n->items ()[i].~item ();
+                for (size_t i = 0; i < n->Children; i++) drop (n->children ()[i]);
+                layout::free (n);
+            }
+        };
+
+        class builder;
+
+        constexpr static size_t bits = 5;
+
+        // nodes deeper than this hold keys whose hashes are all the same.
+        constexpr static size_t max_shift = 64;
+
+        // root at depth 0, then one level for every 5 bits of hash, then the collision list.
+        constexpr static size_t max_depth = (max_shift + bits - 1) / bits + 1;
+
+        link Root;
+        size_t Size;
+
+        HAMT (link r, size_t z) : Root {std::move (r)}, Size {z} {}
+
+        static uint32 bit (size_t hash, size_t shift) {
+            return uint32 {1} << ((hash >> shift) & 31);
+        }
+
+        static size_t index (uint32 map, uint32 b) {
+            return std::popcount (map & (b - 1));
+        }
+
+        static link pair (item &&a, item &&b, size_t shift);
+
+        // a copy of n with child c replaced.
+        static link replace_child (const node *n, size_t c, link &&x);
+
+        template <typename already_exists>
+        static link insert (const node *n, size_t shift, item &&x, already_exists &f, bool &added);
+
+        // returns a link to n if k is not found.
+        static link remove (node *n, size_t shift, const K &k, size_t h);
+
+        static const V &default_key_already_exists (const V &, const V &) {
+            throw key_already_exists {};
+        }
+    };
+
+    template <std::equality_comparable K, typename V, typename hasher> struct HAMT<K, V, hasher>::iterator {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = entry;
+        using reference         = const entry &;
+        using pointer           = const entry *;
+        using difference_type   = int;
+
+        iterator () : Stack {}, Depth {0} {}
+
+        reference operator * () const {
+            const frame &f = Stack[Depth - 1];
+            return f.Node->items ()[f.Index].Entry;
+        }
+
+        pointer operator -> () const {
+            return &**this;
+        }
+
+        iterator &operator ++ () {
+            Stack[Depth - 1].Index++;
+            settle ();
+            return *this;
+        }
+
+        iterator operator ++ (int) {
+            auto x = *this;
+            ++(*this);
+            return x;
+        }
+
+        bool operator == (const iterator &i) const {
+            return Depth == i.Depth && (Depth == 0 ||
+                (Stack[Depth - 1].Node == i.Stack[Depth - 1].Node && Stack[Depth - 1].Index == i.Stack[Depth - 1].Index));
+        }
+
+    private:
+        // Index runs over the entries of a node and then its children.
+        struct frame {
+            const node *Node;
+            size_t Index;
+        };
+
+        std::array<frame, max_depth> Stack;
+        size_t Depth;
+
+        iterator (const node *n) : iterator {} {
+            if (n == nullptr) return;
+            Stack[Depth++] = frame {n, 0};
+            settle ();
+        }
+
+        // move down until we reach an entry or up until we reach the end.
+        void settle () {
+            while (Depth > 0) {
+                frame &f = Stack[Depth - 1];
+                if (f.Index < f.Node->Items) return;
+                size_t c = f.Index - f.Node->Items;
+                if (c < f.Node->Children) {
+                    f.Index++;
+                    Stack[Depth++] = frame {f.Node->children ()[c], 0};
+                } else Depth--;
+            }
+        }
+
+        friend struct HAMT;
+    };
+
+    template <typename K, typename V, typename H>
+    bool operator == (const HAMT<K, V, H> &a, const HAMT<K, V, H> &b) {
+        if (a.size () != b.size ()) return false;
+        for (const auto &e : a) {
+            const V *v = b.contains (e.Key);
+            if (v == nullptr || !(*v == e.Value)) return false;
+        }
+        return true;
+    }
+
+    template <typename K, typename V, typename H>
+    std::ostream &operator << (std::ostream &o, const HAMT<K, V, H> &m) {
+        o << "{";
+        auto i = m.begin ();
+        if (i != m.end ()) {
+            o << *i;
+            while (++i != m.end ()) o << ", " << *i;
+        }
+        return o << "}";
+    }
+
+    template <typename K, typename V, typename H> bool inline empty (const HAMT<K, V, H> &m) {
+        return m.empty ();
+    }
+
+    template <typename K, typename V, typename H> size_t inline size (const HAMT<K, V, H> &m) {
+        return m.size ();
+    }
+
+    template <typename K, typename V, typename H>
+    HAMT<K, V, H> inline insert (const HAMT<K, V, H> &m, const K &k, const V &v) {
+        return m.insert (k, v);
+    }
+
+    template <typename K, typename V, typename H>
+    HAMT<K, V, H> inline remove (const HAMT<K, V, H> &m, const K &k) {
+        return m.remove (k);
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    inline HAMT<K, V, hasher>::HAMT () : Root {}, Size {0} {}
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    HAMT<K, V, hasher>::HAMT (std::initializer_list<entry> x) : HAMT {} {
+        for (const entry &e : x) *this = insert (e);
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    size_t inline HAMT<K, V, hasher>::size () const {
+        return Size;
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    bool inline HAMT<K, V, hasher>::empty () const {
+        return Size == 0;
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    bool HAMT<K, V, hasher>::valid () const {
+        for (const auto &e : *this) if (!data::valid (e)) return false;
+        return true;
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    const V *HAMT<K, V, hasher>::contains (const K &k) const {
+        size_t h = hasher {} (k);
+        const node *n = Root.get ();
+        size_t shift = 0;
+        while (n != nullptr) {
+            if (shift >= max_shift) {
+                for (size_t i = 0; i < n->Items; i++) if (n->items ()[i].Entry.Key == k) return &n->items ()[i].Entry.Value;
+                return nullptr;
+            }
+
+            uint32 b = bit (h, shift);
+            if (n->EntryMap & b) {
+                const item &i = n->items ()[index (n->EntryMap, b)];
+                return i.Hash == h && i.Entry.Key == k ? &i.Entry.Value : nullptr;
+            }
+
+            if (!(n->ChildMap & b)) return nullptr;
+            n = n->children ()[index (n->ChildMap, b)];
+            shift += bits;
+        }
+
+        return nullptr;
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    bool inline HAMT<K, V, hasher>::contains (const entry &e) const {
+        const V *v = contains (e.Key);
+        return v != nullptr && *v == e.Value;
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    const V inline &HAMT<K, V, hasher>::operator [] (const K &k) const {
+        const V *v = contains (k);
+        if (v == nullptr) throw key_does_not_exist {};
+        return *v;
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    HAMT<K, V, hasher> inline HAMT<K, V, hasher>::operator << (const entry &e) const {
+        return insert (e);
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    HAMT<K, V, hasher> inline &HAMT<K, V, hasher>::operator <<= (const entry &e) {
+        return *this = insert (e);
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    template <typename already_exists> requires requires (already_exists f, const V &old_v, const V &new_v) {
+        { f (old_v, new_v) } -> ImplicitlyConvertible<V>;
+    } HAMT<K, V, hasher> HAMT<K, V, hasher>::insert (const K &k, const V &v, already_exists f) const {
+        bool added = false;
+        link r = insert (Root.get (), 0, item {hasher {} (k), entry {k, v}}, f, added);
+        return HAMT {std::move (r), added ? Size + 1 : Size};
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    HAMT<K, V, hasher> HAMT<K, V, hasher>::remove (const K &k) const {
+        link r = remove (Root.get (), 0, k, hasher {} (k));
+        return r == Root ? *this : HAMT {std::move (r), Size - 1};
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    stack<const K &> HAMT<K, V, hasher>::keys () const {
+        stack<const K &> x;
+        for (const entry &e : *this) x >>= e.Key;
+        return x;
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    stack<const typename HAMT<K, V, hasher>::entry &> HAMT<K, V, hasher>::values () const {
+        stack<const entry &> x;
+        for (const entry &e : *this) x >>= e;
+        return x;
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    HAMT<K, V, hasher>::iterator inline HAMT<K, V, hasher>::begin () const {
+        return iterator {Root.get ()};
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    HAMT<K, V, hasher>::iterator inline HAMT<K, V, hasher>::end () const {
+        return iterator {};
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    inline HAMT<K, V, hasher>::item *HAMT<K, V, hasher>::node::items () const {
+        return reinterpret_cast<item *> (reinterpret_cast<byte *> (const_cast<node *> (this)) + layout::items);
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    inline HAMT<K, V, hasher>::node **HAMT<K, V, hasher>::node::children () const {
+        return reinterpret_cast<node **> (reinterpret_cast<byte *> (const_cast<node *> (this)) + layout::children (Items));
+    }
+
+    // constructs a node in place, entries first and then children. If anything
+    // throws before the node is finished, whatever has been built is destroyed.
+    template <std::equality_comparable K, typename V, typename hasher>
+    class HAMT<K, V, hasher>::builder {
+        node *Node;
+        uint32 Items;
+        uint32 Children;
+
+    public:
+        builder (uint32 entry_map, uint32 child_map, size_t items, size_t children) :
+            Node {static_cast<node *> (::operator new (layout::size (items, children), std::align_val_t {layout::align}))},
+            Items {0}, Children {0} {
+            new (Node) node {{1}, entry_map, child_map, static_cast<uint32> (items), static_cast<uint32> (children)};
+        }
+
+        builder (const builder &) = delete;
+
+        ~builder () {
+            if (Node == nullptr) return;
+            for (size_t i = 0; i < Items; i++) Node->items ()[i].~item ();
+            for (size_t i = 0; i < Children; i++) link::drop (Node->children ()[i]);
+            layout::free (Node);
+        }
+
+        template <typename I> void add_item (I &&i) {
+            new (Node->items () + Items) item {std::forward<I> (i)};
+            Items++;
+        }
+
+        void add_child (link &&l) {
+            Node->children ()[Children++] = l.release ();
+        }
+
+        // share a child of another node.
+        void add_child (node *n) {
+            Node->children ()[Children++] = link::retain (n);
+        }
+
+        link finish () {
+            return link {std::exchange (Node, nullptr)};
+        }
+    };
+
+    // a node containing two entries whose hashes agree below shift.
+    template <std::equality_comparable K, typename V, typename hasher>
+    HAMT<K, V, hasher>::link HAMT<K, V, hasher>::pair (item &&a, item &&b, size_t shift) {
+        if (shift >= max_shift) {
+            builder n {0, 0, 2, 0};
+            n.add_item (std::move (a));
+            n.add_item (std::move (b));
+            return n.finish ();
+        }
+
+        uint32 ba = bit (a.Hash, shift);
+        uint32 bb = bit (b.Hash, shift);
+        if (ba == bb) {
+            link child = pair (std::move (a), std::move (b), shift + bits);
+            builder n {0, ba, 0, 1};
+            n.add_child (std::move (child));
+            return n.finish ();
+        }
+
+        builder n {ba | bb, 0, 2, 0};
+        if (ba < bb) {
+            n.add_item (std::move (a));
+            n.add_item (std::move (b));
+        } else {
+            n.add_item (std::move (b));
+            n.add_item (std::move (a));
+        }
+        return n.finish ();
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    HAMT<K, V, hasher>::link HAMT<K, V, hasher>::replace_child (const node *n, size_t c, link &&x) {
+        builder next {n->EntryMap, n->ChildMap, n->Items, n->Children};
+        for (size_t i = 0; i < n->Items; i++) next.add_item (n->items ()[i]);
+        for (size_t i = 0; i < n->Children; i++)
+            if (i == c) next.add_child (std::move (x));
+            else next.add_child (n->children ()[i]);
+        return next.finish ();
+    }
+
+    template <std::equality_comparable K, typename V, typename hasher>
+    template <typename already_exists>
+    HAMT<K, V, hasher>::link HAMT<K, V, hasher>::insert
+        (const node *n, size_t shift, item &&x, already_exists &f, bool &added) {
+
+        if (n == nullptr) {
+            added = true;
+            builder next {bit (x.Hash, shift), 0, 1, 0};
+            next.add_item (std::move (x));
+            return next.finish ();
+        }
+
+        // entries cannot be assigned because the key is const, so
+        // we build new nodes rather than editing copies.
+        if (shift >= max_shift) {
+            size_t idx = 0;
+            while (idx < n->Items && !(n->items ()[idx].Entry.Key == x.Entry.Key)) idx++;
+
+            if (idx == n->Items) {
+                added = true;
+                builder next {0, 0, n->Items + 1, 0};
+                for (size_t i = 0; i < n->Items; i++) next.add_item (n->items ()[i]);
+                next.add_item (std::move (x));
+                return next.finish ();
+            }
+
+            const item &old = n->items ()[idx];
+            item replaced {old.Hash, entry {old.Entry.Key, f (old.Entry.Value, x.Entry.Value)}};
+            builder next {0, 0, n->Items, 0};
+            for (size_t i = 0; i < n->Items; i++)
+                if (i == idx) next.add_item (std::move (replaced));
+                else next.add_item (n->items ()[i]);
+            return next.finish ();
+        }
+
+        uint32 b = bit (x.Hash, shift);
+
+        if (n->EntryMap & b) {
+            size_t idx = index (n->EntryMap, b);
+            const item &old = n->items ()[idx];
+
+            if (old.Hash == x.Hash && old.Entry.Key == x.Entry.Key) {
+                item replaced {old.Hash, entry {old.Entry.Key, f (old.Entry.Value, x.Entry.Value)}};
+                builder next {n->EntryMap, n->ChildMap, n->Items, n->Children};
+                for (size_t i = 0; i < n->Items; i++)
+                    if (i == idx) next.add_item (std::move (replaced));
+                    else next.add_item (n->items ()[i]);
+                for (size_t i = 0; i < n->Children; i++) next.add_child (n->children ()[i]);
+                return next.finish ();
+            }
+
+            // move the old entry down into a new child along with the new one.
+            added = true;
+            link child = pair (item {old}, std::move (x), shift + bits);
+            size_t c = index (n->ChildMap, b);
+            builder next {n->EntryMap ^ b, n->ChildMap | b, n->Items - 1, n->Children + 1};
+            for (size_t i = 0; i < n->Items; i++) if (i != idx) next.add_item (n->items ()[i]);
+            for (size_t i = 0; i < c; i++) next.add_child (n->children ()[i]);
+            next.add_child (std::move (child));
+            for (size_t i = c; i < n->Children; i++) next.add_child (n->children ()[i]);
+            return next.finish ();
+        }
+
+        if (n->ChildMap & b) {
+            size_t c = index (n->ChildMap, b);
+            return replace_child (n, c, insert (n->children ()[c], shift + bits, std::move (x), f, added));
+        }
+
+        added = true;
+        size_t idx = index (n->EntryMap, b);
+        builder next {n->EntryMap | b, n->ChildMap, n->Items + 1, n->Children};
+        for (size_t i = 0; i < idx; i++) next.add_item (n->items ()[i]);
+        next.add_item (std::move (x));
+        for (size_t i = idx; i < n->Items; i++) next.add_item (n->items ()[i]);
+        for (size_t i = 0; i < n->Children; i++) next.add_child (n->children ()[i]);
+        return next.finish ();
+    }
+
+    // A child that is left with a single entry is replaced
+    // by that entry, so that every map has only one shape.
+    template <std::equality_comparable K, typename V, typename hasher>
+    HAMT<K, V, hasher>::link HAMT<K, V, hasher>::remove
+        (node *n, size_t shift, const K &k, size_t h) {
+        if (n == nullptr) return link {};
+
+        auto without_item = [n] (size_t idx, uint32 entry_map) {
+            builder next {entry_map, n->ChildMap, n->Items - 1, n->Children};
+            for (size_t i = 0; i < n->Items; i++) if (i != idx) next.add_item (n->items ()[i]);
+            for (size_t i = 0; i < n->Children; i++) next.add_child (n->children ()[i]);
+            return next.finish ();
+        };
+
+        if (shift >= max_shift) {
+            for (size_t i = 0; i < n->Items; i++)
+                if (n->items ()[i].Entry.Key == k)
+                    return n->Items == 1 ? link {} : without_item (i, 0);
+            return link {link::retain (n)};
+        }
+
+        uint32 b = bit (h, shift);
+
+        if (n->EntryMap & b) {
+            size_t idx = index (n->EntryMap, b);
+            const item &i = n->items ()[idx];
+            if (i.Hash != h || !(i.Entry.Key == k)) return link {link::retain (n)};
+            if (n->Items == 1 && n->Children == 0) return link {};
+            return without_item (idx, n->EntryMap ^ b);
+        }
+
+        if (!(n->ChildMap & b)) return link {link::retain (n)};
+
+        size_t c = index (n->ChildMap, b);
+        link child = remove (n->children ()[c], shift + bits, k, h);
+        if (child.get () == n->children ()[c]) return link {link::retain (n)};
+
+        if (child != nullptr && (child->Children > 0 || child->Items > 1))
+            return replace_child (n, c, std::move (child));
+
+        // the child is gone or has one entry left, which moves up into this node.
+        if (child == nullptr) {
+            if (n->Items == 0 && n->Children == 1) return link {};
+            builder next {n->EntryMap, n->ChildMap ^ b, n->Items, n->Children - 1};
+            for (size_t i = 0; i < n->Items; i++) next.add_item (n->items ()[i]);
+            for (size_t i = 0; i < n->Children; i++) if (i != c) next.add_child (n->children ()[i]);
+            return next.finish ();
+        }
+
+        size_t idx = index (n->EntryMap, b);
+        builder next {n->EntryMap | b, n->ChildMap ^ b, n->Items + 1, n->Children - 1};
+        for (size_t i = 0; i < idx; i++) next.add_item (n->items ()[i]);
+        next.add_item (child->items ()[0]);
+        for (size_t i = idx; i < n->Items; i++) next.add_item (n->items ()[i]);
+        for (size_t i = 0; i < n->Children; i++) if (i != c) next.add_child (n->children ()[i]);
+        return next.finish ();
+    }
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 #define DATA_TOOLS_LAZY_WRITER
 
 #include <data/stack.hpp>
+#include <data/tools/rope.hpp>
 #include <concepts>
 
 namespace data {
@@ -17,40 +18,45 @@ namespace data {
         };
 
     // lazy writer can be used without knowing the size
-    // of the data to be written beforehand.
+    // of the data to be written beforehand. The data is
+    // collected in a rope and copied into the result once
+    // on destruction.
     template <moved_vector_constructible bytes, std::integral word = unref<decltype (std::declval<bytes> ()[0])>>
     class lazy_writer : public writer<word> {
         bytes &Bytes;
-        size_t Capacity;
-        stack<std::vector<word>> Parts;
+        rope<word> Rope;
 
     public:
-        size_t TotalSize {0};
+        lazy_writer (bytes &b, size_t capacity = rope<word>::DefaultChunk) noexcept: Bytes {b}, Rope {capacity} {}
 
-        lazy_writer (bytes &b, size_t capacity = 1024 / sizeof (word)) noexcept: Bytes {b}, Capacity {capacity}, Parts {} {
-            Parts >>= std::vector<word> {};
-            Parts.first ().reserve (capacity);
+        void write (const word* b, size_t size) final override {
+            Rope.write (b, size);
         }
 
-        void write (const word* b, size_t size) final override {
-            std::vector<word> *current = &first (Parts);
-            std::size_t remaining = current->capacity () - current->size ();
-            if (remaining < size) {
-                current->insert (current->end (), b, b + remaining);
-                size -= remaining;
-                Parts >>= std::vector<word> {};
-                current = &first (Parts);
-                current->reserve (size > Capacity ? size : Capacity);
-            }
-            current->insert (current->end (), b, b + size);
-            TotalSize += size;
+        // the number of words written so far.
+        size_t size () const {
+            return Rope.size ();
         }
 
         ~lazy_writer () {
-            std::vector<word> v (TotalSize);
-            iterator_writer vv {v.begin (), v.end ()};
-            for (const std::vector<word> &b : reverse (Parts)) vv.write (b.data (), b.size ());
-            Bytes = bytes {std::move (v)};
+            Bytes = std::move (Rope).template flatten<bytes> ();
+        }
+    };
+
+    // a rope is already a writer, so we write to it directly.
+    template <std::integral word>
+    class lazy_writer<rope<word>, word> : public writer<word> {
+        rope<word> &Rope;
+
+    public:
+        lazy_writer (rope<word> &r, size_t = 0) noexcept: Rope {r} {}
+
+        void write (const word* b, size_t size) final override {
+            Rope.write (b, size);
+        }
+
+        size_t size () const {
+            return Rope.size ();
         }
     };
 
@@ -7,35 +7,45 @@
 
 #include <ostream>
 #include <data/functional/stack.hpp>
+#include <data/tools/pool.hpp>
     
 namespace data {
 
-    template <Copyable elem> class linked_stack;
+    // alloc is the node storage policy. See tools/pool.hpp.
+    template <Copyable elem, typename alloc = pool::shared> class linked_stack;
     
-    template <typename elem> bool empty (const linked_stack<elem> &x);
-    template <typename elem> size_t size (const linked_stack<elem> &x);
+    template <typename elem, typename alloc> bool empty (const linked_stack<elem, alloc> &x);
+    template <typename elem, typename alloc> size_t size (const linked_stack<elem, alloc> &x);
 
     // stack two stacks together.
-    template <typename elem> linked_stack<elem> operator + (linked_stack<elem>, linked_stack<elem>);
+    template <typename elem, typename alloc>
+    linked_stack<elem, alloc> operator + (linked_stack<elem, alloc>, linked_stack<elem, alloc>);
 
     // if elem has a << operator, then we can print the whole stack
-    template <typename elem> requires requires (std::ostream &o, const elem &e) {
+    template <typename elem, typename alloc> requires requires (std::ostream &o, const elem &e) {
         { o << e } -> Same<std::ostream &>;
-    } std::ostream inline &operator << (std::ostream &o, const linked_stack<elem> &x);
+    } std::ostream inline &operator << (std::ostream &o, const linked_stack<elem, alloc> &x);
 
-    template <typename elem> linked_stack<elem> values (const linked_stack<elem> &x);
+    template <typename elem, typename alloc> linked_stack<elem, alloc> values (const linked_stack<elem, alloc> &x);
 
-    template <Copyable elem>
+    template <Copyable elem, typename alloc>
     class linked_stack {
         
         using node = functional::stack_node<elem, linked_stack>;
-        using next = ptr<node>;
+        using next = typename alloc::template pointer<node>;
         
         next Next;
         linked_stack (next n);
         
     public:
         constexpr linked_stack ();
+        linked_stack (const linked_stack &) = default;
+        linked_stack (linked_stack &&) = default;
+        ~linked_stack ();
+
+        linked_stack &operator = (const linked_stack &) = default;
+        linked_stack &operator = (linked_stack &&) = default;
+
         explicit linked_stack (inserted<elem> e, const linked_stack &l);
         explicit linked_stack (inserted<elem> e);
         
@@ -82,11 +92,14 @@ namespace data {
 
         // automatic conversions
         template <typename X> requires ImplicitlyConvertible<elem, X>
-        operator linked_stack<X> () const;
+        operator linked_stack<X, alloc> () const;
 
         // explicit conversions
         template <typename X> requires ExplicitlyConvertible<elem, X>
-        explicit operator linked_stack<X> () const;
+        explicit operator linked_stack<X, alloc> () const;
+
+        // a mutable builder that can append to the end of a stack in place.
+        class transient;
 
         template <typename L, typename V>
         struct it {
@@ -112,9 +125,9 @@ namespace data {
             next Next;
         };
 
-        using iterator = it<linked_stack<elem>, elem>;
+        using iterator = it<linked_stack, elem>;
         
-        using const_iterator = it<const linked_stack<elem>, const elem>;
+        using const_iterator = it<const linked_stack, const elem>;
 
         iterator begin ();
         iterator end ();
@@ -124,206 +137,311 @@ namespace data {
         
     };
 
-    template <typename elem> const elem &last (const linked_stack<elem> &x) {
+    // A transient owns its nodes exclusively, so it can attach new nodes to the
+    // end of the stack without copying anything. Nodes that the stack it was
+    // made from shares with other stacks are copied when it is constructed.
+    // append takes O(1). freeze takes O(1) if only prepend was used. Otherwise
+    // it corrects the sizes stored in the nodes in a single pass, which does
+    // not allocate. The transient is empty after freeze.
+    template <Copyable elem, typename alloc>
+    class linked_stack<elem, alloc>::transient {
+        linked_stack Stack;
+        node *Last;
+        size_t Size;
+        bool Resize;
+
+    public:
+        transient (): Stack {}, Last {nullptr}, Size {0}, Resize {false} {}
+        transient (linked_stack x);
+
+        transient (const transient &) = delete;
+        transient (transient &&) = default;
+        transient &operator = (transient &&) = default;
+
+        size_t size () const {
+            return Size;
+        }
+
+        bool empty () const {
+            return Size == 0;
+        }
+
+        transient &prepend (inserted<elem> x);
+        transient &append (inserted<elem> x);
+
+        transient &operator >>= (inserted<elem> x) {
+            return prepend (x);
+        }
+
+        transient &operator <<= (inserted<elem> x) {
+            return append (x);
+        }
+
+        linked_stack freeze ();
+    };
+
+    template <typename elem, typename alloc> const elem &last (const linked_stack<elem, alloc> &x) {
         if (size (x) == 0) throw empty_sequence_exception {};
-        linked_stack<elem> y = x;
+        linked_stack<elem, alloc> y = x;
         while (size (y) > 1) y = rest (y);
         return first (y);
     }
 
-    template <typename elem> linked_stack<elem> operator + (linked_stack<elem> a, linked_stack<elem> b) {
+    template <typename elem, typename alloc>
+    linked_stack<elem, alloc> operator + (linked_stack<elem, alloc> a, linked_stack<elem, alloc> b) {
         return join (a, b);
     }
 
-    template <typename elem> bool inline empty (const linked_stack<elem> &x) {
+    template <typename elem, typename alloc> bool inline empty (const linked_stack<elem, alloc> &x) {
         return x.empty ();
     }
 
-    template <typename elem> linked_stack<elem> inline values (const linked_stack<elem> &x) {
+    template <typename elem, typename alloc> linked_stack<elem, alloc> inline values (const linked_stack<elem, alloc> &x) {
         return x;
     }
 
-    template <typename elem> size_t inline size (const linked_stack<elem> &x) {
+    template <typename elem, typename alloc> size_t inline size (const linked_stack<elem, alloc> &x) {
         return x.size ();
     }
     
-    template <typename elem> requires requires (std::ostream &o, const elem &e) {
+    template <typename elem, typename alloc> requires requires (std::ostream &o, const elem &e) {
         { o << e } -> Same<std::ostream &>;
-    } std::ostream inline &operator << (std::ostream &o, const linked_stack<elem> &x) {
+    } std::ostream inline &operator << (std::ostream &o, const linked_stack<elem, alloc> &x) {
         return functional::write (o << "stack ", x);
     }
     
-    template <Copyable elem>
-    inline linked_stack<elem>::linked_stack (next n) : Next {n} {}
+    template <Copyable elem, typename alloc>
+    inline linked_stack<elem, alloc>::linked_stack (next n) : Next {std::move (n)} {}
     
-    template <Copyable elem>
-    constexpr inline linked_stack<elem>::linked_stack () : Next {nullptr} {}
+    template <Copyable elem, typename alloc>
+    constexpr inline linked_stack<elem, alloc>::linked_stack () : Next {nullptr} {}
     
-    template <Copyable elem>
-    inline linked_stack<elem>::linked_stack (inserted<elem> e, const linked_stack &l) : linked_stack {std::make_shared<node> (e, l)} {}
+    template <Copyable elem, typename alloc>
+    inline linked_stack<elem, alloc>::~linked_stack () {
+        // release uniquely-owned nodes one at a time so that
+        // destroying a long stack does not overflow the call stack.
+        while (Next != nullptr && Next.use_count () == 1) Next = std::move (Next->Rest.Next);
+    }
+
+    template <Copyable elem, typename alloc>
+    inline linked_stack<elem, alloc>::linked_stack (inserted<elem> e, const linked_stack &l) : linked_stack {alloc::template make<node> (e, l)} {}
     
-    template <Copyable elem>
-    inline linked_stack<elem>::linked_stack (inserted<elem> e) : linked_stack {e, linked_stack {}} {}
+    template <Copyable elem, typename alloc>
+    inline linked_stack<elem, alloc>::linked_stack (inserted<elem> e) : linked_stack {e, linked_stack {}} {}
     
     // if the list is empty, then this function
     // will dereference a nullptr. It is your
     // responsibility to check. 
-    template <Copyable elem>
-    const elem inline &linked_stack<elem>::first () const {
+    template <Copyable elem, typename alloc>
+    const elem inline &linked_stack<elem, alloc>::first () const {
         if (Next == nullptr) throw empty_sequence_exception {};
         return Next->First;
     }
     
-    template <Copyable elem>
-    elem inline &linked_stack<elem>::first () {
+    template <Copyable elem, typename alloc>
+    elem inline &linked_stack<elem, alloc>::first () {
         if (Next == nullptr) throw empty_sequence_exception {};
         return Next->First;
     }
     
-    template <Copyable elem>
-    bool inline linked_stack<elem>::empty () const {
+    template <Copyable elem, typename alloc>
+    bool inline linked_stack<elem, alloc>::empty () const {
         return Next == nullptr;
     }
     
-    template <Copyable elem>
-    linked_stack<elem> inline linked_stack<elem>::rest () const {
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc> inline linked_stack<elem, alloc>::rest () const {
         if (empty ()) return {};
         
         return Next->rest ();
     }
     
-    template <Copyable elem>
-    inline bool linked_stack<elem>::valid () const {
+    template <Copyable elem, typename alloc>
+    inline bool linked_stack<elem, alloc>::valid () const {
         if (empty ()) return true;
         if (!data::valid (first ())) return false;
         return rest ().valid ();
     }
     
-    template <Copyable elem>
-    bool inline linked_stack<elem>::contains (elem x) const {
+    template <Copyable elem, typename alloc>
+    bool inline linked_stack<elem, alloc>::contains (elem x) const {
         if (empty ()) return false;
             
         return Next->contains (x);
     }
     
-    template <Copyable elem>
-    inline size_t linked_stack<elem>::size () const {
+    template <Copyable elem, typename alloc>
+    inline size_t linked_stack<elem, alloc>::size () const {
         if (empty ()) return 0;
             
         return Next->size ();
     }
     
-    template <Copyable elem>
-    linked_stack<elem> inline linked_stack<elem>::operator >> (inserted<elem> x) const {
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc> inline linked_stack<elem, alloc>::operator >> (inserted<elem> x) const {
         return linked_stack {x, *this};
     }
     
-    template <Copyable elem>
-    linked_stack<elem> inline linked_stack<elem>::prepend (inserted<elem> x) const {
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc> inline linked_stack<elem, alloc>::prepend (inserted<elem> x) const {
         return linked_stack {x, *this};
     }
     
-    template <Copyable elem>
-    linked_stack<elem> inline &linked_stack<elem>::operator >>= (inserted<elem> x) {
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc> inline &linked_stack<elem, alloc>::operator >>= (inserted<elem> x) {
         return *this = (prepend (x));
     }
 
-    template <Copyable elem>
+    template <Copyable elem, typename alloc>
     template <typename X, typename Y, typename ... P>
-    linked_stack<elem> inline linked_stack<elem>::prepend (X x, Y y, P ... p) const {
+    linked_stack<elem, alloc> inline linked_stack<elem, alloc>::prepend (X x, Y y, P ... p) const {
         return prepend (x).prepend (y, p...);
     }
     
-    template <Copyable elem>
-    linked_stack<elem> inline linked_stack<elem>::operator ^ (linked_stack l) const {
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc> inline linked_stack<elem, alloc>::operator ^ (linked_stack l) const {
         return prepend (l);
     }
     
-    template <Copyable elem>
-    linked_stack<elem> linked_stack<elem>::from (uint32 n) const {
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc> linked_stack<elem, alloc>::from (uint32 n) const {
         if (empty ()) return {};
         if (n == 0) return *this;
         return rest ().from (n - 1);
     }
     
-    template <Copyable elem>
-    const elem inline &linked_stack<elem>::operator [] (size_t n) const {
+    template <Copyable elem, typename alloc>
+    const elem inline &linked_stack<elem, alloc>::operator [] (size_t n) const {
         return drop (*this, n).first ();
     }
     
-    template <Copyable elem>
-    elem inline &linked_stack<elem>::operator [] (size_t n) {
+    template <Copyable elem, typename alloc>
+    elem inline &linked_stack<elem, alloc>::operator [] (size_t n) {
         return drop (*this, n).first ();
     }
 
-    template <Copyable elem>
-    linked_stack<elem>::const_iterator inline linked_stack<elem>::begin () const {
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc>::const_iterator inline linked_stack<elem, alloc>::begin () const {
         return const_iterator {this, Next};
     }
 
-    template <Copyable elem>
-    linked_stack<elem>::const_iterator inline linked_stack<elem>::end () const {
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc>::const_iterator inline linked_stack<elem, alloc>::end () const {
         return const_iterator {this, nullptr};
     }
 
-    template <Copyable elem>
-    linked_stack<elem>::iterator inline linked_stack<elem>::begin () {
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc>::iterator inline linked_stack<elem, alloc>::begin () {
         return iterator {this, Next};
     }
 
-    template <Copyable elem>
-    linked_stack<elem>::iterator inline linked_stack<elem>::end () {
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc>::iterator inline linked_stack<elem, alloc>::end () {
         return iterator {this, nullptr};
     }
 
-    template <Copyable elem>
+    template <Copyable elem, typename alloc>
     template <Sequence X> requires std::equality_comparable_with<elem, decltype (std::declval<X> ().first ())>
-    bool inline linked_stack<elem>::operator == (const X &x) const {
+    bool inline linked_stack<elem, alloc>::operator == (const X &x) const {
         return sequence_equal (*this, x);
     }
 
-    template <Copyable elem>
+    template <Copyable elem, typename alloc>
     template <typename X> requires ImplicitlyConvertible<elem, X>
-    inline linked_stack<elem>::operator linked_stack<X> () const {
-        if (size () == 0) return linked_stack<X> {};
-        return linked_stack<X> {rest ()}.prepend (X (first ()));
+    inline linked_stack<elem, alloc>::operator linked_stack<X, alloc> () const {
+        typename linked_stack<X, alloc>::transient x {};
+        for (const auto &e : *this) x.append (X (e));
+        return x.freeze ();
     }
 
-    template <Copyable elem>
+    template <Copyable elem, typename alloc>
     template <typename X> requires ExplicitlyConvertible<elem, X>
-    inline linked_stack<elem>::operator linked_stack<X> () const {
-        if (size () == 0) return linked_stack<X> {};
-        return linked_stack<X> {rest ()}.prepend (X (first ()));
+    inline linked_stack<elem, alloc>::operator linked_stack<X, alloc> () const {
+        typename linked_stack<X, alloc>::transient x {};
+        for (const auto &e : *this) x.append (X (e));
+        return x.freeze ();
+    }
+
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc>::transient::transient (linked_stack x): Stack {std::move (x)}, Last {nullptr}, Size {0}, Resize {false} {
+        // find the first node that is shared with another stack.
+        // that node and everything after it must be copied.
+        next *n = &Stack.Next;
+        while (*n != nullptr && n->use_count () == 1) {
+            Last = n->get ();
+            Size++;
+            n = &Last->Rest.Next;
+        }
+
+        if (*n == nullptr) return;
+
+        linked_stack shared {std::move (*n)};
+        for (const auto &e : shared) append (e);
+    }
+
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc>::transient inline &linked_stack<elem, alloc>::transient::prepend (inserted<elem> x) {
+        Stack = linked_stack {alloc::template make<node> (x, std::move (Stack))};
+        if (Last == nullptr) Last = Stack.Next.get ();
+        Size++;
+        return *this;
+    }
+
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc>::transient inline &linked_stack<elem, alloc>::transient::append (inserted<elem> x) {
+        next n = alloc::template make<node> (x);
+        node *last = n.get ();
+        if (Last == nullptr) Stack.Next = std::move (n);
+        else {
+            Last->Rest.Next = std::move (n);
+            Resize = true;
+        }
+        Last = last;
+        Size++;
+        return *this;
+    }
+
+    template <Copyable elem, typename alloc>
+    linked_stack<elem, alloc> linked_stack<elem, alloc>::transient::freeze () {
+        if (Resize) {
+            size_t z = Size;
+            for (node *n = Stack.Next.get (); n != nullptr; n = n->Rest.Next.get ()) n->Size = z--;
+        }
+
+        Last = nullptr;
+        Size = 0;
+        Resize = false;
+        return std::move (Stack);
     }
 
-    template <Copyable elem>
+    template <Copyable elem, typename alloc>
     template <typename L, typename V>
-    bool inline linked_stack<elem>::it<L, V>::operator == (const it &i) const {
+    bool inline linked_stack<elem, alloc>::it<L, V>::operator == (const it &i) const {
         return Stack == i.Stack && Next == i.Next;
     }
 
-    template <Copyable elem>
+    template <Copyable elem, typename alloc>
     template <typename L, typename V>
-    linked_stack<elem>::it<L, V>::reference inline linked_stack<elem>::it<L, V>::operator * () const {
+    linked_stack<elem, alloc>::it<L, V>::reference inline linked_stack<elem, alloc>::it<L, V>::operator * () const {
         return Next->First;
     }
 
-    template <Copyable elem>
+    template <Copyable elem, typename alloc>
     template <typename L, typename V>
-    linked_stack<elem>::it<L, V>::pointer inline linked_stack<elem>::it<L, V>::operator -> () const {
+    linked_stack<elem, alloc>::it<L, V>::pointer inline linked_stack<elem, alloc>::it<L, V>::operator -> () const {
         return &Next->First;
     }
 
-    template <Copyable elem>
+    template <Copyable elem, typename alloc>
     template <typename L, typename V>
-    linked_stack<elem>::it<L, V> inline &linked_stack<elem>::it<L, V>::operator ++ () {
+    linked_stack<elem, alloc>::it<L, V> inline &linked_stack<elem, alloc>::it<L, V>::operator ++ () {
         if (Next != nullptr) Next = Next->Rest.Next;
         return *this;
     }
 
-    template <Copyable elem>
+    template <Copyable elem, typename alloc>
     template <typename L, typename V>
-    linked_stack<elem>::it<L, V> inline linked_stack<elem>::it<L, V>::operator ++ (int) {
+    linked_stack<elem, alloc>::it<L, V> inline linked_stack<elem, alloc>::it<L, V>::operator ++ (int) {
         it n = *this;
         ++(*this);
         return n;
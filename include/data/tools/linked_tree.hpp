@@ -6,20 +6,22 @@
 #define DATA_TREE_LINKED
 
 #include <data/functional/tree.hpp>
+#include <data/tools/pool.hpp>
     
 namespace data {
 
-    template <Copyable value> struct linked_tree;
+    // alloc is the node storage policy. See tools/pool.hpp.
+    template <Copyable value, typename alloc = pool::shared> struct linked_tree;
     
-    template <typename value> bool empty (linked_tree<value> x);
-    template <typename value> size_t size (linked_tree<value> x);
+    template <typename value, typename alloc> bool empty (linked_tree<value, alloc> x);
+    template <typename value, typename alloc> size_t size (linked_tree<value, alloc> x);
 
-    template <typename V, std::equality_comparable_with<V> X>
-    bool operator == (const linked_tree<V> &, const linked_tree<X> &);
+    template <typename V, std::equality_comparable_with<V> X, typename alloc>
+    bool operator == (const linked_tree<V, alloc> &, const linked_tree<X, alloc> &);
 
-    template <Copyable value> struct linked_tree {
+    template <Copyable value, typename alloc> struct linked_tree {
         using node = functional::tree_node<value, linked_tree>;
-        using next = ptr<node>;
+        using next = typename alloc::template pointer<node>;
 
         bool empty () const;
         
@@ -41,91 +43,112 @@ namespace data {
         linked_tree (inserted<value> v);
 
         template <typename X> requires ImplicitlyConvertible<value, X>
-        operator linked_tree<X> () const;
+        operator linked_tree<X, alloc> () const;
 
         template <typename X> requires ExplicitlyConvertible<value, X>
-        explicit operator linked_tree<X> () const;
+        explicit operator linked_tree<X, alloc> () const;
         
         std::ostream &write (std::ostream &o) const;
 
+        // for transient builders, which modify trees in place. Return the
+        // root node, first replacing it with a copy if it is shared.
+        node &unique ();
+
+        // recalculate the size after the children have been changed in place.
+        void resize ();
+
         next Node;
         size_t Size;
     };
 
-    template <typename value> 
-    inline std::ostream &operator << (std::ostream &o, const linked_tree<value> &x) {
+    template <typename value, typename alloc>
+    inline std::ostream &operator << (std::ostream &o, const linked_tree<value, alloc> &x) {
         return x.write (o << "tree ");
     }
 
-    template <typename value> 
-    bool inline empty (linked_tree<value> x) {
+    template <typename value, typename alloc>
+    bool inline empty (linked_tree<value, alloc> x) {
         return x.empty ();
     }
 
-    template <typename value> 
-    size_t inline size (linked_tree<value> x) {
+    template <typename value, typename alloc>
+    size_t inline size (linked_tree<value, alloc> x) {
         return x.size ();
     }
     
-    template <Copyable value>
-    inline bool linked_tree<value>::empty () const {
+    template <Copyable value, typename alloc>
+    inline bool linked_tree<value, alloc>::empty () const {
         return Node == nullptr;
     }
     
-    template <Copyable value>
-    const value inline &linked_tree<value>::root () const {
+    template <Copyable value, typename alloc>
+    const value inline &linked_tree<value, alloc>::root () const {
         if (Node == nullptr) throw data::empty_sequence_exception {};
         return Node->Value;
     }
 
-    template <Copyable value>
-    value inline &linked_tree<value>::root () {
+    template <Copyable value, typename alloc>
+    value inline &linked_tree<value, alloc>::root () {
         if (Node == nullptr) throw data::empty_sequence_exception {};
         return Node->Value;
     }
     
-    template <Copyable value>
-    inline linked_tree<value> linked_tree<value>::left () const {
+    template <Copyable value, typename alloc>
+    inline linked_tree<value, alloc> linked_tree<value, alloc>::left () const {
         return Node == nullptr ? linked_tree {} : Node->Left;
     } 
     
-    template <Copyable value>
-    inline linked_tree<value> linked_tree<value>::right () const {
+    template <Copyable value, typename alloc>
+    inline linked_tree<value, alloc> linked_tree<value, alloc>::right () const {
         return Node == nullptr ? linked_tree {} : Node->Right;
     }
     
-    template <Copyable value>
-    bool linked_tree<value>::contains (inserted<value> v) const {
+    template <Copyable value, typename alloc>
+    bool linked_tree<value, alloc>::contains (inserted<value> v) const {
         if (Node == nullptr) return false;
         if (Node->Value == v) return true;
         if (Node->Left.contains (v)) return true;
         return Node->Right.contains (v);
     }
     
-    template <Copyable value>
-    inline size_t linked_tree<value>::size () const {
+    template <Copyable value, typename alloc>
+    inline size_t linked_tree<value, alloc>::size () const {
         return Size;
     }
     
-    template <Copyable value>
-    inline linked_tree<value>::linked_tree () : Node {nullptr}, Size {0} {}
+    template <Copyable value, typename alloc>
+    inline linked_tree<value, alloc>::linked_tree () : Node {nullptr}, Size {0} {}
     
-    template <Copyable value>
-    inline linked_tree<value>::linked_tree (inserted<value> v, linked_tree l, linked_tree r) :
-        Node {std::make_shared<node> (v, l, r)}, Size {1 + l.size () + r.size ()} {}
+    template <Copyable value, typename alloc>
+    inline linked_tree<value, alloc>::linked_tree (inserted<value> v, linked_tree l, linked_tree r) :
+        Node {nullptr}, Size {1 + l.size () + r.size ()} {
+        Node = alloc::template make<node> (v, std::move (l), std::move (r));
+    }
     
-    template <Copyable value>
-    inline linked_tree<value>::linked_tree (inserted<value> v) : linked_tree {v, linked_tree {}, linked_tree {}} {}
+    template <Copyable value, typename alloc>
+    inline linked_tree<value, alloc>::linked_tree (inserted<value> v) : linked_tree {v, linked_tree {}, linked_tree {}} {}
     
-    template <Copyable value>
-    std::ostream &linked_tree<value>::write (std::ostream &o) const {
+    template <Copyable value, typename alloc>
+    linked_tree<value, alloc>::node inline &linked_tree<value, alloc>::unique () {
+        if (Node == nullptr) throw data::empty_sequence_exception {};
+        if (Node.use_count () != 1) Node = alloc::template make<node> (Node->Value, Node->Left, Node->Right);
+        return *Node;
+    }
+
+    template <Copyable value, typename alloc>
+    void inline linked_tree<value, alloc>::resize () {
+        Size = Node == nullptr ? 0 : 1 + Node->Left.Size + Node->Right.Size;
+    }
+
+    template <Copyable value, typename alloc>
+    std::ostream &linked_tree<value, alloc>::write (std::ostream &o) const {
         if (Size == 0) return o << "{}";
         if (Size == 1) return o << "{" << root () << "}";
         return right ().write (left ().write (o << "{" << root () << ", ") << ", ") << "}";
     }
 
-    template <typename V, std::equality_comparable_with<V> X>
-    bool operator == (const linked_tree<V> &a, const linked_tree<X> &b) {
+    template <typename V, std::equality_comparable_with<V> X, typename alloc>
+    bool operator == (const linked_tree<V, alloc> &a, const linked_tree<X, alloc> &b) {
         if ((void *) a.Node.get () == (void *) b.Node.get ()) return true;
         if (a.Node == nullptr || b.Node == nullptr) return false;
         if (a.root () != b.root ()) return false;
@@ -133,16 +156,16 @@ namespace data {
         return a.right () == b.right ();
     }
 
-    template <Copyable value>
+    template <Copyable value, typename alloc>
     template <typename X> requires ImplicitlyConvertible<value, X>
-    inline linked_tree<value>::operator linked_tree<X> () const {
-        return empty () ? linked_tree <X> {} : linked_tree<X> {X (root ()), linked_tree<X> {left ()}, linked_tree<X> {right ()}};
+    inline linked_tree<value, alloc>::operator linked_tree<X, alloc> () const {
+        return empty () ? linked_tree<X, alloc> {} : linked_tree<X, alloc> {X (root ()), linked_tree<X, alloc> {left ()}, linked_tree<X, alloc> {right ()}};
     }
 
-    template <Copyable value>
+    template <Copyable value, typename alloc>
     template <typename X> requires ExplicitlyConvertible<value, X>
-    inline linked_tree<value>::operator linked_tree<X> () const {
-        return empty () ? linked_tree <X> {} : linked_tree<X> {X (root ()), linked_tree<X> {left ()}, linked_tree<X> {right ()}};
+    inline linked_tree<value, alloc>::operator linked_tree<X, alloc> () const {
+        return empty () ? linked_tree<X, alloc> {} : linked_tree<X, alloc> {X (root ()), linked_tree<X, alloc> {left ()}, linked_tree<X, alloc> {right ()}};
     }
 
 }
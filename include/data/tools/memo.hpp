@@ -0,0 +1,262 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_MEMO
+#define DATA_TOOLS_MEMO
+
+#include <atomic>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <data/function.hpp>
+#include <data/maybe.hpp>
+#include <data/ordered.hpp>
+#include <data/tools/hamt.hpp>
+
+namespace data {
+
+    // keys that can be hashed with key_hash.
+    template <typename K> concept Hashable = requires (const K &k) {
+        { std::hash<K> {} (k) } -> std::convertible_to<size_t>;
+    } || std::convertible_to<const K &, std::string_view> || std::ranges::contiguous_range<const K>;
+
+    // A pure function with a cache that may be shared between threads.
+    //
+    // The cache is divided into shards, each of which has its own lock, so
+    // that threads looking up different keys rarely wait for each other.
+    // Lookups take a shared lock, so hits on the same shard do not block
+    // each other either. Keys that can be hashed are distributed over the
+    // shards by their hash. Keys that are only ordered go in a single shard.
+    //
+    // Each shard holds a fixed number of entries and evicts with the CLOCK
+    // algorithm, which approximates LRU without having to reorder anything on
+    // a hit: a hit marks the entry, and on eviction, marked entries are
+    // unmarked and passed over once before they can be evicted.
+    //
+    // If several threads miss on the same key at the same time, only one of
+    // them calls the function and the others wait for its result. If the
+    // function throws, the exception is passed to all of them and nothing is
+    // cached. The function may call the memo recursively, but not with the
+    // key that it was called with.
+    template <typename key, std::copy_constructible value> requires Hashable<key> || Ordered<key>
+    class memo {
+    public:
+        struct statistics {
+            uint64 Hits;
+            uint64 Misses;
+            // misses that waited for another thread to compute the same value.
+            uint64 Shared;
+            uint64 Evictions;
+
+            double hit_rate () const {
+                uint64 total = Hits + Misses + Shared;
+                return total == 0 ? 0 : double (Hits + Shared) / double (total);
+            }
+        };
+
+        explicit memo (function<value (const key &)> f, size_t capacity = 4096, size_t shards = 16);
+
+        memo (const memo &) = delete;
+        memo &operator = (const memo &) = delete;
+
+        value operator () (const key &);
+
+        // the cached value, if there is one, without calling the function.
+        maybe<value> cached (const key &) const;
+
+        statistics stats () const;
+
+        size_t size () const;
+
+        size_t capacity () const {
+            return ShardCapacity * ShardCount;
+        }
+
+        void clear ();
+
+    private:
+        struct slot {
+            maybe<key> Key;
+            maybe<value> Value;
+            std::atomic<bool> Referenced {false};
+        };
+
+        using index = std::conditional_t<Hashable<key>,
+            std::unordered_map<key, size_t, key_hash<key>>,
+            std::map<key, size_t>>;
+
+        using in_flight = std::conditional_t<Hashable<key>,
+            std::unordered_map<key, std::shared_future<value>, key_hash<key>>,
+            std::map<key, std::shared_future<value>>>;
+
+        struct alignas (64) shard {
+            mutable std::shared_mutex Mutex;
+            index Index;
+            std::unique_ptr<slot[]> Slots;
+            size_t Used {0};
+            size_t Hand {0};
+            in_flight Pending;
+
+            std::atomic<uint64> Hits {0};
+            std::atomic<uint64> Misses {0};
+            std::atomic<uint64> Shared {0};
+            std::atomic<uint64> Evictions {0};
+        };
+
+        function<value (const key &)> Function;
+        size_t ShardCount;
+        size_t ShardCapacity;
+        std::unique_ptr<shard[]> Shards;
+
+        shard &shard_of (const key &) const;
+
+        // put a value in a shard whose lock we hold.
+        void store (shard &, const key &, const value &);
+    };
+
+    template <typename key, std::copy_constructible value> requires Hashable<key> || Ordered<key>
+    memo<key, value>::memo (function<value (const key &)> f, size_t capacity, size_t shards):
+        Function {f}, ShardCount {Hashable<key> ? std::max (shards, size_t {1}) : 1},
+        ShardCapacity {std::max ((capacity + ShardCount - 1) / ShardCount, size_t {1})},
+        Shards {new shard[ShardCount]} {
+        for (size_t i = 0; i < ShardCount; i++) Shards[i].Slots.reset (new slot[ShardCapacity]);
+    }
+
+    template <typename key, std::copy_constructible value> requires Hashable<key> || Ordered<key>
+    typename memo<key, value>::shard inline &memo<key, value>::shard_of (const key &k) const {
+        if constexpr (Hashable<key>) return Shards[key_hash<key> {} (k) % ShardCount];
+        else return Shards[0];
+    }
+
+    template <typename key, std::copy_constructible value> requires Hashable<key> || Ordered<key>
+    maybe<value> memo<key, value>::cached (const key &k) const {
+        shard &s = shard_of (k);
+        std::shared_lock<std::shared_mutex> lock {s.Mutex};
+        auto i = s.Index.find (k);
+        if (i == s.Index.end ()) return {};
+        slot &x = s.Slots[i->second];
+        x.Referenced.store (true, std::memory_order_relaxed);
+        return x.Value;
+    }
+
+    template <typename key, std::copy_constructible value> requires Hashable<key> || Ordered<key>
+    value memo<key, value>::operator () (const key &k) {
+        shard &s = shard_of (k);
+
+        if (maybe<value> v = cached (k); bool (v)) {
+            s.Hits.fetch_add (1, std::memory_order_relaxed);
+            return *v;
+        }
+
+        std::promise<value> promise;
+        {
+            std::unique_lock<std::shared_mutex> lock {s.Mutex};
+
+            // someone may have put it there since we looked.
+            if (auto i = s.Index.find (k); i != s.Index.end ()) {
+                s.Hits.fetch_add (1, std::memory_order_relaxed);
+                return *s.Slots[i->second].Value;
+            }
+
+            if (auto p = s.Pending.find (k); p != s.Pending.end ()) {
+                std::shared_future<value> f = p->second;
+                lock.unlock ();
+                s.Shared.fetch_add (1, std::memory_order_relaxed);
+                return f.get ();
+            }
+
+            s.Pending.emplace (k, promise.get_future ().share ());
+        }
+
+        s.Misses.fetch_add (1, std::memory_order_relaxed);
+
+        try {
+            value v = Function (k);
+            {
+                std::unique_lock<std::shared_mutex> lock {s.Mutex};
+                store (s, k, v);
+                s.Pending.erase (k);
+            }
+
+            promise.set_value (v);
+            return v;
+        } catch (...) {
+            {
+                std::unique_lock<std::shared_mutex> lock {s.Mutex};
+                s.Pending.erase (k);
+            }
+
+            promise.set_exception (std::current_exception ());
+            throw;
+        }
+    }
+
+    template <typename key, std::copy_constructible value> requires Hashable<key> || Ordered<key>
+    void memo<key, value>::store (shard &s, const key &k, const value &v) {
+        size_t i;
+        if (s.Used < ShardCapacity) i = s.Used++;
+        else {
+            // go around until we find an entry that has not been used since we last passed it.
+            while (s.Slots[s.Hand].Referenced.exchange (false, std::memory_order_relaxed))
+                s.Hand = (s.Hand + 1) % ShardCapacity;
+
+            i = s.Hand;
+            s.Hand = (s.Hand + 1) % ShardCapacity;
+            s.Index.erase (*s.Slots[i].Key);
+            s.Evictions.fetch_add (1, std::memory_order_relaxed);
+        }
+
+        slot &x = s.Slots[i];
+        x.Key = k;
+        x.Value = v;
+        x.Referenced.store (false, std::memory_order_relaxed);
+        s.Index[k] = i;
+    }
+
+    template <typename key, std::copy_constructible value> requires Hashable<key> || Ordered<key>
+    typename memo<key, value>::statistics memo<key, value>::stats () const {
+        statistics z {0, 0, 0, 0};
+        for (size_t i = 0; i < ShardCount; i++) {
+            z.Hits += Shards[i].Hits.load (std::memory_order_relaxed);
+            z.Misses += Shards[i].Misses.load (std::memory_order_relaxed);
+            z.Shared += Shards[i].Shared.load (std::memory_order_relaxed);
+            z.Evictions += Shards[i].Evictions.load (std::memory_order_relaxed);
+        }
+
+        return z;
+    }
+
+    template <typename key, std::copy_constructible value> requires Hashable<key> || Ordered<key>
+    size_t memo<key, value>::size () const {
+        size_t z = 0;
+        for (size_t i = 0; i < ShardCount; i++) {
+            std::shared_lock<std::shared_mutex> lock {Shards[i].Mutex};
+            z += Shards[i].Used;
+        }
+
+        return z;
+    }
+
+    template <typename key, std::copy_constructible value> requires Hashable<key> || Ordered<key>
+    void memo<key, value>::clear () {
+        for (size_t i = 0; i < ShardCount; i++) {
+            shard &s = Shards[i];
+            std::unique_lock<std::shared_mutex> lock {s.Mutex};
+            s.Index.clear ();
+            for (size_t j = 0; j < s.Used; j++) {
+                s.Slots[j].Key = {};
+                s.Slots[j].Value = {};
+            }
+
+            s.Used = 0;
+            s.Hand = 0;
+        }
+    }
+
+}
+
+#endif
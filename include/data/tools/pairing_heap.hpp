@@ -0,0 +1,321 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_PAIRING_HEAP
+#define DATA_TOOLS_PAIRING_HEAP
+
+#include <vector>
+#include <algorithm>
+#include <data/stack.hpp>
+#include <data/tools/pool.hpp>
+#include <data/ordered_sequence.hpp>
+#include <data/ordered.hpp>
+
+namespace data::tool {
+
+    // A persistent pairing heap with the same interface as priority_queue.
+    // insert and merge take O(1) in the worst case. rest takes O(log n)
+    // amortized when the heap is used in a single-threaded way, as in
+    // eratosthenes. Since the heap is persistent, the amortized bound does not
+    // hold if rest is called repeatedly on the same old version of a heap.
+    //
+    // The heap is stored as a binary tree in which the left branch of a
+    // node points to its first child and the right branch to its next
+    // sibling. A node's sibling is only meaningful below the root.
+    //
+    // alloc is the node storage policy. See tools/pool.hpp.
+    template <Prioritized element, typename alloc = pool::shared> struct pairing_heap;
+
+    template <Prioritized element, typename alloc>
+    bool empty (const pairing_heap<element, alloc> &x);
+
+    template <Prioritized element, typename alloc>
+    size_t size (const pairing_heap<element, alloc> &x);
+
+    template <Prioritized element, typename alloc>
+    ordered_sequence<element> values (const pairing_heap<element, alloc> &x);
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> merge (const pairing_heap<element, alloc> &a, const pairing_heap<element, alloc> &b);
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> operator & (const pairing_heap<element, alloc> &a, const pairing_heap<element, alloc> &b);
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> operator << (const pairing_heap<element, alloc> &p, inserted<element> elem);
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> &operator <<= (pairing_heap<element, alloc> &p, inserted<element> elem);
+
+    template <Prioritized element, typename alloc>
+    struct pairing_heap {
+
+        pairing_heap (): Root {nullptr}, Size {0} {}
+        pairing_heap (inserted<element> e);
+
+        pairing_heap (std::initializer_list<wrapped<element>> init): pairing_heap {} {
+            for (const auto &x : init) *this = insert (x);
+        }
+
+        template <typename list> requires Sequence<list, element>
+        pairing_heap (list l);
+
+        bool empty () const;
+        size_t size () const;
+        bool valid () const;
+
+        const element &first () const;
+        pairing_heap rest () const;
+
+        pairing_heap insert (inserted<element> elem) const;
+
+        template <typename list> requires Sequence<list, element>
+        pairing_heap insert (list l) const;
+
+        static pairing_heap merge (const pairing_heap &a, const pairing_heap &b);
+
+        bool contains (const inserted<element> e) const;
+
+        stack<const element &> values () const;
+
+        template <Sequence X> requires std::equality_comparable_with<element, decltype (std::declval<X> ().first ())>
+        bool operator == (const X &x) const {
+            return sequence_equal (*this, x);
+        }
+
+    private:
+        struct node;
+        using pointer = typename alloc::template pointer<node>;
+
+        struct node {
+            element Value;
+            pointer Child;
+            pointer Sibling;
+
+            node (inserted<element> v, pointer c, pointer s): Value {v}, Child {c}, Sibling {s} {}
+
+            ~node () {
+                release (std::move (Child));
+                release (std::move (Sibling));
+            }
+        };
+
+        pointer Root;
+        size_t Size;
+
+        pairing_heap (pointer r, size_t z): Root {r}, Size {z} {}
+
+        // link two nodes as roots, ignoring their siblings.
+        static pointer link (const pointer &a, const pointer &b);
+
+        // drop a pointer without recursion.
+        static void release (pointer n);
+    };
+
+    template <Prioritized element, typename alloc>
+    bool inline empty (const pairing_heap<element, alloc> &x) {
+        return x.empty ();
+    }
+
+    template <Prioritized element, typename alloc>
+    size_t inline size (const pairing_heap<element, alloc> &x) {
+        return x.size ();
+    }
+
+    template <Prioritized element, typename alloc>
+    ordered_sequence<element> values (const pairing_heap<element, alloc> &x) {
+        stack<element> vals;
+        auto pq = x;
+        while (!pq.empty ()) {
+            vals >>= pq.first ();
+            pq = pq.rest ();
+        }
+
+        return reverse (vals);
+    }
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> inline merge (const pairing_heap<element, alloc> &a, const pairing_heap<element, alloc> &b) {
+        return pairing_heap<element, alloc>::merge (a, b);
+    }
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> inline operator & (const pairing_heap<element, alloc> &a, const pairing_heap<element, alloc> &b) {
+        return merge (a, b);
+    }
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> inline operator << (const pairing_heap<element, alloc> &p, inserted<element> elem) {
+        return p.insert (elem);
+    }
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> inline &operator <<= (pairing_heap<element, alloc> &p, inserted<element> elem) {
+        return p = p.insert (elem);
+    }
+
+    template <Prioritized element, typename alloc>
+    inline pairing_heap<element, alloc>::pairing_heap (inserted<element> e):
+        Root {alloc::template make<node> (e, pointer {nullptr}, pointer {nullptr})}, Size {1} {}
+
+    template <Prioritized element, typename alloc>
+    template <typename list> requires Sequence<list, element>
+    inline pairing_heap<element, alloc>::pairing_heap (list l): pairing_heap {pairing_heap {}.insert (l)} {}
+
+    template <Prioritized element, typename alloc>
+    void pairing_heap<element, alloc>::release (pointer n) {
+        // every node that is destroyed goes through here, whether the heap
+        // is destroyed or assigned to. Uniquely-owned nodes are released by
+        // rotating the first child of each node into the place of the node
+        // itself, so that a node is only destroyed once its child and
+        // sibling have been moved out of it. Thus destroying a deep heap
+        // does not overflow the call stack.
+        while (n != nullptr && n.use_count () == 1) {
+            if (n->Child == nullptr) {
+                n = std::move (n->Sibling);
+                continue;
+            }
+
+            pointer c = std::move (n->Child);
+            if (c.use_count () != 1) continue;
+            n->Child = std::move (c->Sibling);
+            c->Sibling = std::move (n);
+            n = std::move (c);
+        }
+    }
+
+    template <Prioritized element, typename alloc>
+    bool inline pairing_heap<element, alloc>::empty () const {
+        return Root == nullptr;
+    }
+
+    template <Prioritized element, typename alloc>
+    size_t inline pairing_heap<element, alloc>::size () const {
+        return Size;
+    }
+
+    template <Prioritized element, typename alloc>
+    bool pairing_heap<element, alloc>::valid () const {
+        if (Root == nullptr) return Size == 0;
+        if (Root->Sibling != nullptr) return false;
+        size_t count = 0;
+        std::vector<const node *> pending {Root.get ()};
+        while (!pending.empty ()) {
+            const node *n = pending.back ();
+            pending.pop_back ();
+            count++;
+            for (const node *c = n->Child.get (); c != nullptr; c = c->Sibling.get ()) {
+                if (!data::valid (c->Value) || !(n->Value <= c->Value)) return false;
+                pending.push_back (c);
+            }
+        }
+
+        return count == Size && data::valid (Root->Value);
+    }
+
+    template <Prioritized element, typename alloc>
+    const element inline &pairing_heap<element, alloc>::first () const {
+        if (Root == nullptr) throw empty_sequence_exception {};
+        return Root->Value;
+    }
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc>::pointer pairing_heap<element, alloc>::link (const pointer &a, const pointer &b) {
+        if (a == nullptr) return b == nullptr || b->Sibling == nullptr ? b : alloc::template make<node> (b->Value, b->Child, pointer {nullptr});
+        if (b == nullptr) return link (b, a);
+        if (a->Value <= b->Value)
+            return alloc::template make<node> (a->Value, alloc::template make<node> (b->Value, b->Child, a->Child), pointer {nullptr});
+        return alloc::template make<node> (b->Value, alloc::template make<node> (a->Value, a->Child, b->Child), pointer {nullptr});
+    }
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> inline pairing_heap<element, alloc>::merge (const pairing_heap &a, const pairing_heap &b) {
+        return pairing_heap {link (a.Root, b.Root), a.Size + b.Size};
+    }
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> inline pairing_heap<element, alloc>::insert (inserted<element> elem) const {
+        return merge (*this, pairing_heap (elem));
+    }
+
+    template <Prioritized element, typename alloc>
+    template <typename list> requires Sequence<list, element>
+    pairing_heap<element, alloc> pairing_heap<element, alloc>::insert (list l) const {
+        pairing_heap h = *this;
+        while (!data::empty (l)) {
+            h = h.insert (l.first ());
+            l = l.rest ();
+        }
+
+        return h;
+    }
+
+    template <Prioritized element, typename alloc>
+    pairing_heap<element, alloc> pairing_heap<element, alloc>::rest () const {
+        if (Root == nullptr) return *this;
+
+        // two-pass merge: link the children in pairs from left
+        // to right and then merge the pairs from right to left.
+        std::vector<pointer> pairs;
+        const pointer *c = &Root->Child;
+        while (*c != nullptr) {
+            const pointer &d = (*c)->Sibling;
+            if (d == nullptr) {
+                pairs.push_back (link (*c, nullptr));
+                break;
+            }
+
+            pairs.push_back (link (*c, d));
+            c = &d->Sibling;
+        }
+
+        pointer result {nullptr};
+        for (auto i = pairs.rbegin (); i != pairs.rend (); i++) result = link (*i, result);
+        return pairing_heap {result, Size - 1};
+    }
+
+    template <Prioritized element, typename alloc>
+    bool pairing_heap<element, alloc>::contains (const inserted<element> e) const {
+        if (Root == nullptr) return false;
+        std::vector<const node *> pending {Root.get ()};
+        while (!pending.empty ()) {
+            const node *n = pending.back ();
+            pending.pop_back ();
+            if (e == n->Value) return true;
+            // everything below n is at least as great as n.
+            if (e <= n->Value) continue;
+            for (const node *c = n->Child.get (); c != nullptr; c = c->Sibling.get ()) pending.push_back (c);
+        }
+
+        return false;
+    }
+
+    template <Prioritized element, typename alloc>
+    stack<const element &> pairing_heap<element, alloc>::values () const {
+        stack<const element &> result;
+        // the values are stored in the nodes of this heap, so
+        // we can refer to them as long as this heap exists.
+        auto greater = [] (const node *a, const node *b) -> bool {
+            return !(a->Value <= b->Value);
+        };
+
+        std::vector<const node *> pending {};
+        if (Root != nullptr) pending.push_back (Root.get ());
+        while (!pending.empty ()) {
+            std::pop_heap (pending.begin (), pending.end (), greater);
+            const node *n = pending.back ();
+            pending.pop_back ();
+            result >>= n->Value;
+            for (const node *c = n->Child.get (); c != nullptr; c = c->Sibling.get ()) {
+                pending.push_back (c);
+                std::push_heap (pending.begin (), pending.end (), greater);
+            }
+        }
+
+        return reverse (result);
+    }
+
+}
+
+#endif
@@ -0,0 +1,326 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_POOL
+#define DATA_TOOLS_POOL
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <data/types.hpp>
+
+// Node storage policies for the linked data structures (linked_stack and linked_tree).
+//
+//   pool::shared      nodes are held by std::shared_ptr. This is the default.
+//   pool::concurrent  nodes are allocated from a slab pool and held by an
+//                     intrusive pointer with an atomic reference count.
+//   pool::local       like concurrent, except that the reference count is
+//                     not atomic. Use this only for structures that will
+//                     never be shared between threads.
+
+namespace data::pool {
+
+    // a pool of fixed-size blocks. Each thread has its own free list
+    // so that allocation and deallocation do not require any locking.
+    // When a thread exits, its free blocks are returned to a global list
+    // that other threads can draw on. Memory is never returned to the
+    // system because nodes may outlive the thread that allocated them.
+    template <size_t size, size_t align> class slab {
+        union block {
+            block *Next;
+            alignas (align) byte Data[size];
+        };
+
+        // allocate around 64k at a time.
+        constexpr static size_t blocks_per_chunk = std::max (size_t {64}, size_t {65536} / sizeof (block));
+
+        // a list of free blocks that knows its last element and
+        // its length, so that lists can be joined in constant time.
+        struct list {
+            block *First {nullptr};
+            block *Last {nullptr};
+            size_t Count {0};
+
+            void push (block *b) {
+                b->Next = First;
+                if (First == nullptr) Last = b;
+                First = b;
+                Count++;
+            }
+
+            block *pop () {
+                block *b = First;
+                First = b->Next;
+                if (First == nullptr) Last = nullptr;
+                Count--;
+                return b;
+            }
+
+            // move all blocks from l to this list.
+            void take (list &l) {
+                if (l.First == nullptr) return;
+                l.Last->Next = First;
+                if (First == nullptr) Last = l.Last;
+                First = l.First;
+                Count += l.Count;
+                l = list {};
+            }
+
+            // remove and return all but the first n blocks.
+            list split (size_t n) {
+                if (n >= Count) return list {};
+                if (n == 0) return std::exchange (*this, list {});
+                block *b = First;
+                for (size_t i = 1; i < n; i++) b = b->Next;
+                list rest {b->Next, Last, Count - n};
+                b->Next = nullptr;
+                Last = b;
+                Count = n;
+                return rest;
+            }
+        };
+
+        struct global {
+            std::mutex Mutex;
+            list Free {};
+        };
+
+        static global &shared () {
+            // never destroyed so that nodes can still be released during static destruction.
+            static global *g = new global {};
+            return *g;
+        }
+
+        // a thread's free list holds at most this many blocks before
+        // half of them are returned to the global list. Keeping the other
+        // half means that a thread that allocates and frees around this
+        // number of blocks does not go back to the global list every time.
+        constexpr static size_t max_local = 4 * blocks_per_chunk;
+
+        struct local {
+            list Free {};
+
+            // return all but keep free blocks to the global list.
+            void release (size_t keep = 0) {
+                list rest = Free.split (keep);
+                if (rest.First == nullptr) return;
+                global &g = shared ();
+                std::lock_guard<std::mutex> lock {g.Mutex};
+                g.Free.take (rest);
+            }
+
+            ~local () {
+                release ();
+                destroyed () = true;
+            }
+        };
+
+        static local &cache () {
+            thread_local local l {};
+            return l;
+        }
+
+        // set when this thread's cache has been destroyed. Nodes may still be
+        // released after that by the destructors of other thread_local or static
+        // objects, so from then on we go directly to the global list. This is
+        // trivially destructible so it remains usable until the thread exits.
+        static bool &destroyed () {
+            thread_local bool d {false};
+            return d;
+        }
+
+        static list chunk () {
+            block *c = static_cast<block *> (::operator new (blocks_per_chunk * sizeof (block), std::align_val_t {alignof (block)}));
+            for (size_t i = 0; i < blocks_per_chunk - 1; i++) c[i].Next = c + i + 1;
+            c[blocks_per_chunk - 1].Next = nullptr;
+            return list {c, c + blocks_per_chunk - 1, blocks_per_chunk};
+        }
+
+        // take up to a chunk's worth of blocks from the global list
+        // so that other threads can have the rest.
+        static void refill (local &l) {
+            {
+                global &g = shared ();
+                std::lock_guard<std::mutex> lock {g.Mutex};
+                list rest = g.Free.split (blocks_per_chunk);
+                l.Free.take (g.Free);
+                g.Free = rest;
+                if (l.Free.First != nullptr) return;
+            }
+
+            list c = chunk ();
+            l.Free.take (c);
+        }
+
+    public:
+        static void *allocate () {
+            if (destroyed ()) {
+                global &g = shared ();
+                std::lock_guard<std::mutex> lock {g.Mutex};
+                if (g.Free.First == nullptr) {
+                    list c = chunk ();
+                    g.Free.take (c);
+                }
+
+                return g.Free.pop ();
+            }
+
+            local &l = cache ();
+            if (l.Free.First == nullptr) refill (l);
+            return l.Free.pop ();
+        }
+
+        static void deallocate (void *p) {
+            block *b = static_cast<block *> (p);
+            if (destroyed ()) {
+                global &g = shared ();
+                std::lock_guard<std::mutex> lock {g.Mutex};
+                g.Free.push (b);
+                return;
+            }
+
+            local &l = cache ();
+            l.Free.push (b);
+            // if this thread is only freeing nodes allocated by other
+            // threads, don't let them all pile up here.
+            if (l.Free.Count > max_local) l.release (max_local / 2);
+        }
+    };
+
+    // a value together with its reference count.
+    template <typename X, bool atomic> struct counted {
+        using count = std::conditional_t<atomic, std::atomic<size_t>, size_t>;
+
+        count Count;
+        X Value;
+
+        template <typename ...A>
+        counted (A &&...a): Count {1}, Value {std::forward<A> (a)...} {}
+    };
+
+    // an intrusive reference-counted pointer to a pooled value.
+    template <typename X, bool atomic> class pointer {
+        using node = counted<X, atomic>;
+
+        // this must not be a member type alias because X
+        // may be incomplete when the pointer type is declared.
+        template <typename N = node> using allocator = slab<sizeof (N), alignof (N)>;
+
+        node *Node;
+
+        explicit pointer (node *n) noexcept : Node {n} {}
+
+        void retain () const noexcept {
+            if (Node == nullptr) return;
+            if constexpr (atomic) Node->Count.fetch_add (1, std::memory_order_relaxed);
+            else Node->Count++;
+        }
+
+        void release () noexcept {
+            if (Node == nullptr) return;
+            if constexpr (atomic) {
+                if (Node->Count.fetch_sub (1, std::memory_order_acq_rel) != 1) return;
+            } else if (--Node->Count != 0) return;
+            Node->~node ();
+            allocator<>::deallocate (Node);
+        }
+
+    public:
+        constexpr pointer () noexcept : Node {nullptr} {}
+        constexpr pointer (std::nullptr_t) noexcept : Node {nullptr} {}
+
+        pointer (const pointer &p) noexcept : Node {p.Node} {
+            retain ();
+        }
+
+        pointer (pointer &&p) noexcept : Node {p.Node} {
+            p.Node = nullptr;
+        }
+
+        ~pointer () {
+            release ();
+        }
+
+        pointer &operator = (const pointer &p) noexcept {
+            p.retain ();
+            release ();
+            Node = p.Node;
+            return *this;
+        }
+
+        pointer &operator = (pointer &&p) noexcept {
+            // p may be owned by the node that we are about to release.
+            node *n = p.Node;
+            p.Node = nullptr;
+            release ();
+            Node = n;
+            return *this;
+        }
+
+        X *get () const noexcept {
+            return Node == nullptr ? nullptr : &Node->Value;
+        }
+
+        X &operator * () const noexcept {
+            return Node->Value;
+        }
+
+        X *operator -> () const noexcept {
+            return &Node->Value;
+        }
+
+        explicit operator bool () const noexcept {
+            return Node != nullptr;
+        }
+
+        size_t use_count () const noexcept {
+            return Node == nullptr ? 0 : size_t (Node->Count);
+        }
+
+        bool operator == (const pointer &p) const noexcept {
+            return Node == p.Node;
+        }
+
+        bool operator == (std::nullptr_t) const noexcept {
+            return Node == nullptr;
+        }
+
+        template <typename ...A>
+        static pointer make (A &&...a) {
+            void *b = allocator<>::allocate ();
+            try {
+                return pointer {new (b) node {std::forward<A> (a)...}};
+            } catch (...) {
+                allocator<>::deallocate (b);
+                throw;
+            }
+        }
+    };
+
+    // storage policies.
+    struct shared {
+        template <typename X> using pointer = ptr<X>;
+
+        template <typename X, typename ...A>
+        static ptr<X> make (A &&...a) {
+            return std::make_shared<X> (std::forward<A> (a)...);
+        }
+    };
+
+    template <bool atomic> struct pooled {
+        template <typename X> using pointer = pool::pointer<X, atomic>;
+
+        template <typename X, typename ...A>
+        static pointer<X> make (A &&...a) {
+            return pointer<X>::make (std::forward<A> (a)...);
+        }
+    };
+
+    using concurrent = pooled<true>;
+    using local = pooled<false>;
+
+}
+
+#endif
@@ -6,34 +6,121 @@
 #define DATA_RATE_LIMITER_H
 
 #include <data/types.hpp>
-#include "circular_queue.hpp"
+#include <data/async.hpp>
+#include <data/map.hpp>
+#include <data/tools/synchronized.hpp>
+#include <atomic>
 #include <chrono>
-#include <mutex>
 
 namespace data {
 
     using millisecond = std::chrono::milliseconds;
 
-    // Do you have an operation that cannot be repeated too quicky? 
-    // for example, a free API that is rate-limited? Use this to 
-    // limit your requests to the required time interval. 
+    // Do you have an operation that cannot be repeated too quicky?
+    // for example, a free API that is rate-limited? Use this to
+    // limit your requests to the required time interval.
+    //
+    // This is the generic cell rate algorithm, which is equivalent to a
+    // token bucket that holds 'hits' tokens and refills one every
+    // duration / hits. The only state is the time at which the bucket would
+    // be full again, which is updated with compare-and-swap, so there is no
+    // lock and the memory used does not depend on the rate.
+    //
+    // Every call reserves its place in line, so callers are served in the
+    // order in which they asked even if they have to wait. Copies of a
+    // rate_limiter share the same state.
     struct rate_limiter {
-        // the rate limiter will not allow more actions than 'hits' per 'duration'. 
+        using clock = std::chrono::steady_clock;
+
+        // the rate limiter will not allow more actions than 'hits' per 'duration'.
+        rate_limiter (size_t hits, millisecond duration);
+
+        // use this to make an unlimited rate limiter that does nothing.
+        rate_limiter () : State {} {};
+
+        // take n actions, returning how long we need to wait before we
+        // can take them. The actions are counted against the limit whether
+        // or not we wait.
+        std::chrono::nanoseconds reserve (uint64 n = 1);
 
-        rate_limiter (size_t hits, millisecond duration) :
-            m_queue (hits), m_duration (duration), mutex {std::make_shared<std::mutex> ()} {};
-        
         // how much time we need to wait until an action can be taken?
+        // The action is counted as if it were taken.
         millisecond get_time ();
-        
-        // use this to make an unlimited rate limiter that does nothing. 
-        rate_limiter () : m_queue (0), m_duration (0), mutex {} {};
-    
+
+        // take n actions if that can be done immediately.
+        bool try_acquire (uint64 n = 1);
+
+        // wait until n actions can be taken.
+        awaitable<void> acquire (uint64 n = 1);
+
+        bool unlimited () const {
+            return State == nullptr;
+        }
+
     private:
-        tools::circular_queue<millisecond> m_queue;
-        millisecond m_duration;
-        ptr<std::mutex> mutex;
+        struct state {
+            // the time, in nanoseconds since the epoch of clock, at which
+            // every action that has been reserved will have been paid back.
+            std::atomic<int64> Full;
+            // the time it takes to get back one action.
+            int64 Interval;
+            // the time it takes for the bucket to go from empty to full.
+            int64 Duration;
+        };
+
+        ptr<state> State;
+
+        static int64 now ();
     };
+
+    // Separate rate limits for different keys, such as one for each host,
+    // with the same limit for each key.
+    template <std::totally_ordered key> struct rate_limiters {
+
+        rate_limiters (size_t hits, millisecond duration) : Hits {hits}, Duration {duration}, Limiters {} {}
+
+        // the limiter for a given key, which is created if it does not exist.
+        rate_limiter operator [] (const key &k);
+
+        awaitable<void> acquire (const key &k, uint64 n = 1) {
+            return (*this)[k].acquire (n);
+        }
+
+        bool try_acquire (const key &k, uint64 n = 1) {
+            return (*this)[k].try_acquire (n);
+        }
+
+        size_t size () const {
+            return Limiters ([] (const map<key, rate_limiter> &m) {
+                return m.size ();
+            });
+        }
+
+    private:
+        size_t Hits;
+        millisecond Duration;
+        // keys are added rarely and looked up on every call.
+        synchronized<map<key, rate_limiter>, synchronization::read_mostly> Limiters;
+    };
+
+    template <std::totally_ordered key>
+    rate_limiter rate_limiters<key>::operator [] (const key &k) {
+        const auto &limiters = Limiters;
+        auto found = limiters ([&k] (const map<key, rate_limiter> &m) -> maybe<rate_limiter> {
+            if (const rate_limiter *r = m.contains (k); r != nullptr) return *r;
+            return {};
+        });
+
+        if (bool (found)) return *found;
+
+        rate_limiter fresh {Hits, Duration};
+        // if another thread inserted the same key first, we use its limiter.
+        return Limiters ([&k, &fresh] (map<key, rate_limiter> &m) -> rate_limiter {
+            if (const rate_limiter *r = m.contains (k); r != nullptr) return *r;
+            m = m.insert (k, fresh);
+            return fresh;
+        });
+    }
 }
 
 #endif //DATA_RATE_LIMITER_H
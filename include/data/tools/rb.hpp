@@ -5,6 +5,9 @@
 #ifndef DATA_TOOLS_RB
 #define DATA_TOOLS_RB
 
+#include <bit>
+#include <future>
+
 #include <data/tools/ordered_list.hpp>
 #include <data/stack.hpp>
 #include <data/tools/linked_tree.hpp>
@@ -66,12 +69,14 @@ namespace data::RB {
         return data::root (t).Value;
     }
 
+    template <Sortable V, functional::buildable_tree<colored<V>> T> bool is_red (T t);
+
     // an RB tree is balanced if no red node has a red child and if the sum
     // of all black nodes from all leaves to the root is the same.
     template <Sortable V, functional::buildable_tree<colored<V>> T> bool balanced (T t);
 
     template <Sortable V, functional::buildable_tree<colored<V>> T> bool inline valid (T t) {
-        return data::valid (t) && balanced (t);
+        return data::valid (t) && balanced<V> (t);
     }
 
     template <Sortable V, functional::buildable_tree<colored<V>> T> T balance (T t);
@@ -83,6 +88,20 @@ namespace data::RB {
     template <Sortable V, functional::buildable_tree<colored<V>> T> T remove (T t, const V &v);
     template <Sortable V, functional::buildable_tree<colored<V>> T> T erase (T t, const V &v);
 
+    // remove the element x for which cmp (x) == 0. cmp must agree with the ordering of
+    // the tree: it returns a negative number if the element to be removed comes before x
+    // and a positive number if it comes after. This lets a map remove an entry by its key.
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename compare>
+    requires requires (compare cmp, const V &x) {
+        { cmp (x) } -> ImplicitlyConvertible<int>;
+    } T remove_by (T t, compare cmp);
+
+    // build a balanced tree in O(n) from size elements in increasing order, starting from i.
+    // after each element is read, next (i, v) is called to advance i past it, which
+    // allows duplicates to be skipped. Every element gets exactly one node.
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename I, typename step>
+    T build_sorted (I &i, step &&next, size_t size);
+
     // TODO: accept any v that is equality comparable with V.
     template <Sortable V, functional::buildable_tree<colored<V>> T> const unref<V> *contains (const T t, inserted<V> v);
     
@@ -97,15 +116,51 @@ namespace data::RB {
     template <typename V, typename T, typename E> tree<V, T> remove (const tree<V, T> &, const E &);
     template <typename V, typename T, typename E> tree<V, T> erase (const tree<V, T> &, const E &);
 
+    // Set operations are implemented with split and join and take
+    // O(m log (n / m + 1)) for trees of sizes m <= n. The two halves of
+    // each step are independent, so they may be run on separate threads.
+    // Once the two trees together have more than Cutoff elements, the
+    // work is forked until Threads threads are in use. Threads = 1 runs
+    // everything on the calling thread. Do not use this with pool::local.
+    struct parallel {
+        uint32 Threads {1};
+        size_t Cutoff {1 << 14};
+    };
+
+    // if an element is in both trees, f (a, b) is what goes in the result.
     template <typename V, typename T, typename already_exists>
     requires requires (already_exists f, const V &old_v, const V &new_v) {
         { f (old_v, new_v) } -> ImplicitlyConvertible<V>;
-    } tree<V, T> merge (const tree<V, T> &, const tree<V, T> &, already_exists f);
+    } tree<V, T> merge (const tree<V, T> &, const tree<V, T> &, already_exists f, parallel = {});
 
     template <typename V, typename T, typename already_exists>
     requires requires (already_exists f, const V &old_v, const V &new_v) {
         { f (old_v, new_v) } -> ImplicitlyConvertible<V>;
-    } tree<V, T> intersect (const tree<V, T> &, const tree<V, T> &, already_exists f);
+    } tree<V, T> intersect (const tree<V, T> &, const tree<V, T> &, already_exists f, parallel = {});
+
+    // elements of the first tree that are not in the second.
+    template <typename V, typename T> tree<V, T> difference (const tree<V, T> &, const tree<V, T> &, parallel = {});
+
+    // elements that are in one tree but not both.
+    template <typename V, typename T> tree<V, T> symmetric_difference (const tree<V, T> &, const tree<V, T> &, parallel = {});
+
+    // join two trees and an element v such that all elements of l are less than
+    // v and all elements of r are greater. Takes time proportional to the
+    // difference in height of l and r.
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T join (T l, inserted<V> v, T r);
+
+    // join two trees such that all elements of l are less than all elements of r.
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T join (T l, T r);
+
+    // the elements of a tree that are less than and greater than v, and a pointer to
+    // the element equivalent to v, if there is one, which points into the original tree.
+    template <Sortable V, functional::buildable_tree<colored<V>> T> struct split_tree {
+        T Left;
+        const unref<V> *Found;
+        T Right;
+    };
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T> split_tree<V, T> split (T t, const V &v);
 
     template <Sortable V, functional::buildable_tree<colored<V>> T> struct tree;
 
@@ -120,6 +175,26 @@ namespace data::RB {
 
         tree (std::initializer_list<wrapped<V>> x);
 
+        // construct a tree in O(n) from values given in increasing order.
+        // from_sorted accepts repeated values and keeps the first of each
+        // and throws if the input is out of order. from_sorted_unique
+        // requires strictly increasing input and does not check it.
+        template <std::forward_iterator I, std::sentinel_for<I> S>
+        static tree from_sorted (I b, S e);
+
+        template <std::forward_iterator I, std::sentinel_for<I> S>
+        static tree from_sorted_unique (I b, S e);
+
+        template <std::ranges::forward_range R>
+        static tree from_sorted (const R &r) {
+            return from_sorted (std::ranges::begin (r), std::ranges::end (r));
+        }
+
+        template <std::ranges::forward_range R>
+        static tree from_sorted_unique (const R &r) {
+            return from_sorted_unique (std::ranges::begin (r), std::ranges::end (r));
+        }
+
         const V &root () const;
 
         tree left () const;
@@ -145,25 +220,35 @@ namespace data::RB {
         ordered_sequence<const V &> values () const;
 
         tree remove (const V &v) const {
-            tree t;
-            for (const auto &x : *this) if (x != v) t = t.insert (x);
-            return t;
+            return RB::remove<V, T> (static_cast<const T &> (*this), v);
+        }
+
+        template <typename compare> requires requires (compare cmp, const V &x) {
+            { cmp (x) } -> ImplicitlyConvertible<int>;
+        } tree remove_by (compare cmp) const {
+            return RB::remove_by<V, T> (static_cast<const T &> (*this), cmp);
         }
 
         template <typename X, typename U> requires ImplicitlyConvertible<V, X>
         operator tree<X, U> () const {
-            tree<X, U> u {};
-            for (const V &v : *this) u = u.insert (X (v));
-            return u;
+            typename tree<X, U>::transient u {};
+            for (const V &v : *this) u.insert (X (v));
+            return u.freeze ();
         }
 
         template <typename X, typename U> requires ExplicitlyConvertible<V, X>
         explicit operator tree<X, U> () const {
-            tree<X, U> u {};
-            for (const V &v : *this) u = u.insert (X (v));
-            return u;
+            typename tree<X, U>::transient u {};
+            for (const V &v : *this) u.insert (X (v));
+            return u.freeze ();
         }
 
+        // a mutable builder for inserting many elements. Nodes that the builder
+        // shares with other trees are copied the first time they are touched and
+        // nodes that belong only to the builder are modified in place, so a node
+        // is allocated only once per element. freeze takes O(1).
+        struct transient;
+
         struct iterator : binary_search_tree<colored<V>, T>::const_iterator {
             using parent = binary_search_tree<colored<V>, T>::const_iterator;
             
@@ -202,6 +287,55 @@ namespace data::RB {
 
     };
 
+    // insert into a tree whose nodes can be modified (see linked_tree::unique)
+    // and return whether a new node was added. Used by transient.
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename already_equivalent>
+    bool insert_in_place (T &t, inserted<V> v, already_equivalent &f);
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T>
+    struct tree<V, T>::transient {
+        transient (): Tree {} {}
+        transient (tree t): Tree {static_cast<T &&> (t)} {}
+
+        size_t size () const {
+            return data::size (Tree);
+        }
+
+        bool empty () const {
+            return data::empty (Tree);
+        }
+
+        const unref<V> *contains (inserted<V> x) const {
+            return RB::contains<V, T> (Tree, x);
+        }
+
+        transient &insert (inserted<V> v) {
+            return insert (v, &functional::keep_old<V>);
+        }
+
+        template <typename already_equivalent> requires requires (already_equivalent f, const V &old_v, const V &new_v) {
+            { f (old_v, new_v) } -> ImplicitlyConvertible<V>;
+        } transient &insert (inserted<V> v, already_equivalent f) {
+            if constexpr (requires (T &t) {
+                t.unique ();
+                t.resize ();
+            }) {
+                RB::insert_in_place<V, T> (Tree, v, f);
+                if (is_red<V> (Tree)) Tree.unique ().Value.Color = color::black;
+            } else Tree = RB::insert<V, T> (Tree, v, f);
+            return *this;
+        }
+
+        tree freeze () {
+            T t = std::move (Tree);
+            Tree = T {};
+            return tree {t};
+        }
+
+    private:
+        T Tree;
+    };
+
     template <typename V, typename T>
     std::ostream inline &operator << (std::ostream &o, const tree<V, T> &t) {
         o << "{";
@@ -251,81 +385,104 @@ namespace data::RB {
         });
     }
 
-    template <typename V, typename T> tree<V, T> operator ^ (const tree<V, T> &a, const tree<V, T> &b) {
-        auto i = a.begin ();
-        auto j = b.begin ();
-        tree<V, T> result;
-        while (true) {
-            if (i == a.end ()) {
-                while (j != b.end ()) {
-                    result = result.insert (*j);
-                    j++;
-                }
-                break;
-            }
+    template <typename V, typename T> tree<V, T> inline operator ^ (const tree<V, T> &a, const tree<V, T> &b) {
+        return symmetric_difference (a, b);
+    }
 
-            if (j == b.end ()) {
-                while (i != a.end ()) {
-                    result = result.insert (*i);
-                    i++;
-                }
-                break;
-            }
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T make_black (T t);
 
-            if (*i < *j) {
-                result = result.insert (*i);
-                i++;
-            } else if (*j < *i) {
-                result = result.insert (*j);
-                j++;
-            } else {
-                i++;
-                j++;
-            }
+    // run l and r, which each take a parallel argument, possibly on separate threads.
+    template <typename X, typename left, typename right>
+    std::pair<X, X> fork_join (parallel p, size_t size, left l, right r) {
+        if (p.Threads < 2 || size <= p.Cutoff) {
+            X x = l (p);
+            return {std::move (x), r (p)};
         }
 
-        return result;
+        uint32 half = p.Threads / 2;
+        auto x = std::async (std::launch::async, l, parallel {half, p.Cutoff});
+        X y = r (parallel {p.Threads - half, p.Cutoff});
+        return {x.get (), std::move (y)};
     }
 
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename already_exists>
+    T merge (const T &a, const T &b, already_exists &f, parallel p) {
+        if (data::empty (a)) return b;
+        if (data::empty (b)) return a;
 
-    template <typename V, typename T, typename already_exists>
-    requires requires (already_exists f, const V &old_v, const V &new_v) {
-        { f (old_v, new_v) } -> ImplicitlyConvertible<V>;
-    } tree<V, T> intersect (const tree<V, T> &a, const tree<V, T> &b, already_exists f) {
-        auto i = a.begin ();
-        auto j = b.begin ();
-        tree<V, T> result;
-        while (true) {
-            if (i == a.end ()) {
-                break;
-            }
+        const auto &k = root<V> (a);
+        split_tree<V, T> s = split<V, T> (b, k);
+        auto [l, r] = fork_join<T> (p, data::size (a) + data::size (b),
+            [&] (parallel q) { return merge<V, T> (left (a), s.Left, f, q); },
+            [&] (parallel q) { return merge<V, T> (right (a), s.Right, f, q); });
 
-            if (j == b.end ()) {
-                break;
-            }
+        if (s.Found == nullptr) return join<V, T> (l, k, r);
+        return join<V, T> (l, V (f (k, *s.Found)), r);
+    }
 
-            if (*i < *j) {
-                i++;
-            } else if (*j < *i) {
-                j++;
-            } else {
-                result = result.insert (f (*i, *j));
-                i++;
-                j++;
-            }
-        }
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename already_exists>
+    T intersect (const T &a, const T &b, already_exists &f, parallel p) {
+        if (data::empty (a) || data::empty (b)) return T {};
 
-        return result;
+        const auto &k = root<V> (a);
+        split_tree<V, T> s = split<V, T> (b, k);
+        auto [l, r] = fork_join<T> (p, data::size (a) + data::size (b),
+            [&] (parallel q) { return intersect<V, T> (left (a), s.Left, f, q); },
+            [&] (parallel q) { return intersect<V, T> (right (a), s.Right, f, q); });
+
+        if (s.Found == nullptr) return join<V, T> (l, r);
+        return join<V, T> (l, V (f (k, *s.Found)), r);
     }
 
-    template <typename V, typename T, typename already_exists> 
+    template <Sortable V, functional::buildable_tree<colored<V>> T>
+    T difference (const T &a, const T &b, parallel p) {
+        if (data::empty (a)) return T {};
+        if (data::empty (b)) return a;
+
+        // split a rather than b because we need to remove the root of b from it.
+        split_tree<V, T> s = split<V, T> (a, root<V> (b));
+        auto [l, r] = fork_join<T> (p, data::size (a) + data::size (b),
+            [&] (parallel q) { return difference<V, T> (s.Left, left (b), q); },
+            [&] (parallel q) { return difference<V, T> (s.Right, right (b), q); });
+
+        return join<V, T> (l, r);
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T>
+    T symmetric_difference (const T &a, const T &b, parallel p) {
+        if (data::empty (a)) return b;
+        if (data::empty (b)) return a;
+
+        const auto &k = root<V> (a);
+        split_tree<V, T> s = split<V, T> (b, k);
+        auto [l, r] = fork_join<T> (p, data::size (a) + data::size (b),
+            [&] (parallel q) { return symmetric_difference<V, T> (left (a), s.Left, q); },
+            [&] (parallel q) { return symmetric_difference<V, T> (right (a), s.Right, q); });
+
+        if (s.Found == nullptr) return join<V, T> (l, k, r);
+        return join<V, T> (l, r);
+    }
+
+    template <typename V, typename T, typename already_exists>
     requires requires (already_exists f, const V &old_v, const V &new_v) {
         { f (old_v, new_v) } -> ImplicitlyConvertible<V>;
-    } tree<V, T> merge (const tree<V, T> &a, const tree<V, T> &b, already_exists f) {
-        // note: a faster version of this function is possible. 
-        auto n = a;
-        for (const auto &v : b) n = n.insert (v, f);
-        return n;
+    } tree<V, T> inline merge (const tree<V, T> &a, const tree<V, T> &b, already_exists f, parallel p) {
+        return make_black<V, T> (merge<V, T> (static_cast<const T &> (a), static_cast<const T &> (b), f, p));
+    }
+
+    template <typename V, typename T, typename already_exists>
+    requires requires (already_exists f, const V &old_v, const V &new_v) {
+        { f (old_v, new_v) } -> ImplicitlyConvertible<V>;
+    } tree<V, T> inline intersect (const tree<V, T> &a, const tree<V, T> &b, already_exists f, parallel p) {
+        return make_black<V, T> (intersect<V, T> (static_cast<const T &> (a), static_cast<const T &> (b), f, p));
+    }
+
+    template <typename V, typename T> tree<V, T> inline difference (const tree<V, T> &a, const tree<V, T> &b, parallel p) {
+        return make_black<V, T> (difference<V, T> (static_cast<const T &> (a), static_cast<const T &> (b), p));
+    }
+
+    template <typename V, typename T> tree<V, T> inline symmetric_difference (const tree<V, T> &a, const tree<V, T> &b, parallel p) {
+        return make_black<V, T> (symmetric_difference<V, T> (static_cast<const T &> (a), static_cast<const T &> (b), p));
     }
 
     // now let's talk about how to check whether a tree is balanced.
@@ -360,19 +517,30 @@ namespace data::RB {
 
     template <Sortable V, functional::buildable_tree<colored<V>> T> T balance (inserted<V> v, T l, T r);
 
-    // if the tree is balanced when this method is used on
-    // it, it will be balanced when the method is done.
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T inline make_black (T t) {
+        return data::empty (t) || root_color<V> (t) == color::black ? t :
+            T {colored<V> {color::black, root<V> (t)}, left (t), right (t)};
+    }
+
+    // insert without coloring the root black. The result may have a red root with a red child.
     template <Sortable V, functional::buildable_tree<colored<V>> T, typename already_equivalent>
-    T inline insert (const T t, inserted<V> v, already_equivalent f) {
+    T insert_red (const T t, inserted<V> v, already_equivalent f) {
         return data::empty (t) ? T {colored<V> {color::red, v}, T {}, T {}}:
             v <=> root<V> (t) == 0 ? T {colored<V> {root_color<V> (t), f (root<V> (t), v)}, left (t), right (t)}:
                 root_color<V> (t) != color::red ?
                     (v < root<V> (t) ?
-                        balance<V, T> (root<V> (t), insert<V, T> (left (t), v, f), right (t)):
-                        balance<V, T> (root<V> (t), left (t), insert<V, T> (right (t), v, f))):
+                        balance<V, T> (root<V> (t), insert_red<V, T> (left (t), v, f), right (t)):
+                        balance<V, T> (root<V> (t), left (t), insert_red<V, T> (right (t), v, f))):
                     (v < root<V> (t) ?
-                        T {data::root (t), insert<V, T> (left (t), v, f), right (t)}:
-                        T {data::root (t), left (t), insert<V, T> (right (t), v, f)});
+                        T {data::root (t), insert_red<V, T> (left (t), v, f), right (t)}:
+                        T {data::root (t), left (t), insert_red<V, T> (right (t), v, f)});
+    }
+
+    // if the tree is balanced when this method is used on
+    // it, it will be balanced when the method is done.
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename already_equivalent>
+    T inline insert (const T t, inserted<V> v, already_equivalent f) {
+        return make_black<V, T> (insert_red<V, T> (t, v, f));
     }
 
     // now let's talk about how to balance an RB tree.
@@ -387,7 +555,7 @@ namespace data::RB {
     }
 
     template <Sortable V, functional::buildable_tree<colored<V>> T> T inline blacken (T t) {
-        return data::empty (t) ? T {} : T {colored<V> {color::red, root<V> (t)}, left (t), right (t)};
+        return data::empty (t) ? T {} : T {colored<V> {color::black, root<V> (t)}, left (t), right (t)};
     }
 
     template <Sortable V, functional::buildable_tree<colored<V>> T> T balance (inserted<V> v, T l, T r) {
@@ -403,7 +571,7 @@ namespace data::RB {
 
         if (doubled_left<V> (r))
             return T {colored<V> {color::red, root<V> (left (r))},
-                T {colored<V> {color::black, v}, left (l), left (left (r))},
+                T {colored<V> {color::black, v}, l, left (left (r))},
                 T {colored<V> {color::black, root<V> (r)}, right (left (r)), right (r)}};
 
         if (doubled_right<V> (r))
@@ -414,6 +582,131 @@ namespace data::RB {
         return T (colored<V> {color::black, v}, l, r);
     }
 
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename I, typename step>
+    T build_sorted (I &i, step &next, size_t size, size_t depth, size_t black_depth) {
+        if (size == 0) return T {};
+        size_t left_size = (size - 1) / 2;
+        T l = build_sorted<V, T> (i, next, left_size, depth + 1, black_depth);
+        colored<V> v {depth > black_depth ? color::red : color::black, *i};
+        next (i, v.Value);
+        T r = build_sorted<V, T> (i, next, size - 1 - left_size, depth + 1, black_depth);
+        return T {std::move (v), std::move (l), std::move (r)};
+    }
+
+    // The left and right subtrees differ in size by at most one, so every empty
+    // subtree sits at one of two adjacent depths. The levels that are full are
+    // colored black and the incomplete level at the bottom, if any, is red.
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename I, typename step>
+    T inline build_sorted (I &i, step &&next, size_t size) {
+        return build_sorted<V, T> (i, next, size, 1, std::bit_width (size + 1) - 1);
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T>
+    template <std::forward_iterator I, std::sentinel_for<I> S>
+    tree<V, T> tree<V, T>::from_sorted_unique (I b, S e) {
+        size_t size = static_cast<size_t> (std::ranges::distance (b, e));
+        return tree {build_sorted<V, T> (b, [] (I &i, const V &) {
+            ++i;
+        }, size)};
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T>
+    template <std::forward_iterator I, std::sentinel_for<I> S>
+    tree<V, T> tree<V, T>::from_sorted (I b, S e) {
+        if (b == e) return tree {};
+
+        // count distinct values and make sure that they are in order.
+        size_t size = 1;
+        for (I last = b, i = std::next (b); i != e; last = i++)
+            if (*last < *i) size++;
+            else if (*i < *last) throw exception {} << "RB::tree::from_sorted: input is not sorted";
+
+        return tree {build_sorted<V, T> (b, [&e] (I &i, const V &v) {
+            do ++i; while (i != e && !(v < *i));
+        }, size)};
+    }
+
+    // Okasaki's balance, except that nodes are relinked rather than rebuilt.
+    // The nodes involved are all on the path of the insertion, so they
+    // have already been made unique.
+    template <Sortable V, functional::buildable_tree<colored<V>> T> void balance_in_place (T &t) {
+        auto red = [] (const T &x) -> bool {
+            return x.Node != nullptr && x.Node->Value.Color == color::red;
+        };
+
+        auto &z = *t.Node;
+        if (z.Value.Color != color::black) return;
+
+        if (red (z.Left) && red (z.Left.Node->Left)) {
+            T y = std::move (z.Left);
+            auto &yn = *y.Node;
+            z.Left = std::move (yn.Right);
+            t.resize ();
+            yn.Right = std::move (t);
+            yn.Left.Node->Value.Color = color::black;
+            y.resize ();
+            t = std::move (y);
+        } else if (red (z.Left) && red (z.Left.Node->Right)) {
+            T y = std::move (z.Left);
+            auto &yn = *y.Node;
+            T x = std::move (yn.Right);
+            auto &xn = *x.Node;
+            yn.Right = std::move (xn.Left);
+            z.Left = std::move (xn.Right);
+            yn.Value.Color = color::black;
+            y.resize ();
+            t.resize ();
+            xn.Left = std::move (y);
+            xn.Right = std::move (t);
+            x.resize ();
+            t = std::move (x);
+        } else if (red (z.Right) && red (z.Right.Node->Left)) {
+            T y = std::move (z.Right);
+            auto &yn = *y.Node;
+            T x = std::move (yn.Left);
+            auto &xn = *x.Node;
+            yn.Left = std::move (xn.Right);
+            z.Right = std::move (xn.Left);
+            yn.Value.Color = color::black;
+            y.resize ();
+            t.resize ();
+            xn.Left = std::move (t);
+            xn.Right = std::move (y);
+            x.resize ();
+            t = std::move (x);
+        } else if (red (z.Right) && red (z.Right.Node->Right)) {
+            T y = std::move (z.Right);
+            auto &yn = *y.Node;
+            z.Right = std::move (yn.Left);
+            t.resize ();
+            yn.Left = std::move (t);
+            yn.Right.Node->Value.Color = color::black;
+            y.resize ();
+            t = std::move (y);
+        }
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename already_equivalent>
+    bool insert_in_place (T &t, inserted<V> v, already_equivalent &f) {
+        if (data::empty (t)) {
+            t = T {colored<V> {color::red, v}, T {}, T {}};
+            return true;
+        }
+
+        auto &n = t.unique ();
+        const auto &k = n.Value.Value;
+        if (!(v < k) && !(k < v)) {
+            // V may not be assignable, so the node is replaced.
+            t = T {colored<V> {n.Value.Color, f (k, v)}, std::move (n.Left), std::move (n.Right)};
+            return false;
+        }
+
+        if (!insert_in_place<V, T> (v < k ? n.Left : n.Right, v, f)) return false;
+        t.resize ();
+        balance_in_place<V, T> (t);
+        return true;
+    }
+
     template <Sortable V, functional::buildable_tree<colored<V>> T>
     const unref<V> *contains (const T t, inserted<V> x) {
         if (data::empty (t)) return nullptr;
@@ -423,8 +716,223 @@ namespace data::RB {
         contains<V, T> (data::right (t), x);
     }
 
-    // finally, how to remove an RB tree.
+    // join and split follow Blelloch, Ferizovic and Sun, "Just Join for Parallel Ordered Sets" (2016).
+
+    // the number of black nodes on any path from the root to a leaf.
+    template <Sortable V, functional::buildable_tree<colored<V>> T> size_t black_height (T t) {
+        size_t h = 0;
+        for (; !data::empty (t); t = left (t)) if (root_color<V> (t) == color::black) h++;
+        return h;
+    }
+
+    // l is at least as tall as r. The result is valid except
+    // that it may have a red root with a red right child.
+    template <Sortable V, functional::buildable_tree<colored<V>> T>
+    T join_right (T l, size_t hl, inserted<V> v, T r, size_t hr) {
+        if (!is_red<V> (l) && hl == hr) return T {colored<V> {color::red, v}, l, r};
+        T x = join_right<V, T> (right (l), is_black<V> (l) ? hl - 1 : hl, v, r, hr);
+        if (is_black<V> (l) && is_red<V> (x) && is_red<V> (right (x)))
+            return T {colored<V> {color::red, root<V> (x)},
+                T {colored<V> {color::black, root<V> (l)}, left (l), left (x)},
+                blacken<V> (right (x))};
+        return T {data::root (l), left (l), x};
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T>
+    T join_left (T l, size_t hl, inserted<V> v, T r, size_t hr) {
+        if (!is_red<V> (r) && hl == hr) return T {colored<V> {color::red, v}, l, r};
+        T x = join_left<V, T> (l, hl, v, left (r), is_black<V> (r) ? hr - 1 : hr);
+        if (is_black<V> (r) && is_red<V> (x) && is_red<V> (left (x)))
+            return T {colored<V> {color::red, root<V> (x)},
+                blacken<V> (left (x)),
+                T {colored<V> {color::black, root<V> (r)}, right (x), right (r)}};
+        return T {data::root (r), x, right (r)};
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T join (T l, inserted<V> v, T r) {
+        size_t hl = black_height<V> (l);
+        size_t hr = black_height<V> (r);
+
+        if (hl > hr) {
+            T x = join_right<V, T> (l, hl, v, r, hr);
+            return is_red<V> (x) && is_red<V> (right (x)) ? blacken<V> (x) : x;
+        }
+
+        if (hr > hl) {
+            T x = join_left<V, T> (l, hl, v, r, hr);
+            return is_red<V> (x) && is_red<V> (left (x)) ? blacken<V> (x) : x;
+        }
+
+        return T {colored<V> {is_red<V> (l) || is_red<V> (r) ? color::black : color::red, v}, l, r};
+    }
+
+    // remove the greatest element of a non-empty tree.
+    template <Sortable V, functional::buildable_tree<colored<V>> T>
+    std::pair<T, const unref<V> *> split_last (T t) {
+        if (data::empty (right (t))) return {left (t), &root<V> (t)};
+        auto [l, v] = split_last<V, T> (right (t));
+        return {join<V, T> (left (t), root<V> (t), l), v};
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T join (T l, T r) {
+        if (data::empty (l)) return r;
+        if (data::empty (r)) return l;
+        auto [x, v] = split_last<V, T> (l);
+        return join<V, T> (x, *v, r);
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T> split_tree<V, T> split (T t, const V &v) {
+        if (data::empty (t)) return {T {}, nullptr, T {}};
+        const auto &k = root<V> (t);
+
+        if (v < k) {
+            split_tree<V, T> s = split<V, T> (left (t), v);
+            return {s.Left, s.Found, join<V, T> (s.Right, k, right (t))};
+        }
+
+        if (k < v) {
+            split_tree<V, T> s = split<V, T> (right (t), v);
+            return {join<V, T> (left (t), k, s.Left), s.Found, s.Right};
+        }
+
+        return {left (t), &k, right (t)};
+    }
+
+    // finally, how to remove from an RB tree.
     // See matt.might.net/articles/red-black-delete/
+    // Might's algorithm needs double-black leaves, which we cannot represent
+    // with an empty tree, so we use the equivalent algorithm from Kahrs,
+    // "Red-black trees with types" (2001), which only needs red and black.
+    // Only the path to the removed element is copied; everything else is shared.
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T> bool inline is_red (T t) {
+        return !data::empty (t) && root_color<V> (t) == color::red;
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T> bool inline is_black (T t) {
+        return !data::empty (t) && root_color<V> (t) == color::black;
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T inline redden (T t) {
+        return T {colored<V> {color::red, root<V> (t)}, left (t), right (t)};
+    }
+
+    // like balance, except that both children may be red.
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T rebalance (T l, inserted<V> v, T r) {
+        if (is_red<V> (l) && is_red<V> (r))
+            return T {colored<V> {color::red, v}, blacken<V> (l), blacken<V> (r)};
+
+        if (is_red<V> (l) && is_red<V> (left (l)))
+            return T {colored<V> {color::red, root<V> (l)},
+                blacken<V> (left (l)),
+                T {colored<V> {color::black, v}, right (l), r}};
+
+        if (is_red<V> (l) && is_red<V> (right (l)))
+            return T {colored<V> {color::red, root<V> (right (l))},
+                T {colored<V> {color::black, root<V> (l)}, left (l), left (right (l))},
+                T {colored<V> {color::black, v}, right (right (l)), r}};
+
+        if (is_red<V> (r) && is_red<V> (right (r)))
+            return T {colored<V> {color::red, root<V> (r)},
+                T {colored<V> {color::black, v}, l, left (r)},
+                blacken<V> (right (r))};
+
+        if (is_red<V> (r) && is_red<V> (left (r)))
+            return T {colored<V> {color::red, root<V> (left (r))},
+                T {colored<V> {color::black, v}, l, left (left (r))},
+                T {colored<V> {color::black, root<V> (r)}, right (left (r)), right (r)}};
+
+        return T {colored<V> {color::black, v}, l, r};
+    }
+
+    // l is one black level shorter than r.
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T balance_left (T l, inserted<V> v, T r) {
+        if (is_red<V> (l)) return T {colored<V> {color::red, v}, blacken<V> (l), r};
+        if (is_black<V> (r)) return rebalance<V, T> (l, v, redden<V> (r));
+        // r is red with a black left child.
+        return T {colored<V> {color::red, root<V> (left (r))},
+            T {colored<V> {color::black, v}, l, left (left (r))},
+            rebalance<V, T> (right (left (r)), root<V> (r), redden<V> (right (r)))};
+    }
+
+    // r is one black level shorter than l.
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T balance_right (T l, inserted<V> v, T r) {
+        if (is_red<V> (r)) return T {colored<V> {color::red, v}, l, blacken<V> (r)};
+        if (is_black<V> (l)) return rebalance<V, T> (redden<V> (l), v, r);
+        // l is red with a black right child.
+        return T {colored<V> {color::red, root<V> (right (l))},
+            rebalance<V, T> (redden<V> (left (l)), root<V> (l), left (right (l))),
+            T {colored<V> {color::black, v}, right (right (l)), r}};
+    }
+
+    // join two trees in which every element of l is less than every element of r
+    // and which have the same black height.
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T append (T l, T r) {
+        if (data::empty (l)) return r;
+        if (data::empty (r)) return l;
+
+        if (is_red<V> (l) && is_red<V> (r)) {
+            T m = append<V, T> (right (l), left (r));
+            return is_red<V> (m) ?
+                T {colored<V> {color::red, root<V> (m)},
+                    T {colored<V> {color::red, root<V> (l)}, left (l), left (m)},
+                    T {colored<V> {color::red, root<V> (r)}, right (m), right (r)}}:
+                T {colored<V> {color::red, root<V> (l)}, left (l),
+                    T {colored<V> {color::red, root<V> (r)}, m, right (r)}};
+        }
+
+        if (is_black<V> (l) && is_black<V> (r)) {
+            T m = append<V, T> (right (l), left (r));
+            return is_red<V> (m) ?
+                T {colored<V> {color::red, root<V> (m)},
+                    T {colored<V> {color::black, root<V> (l)}, left (l), left (m)},
+                    T {colored<V> {color::black, root<V> (r)}, right (m), right (r)}}:
+                balance_left<V, T> (left (l), root<V> (l), T {colored<V> {color::black, root<V> (r)}, m, right (r)});
+        }
+
+        if (is_red<V> (r)) return T {colored<V> {color::red, root<V> (r)}, append<V, T> (l, left (r)), right (r)};
+        return T {colored<V> {color::red, root<V> (l)}, left (l), append<V, T> (right (l), r)};
+    }
+
+    // remove without coloring the root black.
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename compare>
+    T remove_red (T t, compare &cmp) {
+        if (data::empty (t)) return t;
+        int c = cmp (root<V> (t));
+        if (c < 0) return is_black<V> (left (t)) ?
+            balance_left<V, T> (remove_red<V, T> (left (t), cmp), root<V> (t), right (t)):
+            T {colored<V> {color::red, root<V> (t)}, remove_red<V, T> (left (t), cmp), right (t)};
+        if (c > 0) return is_black<V> (right (t)) ?
+            balance_right<V, T> (left (t), root<V> (t), remove_red<V, T> (right (t), cmp)):
+            T {colored<V> {color::red, root<V> (t)}, left (t), remove_red<V, T> (right (t), cmp)};
+        return append<V, T> (left (t), right (t));
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T, typename compare>
+    requires requires (compare cmp, const V &x) {
+        { cmp (x) } -> ImplicitlyConvertible<int>;
+    } T remove_by (T t, compare cmp) {
+        // if the element is not present, return the same tree.
+        T n = t;
+        while (true) {
+            if (data::empty (n)) return t;
+            int c = cmp (root<V> (n));
+            if (c == 0) break;
+            n = c < 0 ? left (n) : right (n);
+        }
+
+        return make_black<V, T> (remove_red<V, T> (t, cmp));
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T inline remove (T t, const V &v) {
+        return remove_by<V, T> (t, [&v] (const V &x) -> int {
+            return v < x ? -1 : x < v ? 1 : 0;
+        });
+    }
+
+    template <Sortable V, functional::buildable_tree<colored<V>> T> T inline erase (T t, const V &v) {
+        return remove<V, T> (t, v);
+    }
 
     // member functions of the tree
 
@@ -436,7 +944,9 @@ namespace data::RB {
 
     template <Sortable V, functional::buildable_tree<colored<V>> T>
     inline tree<V, T>::tree (std::initializer_list<wrapped<V>> x) {
-        for (auto &v : x) *this = insert (v);
+        transient t {};
+        for (auto &v : x) t.insert (v);
+        *this = t.freeze ();
     }
 
     template <Sortable V, functional::buildable_tree<colored<V>> T>
@@ -0,0 +1,431 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_REALTIME_QUEUE
+#define DATA_TOOLS_REALTIME_QUEUE
+
+#include <data/concepts.hpp>
+#include <data/functional/list.hpp>
+#include <data/reverse.hpp>
+
+namespace data {
+
+    // A functional queue in which first, rest, append and prepend take O(1) in
+    // the worst case rather than amortized. functional_queue reverses its whole
+    // back stack when the front runs out, which makes one call to rest take O(n).
+    // Since the queue is persistent, that call may be repeated any number of
+    // times on the same queue. This is the queue of Hood and Melville (1981)
+    // as presented in Okasaki, "Purely Functional Data Structures" (1998),
+    // section 8.2.1: the reversal is started as soon as the back becomes longer
+    // than the front and a few steps of it are performed during every operation,
+    // so that it is finished before the front runs out. No laziness is required.
+    //
+    // Elements that are prepended are kept in a separate stack in front of the
+    // rest of the queue so that they are not lost if a rotation is in progress.
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    struct realtime_queue;
+
+    template <typename stack, typename element>
+    bool empty (const realtime_queue<stack, element> &x);
+
+    template <typename stack, typename element>
+    size_t size (const realtime_queue<stack, element> &x);
+
+    template <typename stack, typename element>
+    realtime_queue<stack, element> values (const realtime_queue<stack, element> &x);
+
+    template <typename stack, typename element>
+    const element &last (const realtime_queue<stack, element> &x);
+
+    template <typename X, typename E>
+    realtime_queue<X, E> operator + (const realtime_queue<X, E> &a, const realtime_queue<X, E> &b);
+
+    template <typename stack, typename element>
+    requires requires (std::ostream &o, const element &e) {
+        { o << e } -> Same<std::ostream &>;
+    } std::ostream &operator << (std::ostream &o, const realtime_queue<stack, element> &n);
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    struct realtime_queue {
+
+        realtime_queue ();
+        explicit realtime_queue (const element &x);
+        explicit realtime_queue (const realtime_queue &l, const element &e);
+        explicit realtime_queue (inserted<element> e, const realtime_queue &l);
+
+        realtime_queue (std::initializer_list<wrapped<element>> init): realtime_queue {} {
+            for (const auto &x : init) *this = append (x);
+        }
+
+        bool empty () const;
+
+        size_t size () const;
+        bool valid () const;
+
+        const element &first () const;
+
+        // O(i).
+        const element &operator [] (size_t i) const;
+
+        // O(n) in general, but O(1) if anything has been appended since the last rotation.
+        const element &last () const;
+
+        realtime_queue rest () const;
+
+        realtime_queue append (const element &e) const;
+        realtime_queue prepend (const element &e) const;
+        realtime_queue append (const realtime_queue &q) const;
+
+        template <typename X, typename Y, typename ... P>
+        realtime_queue append (X x, Y y, P... p) const {
+            return append (element (x)).append (y, p...);
+        }
+
+        realtime_queue operator << (const element &e) const {
+            return append (e);
+        }
+
+        realtime_queue &operator <<= (const element &e) {
+            return *this = append (e);
+        }
+
+        realtime_queue operator >> (const element &e) const {
+            return prepend (e);
+        }
+
+        realtime_queue &operator >>= (const element &e) {
+            return *this = prepend (e);
+        }
+
+        template <Sequence X> requires std::equality_comparable_with<element, decltype (std::declval<X> ().first ())>
+        bool operator == (const X &x) const;
+
+        template <typename Z, typename E>
+        requires ImplicitlyConvertible<stack, Z> && ImplicitlyConvertible<element, E>
+        operator realtime_queue<Z, E> () const {
+            realtime_queue<Z, E> q {};
+            for (const auto &x : *this) q = q.append (E (x));
+            return q;
+        }
+
+        template <typename Z, typename E>
+        requires ExplicitlyConvertible<stack, Z> && ExplicitlyConvertible<element, E>
+        explicit operator realtime_queue<Z, E> () const {
+            realtime_queue<Z, E> q {};
+            for (const auto &x : *this) q = q.append (E (x));
+            return q;
+        }
+
+        // iteration is done by calling rest on a copy of the queue, so each step takes O(1).
+        struct const_iterator {
+            using value_type        = const unref<element>;
+            using difference_type   = int;
+            using pointer           = value_type *;
+            using reference         = value_type &;
+            using iterator_category = std::forward_iterator_tag;
+
+            bool      operator == (const const_iterator &i) const;
+
+            reference operator *  () const;
+            pointer   operator -> () const;
+            const_iterator &operator ++ ();
+            const_iterator  operator ++ (int);
+
+            const_iterator (): Queue {nullptr}, Rest {} {}
+            const_iterator (const realtime_queue *q, realtime_queue r): Queue {q}, Rest {std::move (r)} {}
+
+        private:
+            const realtime_queue *Queue;
+            realtime_queue Rest;
+        };
+
+        const_iterator begin () const {
+            return const_iterator {this, *this};
+        }
+
+        const_iterator end () const {
+            return const_iterator {this, realtime_queue {}};
+        }
+
+    private:
+        enum class phase : byte {
+            idle,
+            reversing,
+            appending,
+            done
+        };
+
+        // the state of a rotation in progress. The front is reversed onto
+        // Reversed while the back is reversed onto Result, and then
+        // Reversed is reversed onto Result, which becomes the new front.
+        // Valid is the number of elements of Reversed that have not
+        // been removed from the queue in the meantime.
+        struct rotation {
+            phase Phase {phase::idle};
+            int64 Valid {0};
+            stack Front {};
+            stack Reversed {};
+            stack Back {};
+            stack Result {};
+
+            rotation step () const;
+            rotation invalidate () const;
+        };
+
+        stack Prefix;
+        stack Front;
+        size_t FrontSize;
+        rotation Rotation;
+        stack Back;
+        size_t BackSize;
+
+        // the old front and the unused part of Reversed that were left over
+        // from the last rotation. Without garbage collection, releasing them
+        // all at once would take O(n), so they are released a few nodes at a
+        // time instead.
+        struct garbage {
+            stack Front {};
+            stack Reversed {};
+
+            garbage release () const;
+        };
+
+        garbage Garbage;
+
+        realtime_queue (stack p, stack f, size_t fz, rotation z, stack b, size_t bz, garbage g):
+            Prefix {p}, Front {f}, FrontSize {fz}, Rotation {z}, Back {b}, BackSize {bz}, Garbage {g} {}
+
+        // perform two steps of the rotation.
+        static realtime_queue exec (stack p, stack f, size_t fz, rotation z, stack b, size_t bz, garbage g);
+
+        // start a rotation if the back is longer than the front.
+        static realtime_queue check (stack p, stack f, size_t fz, rotation z, stack b, size_t bz, garbage g);
+
+        template <Stack Z, typename E> requires Sequence<Z, E> friend struct realtime_queue;
+    };
+
+    template <typename stack, typename element>
+    bool inline empty (const realtime_queue<stack, element> &x) {
+        return x.empty ();
+    }
+
+    template <typename stack, typename element>
+    size_t inline size (const realtime_queue<stack, element> &x) {
+        return x.size ();
+    }
+
+    template <typename stack, typename element>
+    realtime_queue<stack, element> inline values (const realtime_queue<stack, element> &x) {
+        return x;
+    }
+
+    template <typename stack, typename element>
+    const element inline &last (const realtime_queue<stack, element> &x) {
+        return x.last ();
+    }
+
+    template <typename X, typename E>
+    realtime_queue<X, E> inline operator + (const realtime_queue<X, E> &a, const realtime_queue<X, E> &b) {
+        return a.append (b);
+    }
+
+    template <typename stack, typename element>
+    requires requires (std::ostream &o, const element &e) {
+        { o << e } -> Same<std::ostream &>;
+    } std::ostream inline &operator << (std::ostream &o, const realtime_queue<stack, element> &n) {
+        o << "{";
+        auto i = n.begin ();
+        if (i != n.end ()) {
+            o << *i;
+            while (++i != n.end ()) o << ", " << *i;
+        }
+        return o << "}";
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    inline realtime_queue<stack, element>::realtime_queue ():
+        Prefix {}, Front {}, FrontSize {0}, Rotation {}, Back {}, BackSize {0}, Garbage {} {}
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    inline realtime_queue<stack, element>::realtime_queue (const element &x): realtime_queue {realtime_queue {}.append (x)} {}
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    inline realtime_queue<stack, element>::realtime_queue (const realtime_queue &l, const element &e): realtime_queue {l.append (e)} {}
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    inline realtime_queue<stack, element>::realtime_queue (inserted<element> e, const realtime_queue &l): realtime_queue {l.prepend (e)} {}
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    bool inline realtime_queue<stack, element>::empty () const {
+        return data::empty (Prefix) && FrontSize == 0;
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    size_t inline realtime_queue<stack, element>::size () const {
+        return data::size (Prefix) + FrontSize + BackSize;
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    bool realtime_queue<stack, element>::valid () const {
+        for (const auto &x : *this) if (!data::valid (x)) return false;
+        return true;
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    const element inline &realtime_queue<stack, element>::first () const {
+        if (!data::empty (Prefix)) return Prefix.first ();
+        return Front.first ();
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    const element &realtime_queue<stack, element>::operator [] (size_t i) const {
+        if (i >= size ()) throw empty_sequence_exception {};
+        auto x = begin ();
+        while (i-- > 0) x++;
+        return *x;
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    const element &realtime_queue<stack, element>::last () const {
+        if (empty ()) throw empty_sequence_exception {};
+        if (BackSize > 0) return Back.first ();
+        if (FrontSize == 0) return data::last (Prefix);
+        // during a rotation, the last element was the first to be put in Result.
+        if (Rotation.Phase == phase::idle) return data::last (Front);
+        return data::last (Rotation.Result);
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element>::rotation realtime_queue<stack, element>::rotation::step () const {
+        switch (Phase) {
+            case phase::reversing: {
+                if (!data::empty (Front)) return rotation {phase::reversing, Valid + 1,
+                    Front.rest (), data::prepend (Reversed, Front.first ()),
+                    Back.rest (), data::prepend (Result, Back.first ())};
+                // the back is always one longer than the front when a rotation starts.
+                return rotation {phase::appending, Valid, stack {}, Reversed, stack {}, data::prepend (Result, Back.first ())};
+            }
+            case phase::appending: {
+                if (Valid == 0) return rotation {phase::done, 0, stack {}, Reversed, stack {}, Result};
+                return rotation {phase::appending, Valid - 1, stack {}, Reversed.rest (), stack {}, data::prepend (Result, Reversed.first ())};
+            }
+            default: return *this;
+        }
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element>::rotation realtime_queue<stack, element>::rotation::invalidate () const {
+        switch (Phase) {
+            case phase::reversing: {
+                rotation r = *this;
+                r.Valid--;
+                return r;
+            }
+            case phase::appending: {
+                // the element to be removed has already been moved to Result.
+                if (Valid == 0) return rotation {phase::done, 0, stack {}, Reversed, stack {}, Result.rest ()};
+                rotation r = *this;
+                r.Valid--;
+                return r;
+            }
+            default: return *this;
+        }
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element>::garbage realtime_queue<stack, element>::garbage::release () const {
+        garbage g = *this;
+        for (int i = 0; i < 2; i++) {
+            if (!data::empty (g.Front)) g.Front = g.Front.rest ();
+            if (!data::empty (g.Reversed)) g.Reversed = g.Reversed.rest ();
+        }
+
+        return g;
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element> realtime_queue<stack, element>::exec (stack p, stack f, size_t fz, rotation z, stack b, size_t bz, garbage g) {
+        rotation next = z.step ().step ();
+        // a rotation takes longer than it takes to release the previous garbage,
+        // so g is always empty by the time a rotation is done.
+        if (next.Phase == phase::done) return realtime_queue {p, next.Result, fz, rotation {}, b, bz, garbage {f, next.Reversed}};
+        return realtime_queue {p, f, fz, next, b, bz, g.release ()};
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element> realtime_queue<stack, element>::check (stack p, stack f, size_t fz, rotation z, stack b, size_t bz, garbage g) {
+        if (bz <= fz) return exec (p, f, fz, z, b, bz, g);
+        return exec (p, f, fz + bz, rotation {phase::reversing, 0, f, stack {}, b, stack {}}, stack {}, 0, g);
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element> realtime_queue<stack, element>::rest () const {
+        if (!data::empty (Prefix)) return realtime_queue {Prefix.rest (), Front, FrontSize, Rotation, Back, BackSize, Garbage};
+        if (FrontSize == 0) return realtime_queue {};
+        return check (Prefix, Front.rest (), FrontSize - 1, Rotation.invalidate (), Back, BackSize, Garbage);
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element> realtime_queue<stack, element>::append (const element &e) const {
+        return check (Prefix, Front, FrontSize, Rotation, data::prepend (Back, e), BackSize + 1, Garbage);
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element> inline realtime_queue<stack, element>::prepend (const element &e) const {
+        return realtime_queue {data::prepend (Prefix, e), Front, FrontSize, Rotation, Back, BackSize, Garbage};
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element> realtime_queue<stack, element>::append (const realtime_queue &q) const {
+        realtime_queue x = *this;
+        for (const auto &e : q) x = x.append (e);
+        return x;
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    template <Sequence X> requires std::equality_comparable_with<element, decltype (std::declval<X> ().first ())>
+    bool realtime_queue<stack, element>::operator == (const X &x) const {
+        if (size () != data::size (x)) return false;
+        realtime_queue a = *this;
+        X b = x;
+        while (!a.empty ()) {
+            if (a.first () != b.first ()) return false;
+            a = a.rest ();
+            b = b.rest ();
+        }
+
+        return true;
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    bool inline realtime_queue<stack, element>::const_iterator::operator == (const const_iterator &i) const {
+        return Queue == i.Queue && Rest.size () == i.Rest.size ();
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element>::const_iterator::reference inline realtime_queue<stack, element>::const_iterator::operator * () const {
+        return Rest.first ();
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element>::const_iterator::pointer inline realtime_queue<stack, element>::const_iterator::operator -> () const {
+        return &Rest.first ();
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element>::const_iterator inline &realtime_queue<stack, element>::const_iterator::operator ++ () {
+        Rest = Rest.rest ();
+        return *this;
+    }
+
+    template <Stack stack, typename element> requires Sequence<stack, element>
+    realtime_queue<stack, element>::const_iterator inline realtime_queue<stack, element>::const_iterator::operator ++ (int) {
+        const_iterator i = *this;
+        ++(*this);
+        return i;
+    }
+
+}
+
+#endif
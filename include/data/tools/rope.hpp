@@ -0,0 +1,189 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_ROPE
+#define DATA_TOOLS_ROPE
+
+#include <vector>
+#include <data/stream.hpp>
+
+namespace data {
+
+    // A buffer made of a series of segments that can be written to
+    // without knowing its final size. Writing never moves what has already
+    // been written. New segments get bigger as the rope grows, so that a
+    // large rope does not have too many of them.
+    //
+    // The segments can be used directly, for example in a vectored write
+    // to a socket (see net::asio::buffers), or the rope can be flattened
+    // into a single string.
+    template <std::integral word>
+    class rope final : public writer<word> {
+    public:
+        // the size of the first segment.
+        constexpr static size_t DefaultChunk = 1024 / sizeof (word);
+        // segments do not grow beyond this unless a single write is larger.
+        constexpr static size_t MaxChunk = 65536 / sizeof (word);
+
+        explicit rope (size_t chunk = DefaultChunk) : Segments {}, Size {0}, Chunk {std::max (chunk, size_t {1})} {}
+
+        // a rope with a single segment.
+        rope (std::vector<word> &&v) : rope {} {
+            append (std::move (v));
+        }
+
+        rope (rope &&) = default;
+        rope &operator = (rope &&) = default;
+
+        rope (const rope &) = default;
+        rope &operator = (const rope &) = default;
+
+        void write (const word *b, size_t size) final override;
+
+        // add a segment without copying it.
+        void append (std::vector<word> &&);
+
+        size_t size () const {
+            return Size;
+        }
+
+        bool empty () const {
+            return Size == 0;
+        }
+
+        void clear () {
+            Segments.clear ();
+            Size = 0;
+        }
+
+        // this has to go through the segments to find the one with i in it.
+        word &operator [] (size_t i);
+        const word &operator [] (size_t i) const;
+
+        std::vector<slice<const word>> segments () const;
+
+        // iterate over the segments without allocating.
+        template <typename F> void each (F &&f) const {
+            for (const std::vector<word> &s : Segments) if (s.size () > 0) f (slice<const word> {s.data (), s.size ()});
+        }
+
+        // copy everything into a single string.
+        template <typename bytes> bytes flatten () const &;
+
+        // if there is only one segment, it is moved into the result.
+        template <typename bytes> bytes flatten () &&;
+
+        template <std::output_iterator<word> it> it copy (it) const;
+
+    private:
+        std::vector<std::vector<word>> Segments;
+        size_t Size;
+        size_t Chunk;
+
+        void extend (size_t at_least);
+    };
+
+    template <std::integral word>
+    writer<word> inline &operator << (writer<word> &w, const rope<word> &r) {
+        r.each ([&w] (slice<const word> s) {
+            w.write (s.data (), s.size ());
+        });
+
+        return w;
+    }
+
+    template <std::integral word>
+    void rope<word>::extend (size_t at_least) {
+        Segments.emplace_back ();
+        Segments.back ().reserve (std::max (at_least, Chunk));
+        Chunk = std::min (Chunk * 2, std::max (MaxChunk, Chunk));
+    }
+
+    template <std::integral word>
+    void rope<word>::write (const word *b, size_t size) {
+        Size += size;
+
+        if (Segments.size () > 0) {
+            std::vector<word> &last = Segments.back ();
+            size_t n = std::min (size, last.capacity () - last.size ());
+            last.insert (last.end (), b, b + n);
+            b += n;
+            size -= n;
+        }
+
+        if (size == 0) return;
+
+        extend (size);
+        Segments.back ().insert (Segments.back ().end (), b, b + size);
+    }
+
+    template <std::integral word>
+    void rope<word>::append (std::vector<word> &&v) {
+        Size += v.size ();
+        Segments.push_back (std::move (v));
+    }
+
+    template <std::integral word>
+    word &rope<word>::operator [] (size_t i) {
+        return const_cast<word &> (static_cast<const rope &> (*this)[i]);
+    }
+
+    template <std::integral word>
+    const word &rope<word>::operator [] (size_t i) const {
+        for (const std::vector<word> &s : Segments) {
+            if (i < s.size ()) return s[i];
+            i -= s.size ();
+        }
+
+        throw out_of_range {"rope index"};
+    }
+
+    template <std::integral word>
+    std::vector<slice<const word>> rope<word>::segments () const {
+        std::vector<slice<const word>> z {};
+        z.reserve (Segments.size ());
+        each ([&z] (slice<const word> s) {
+            z.push_back (s);
+        });
+
+        return z;
+    }
+
+    template <std::integral word>
+    template <std::output_iterator<word> it> it rope<word>::copy (it i) const {
+        for (const std::vector<word> &s : Segments) i = std::copy (s.begin (), s.end (), i);
+        return i;
+    }
+
+    template <std::integral word>
+    template <typename bytes> bytes rope<word>::flatten () const & {
+        if constexpr (requires (bytes &z) { z.resize (size_t {}); }) {
+            bytes z {};
+            z.resize (Size);
+            copy (z.begin ());
+            return z;
+        } else {
+            std::vector<word> v (Size);
+            copy (v.begin ());
+            return bytes {std::move (v)};
+        }
+    }
+
+    template <std::integral word>
+    template <typename bytes> bytes rope<word>::flatten () && {
+        if constexpr (std::constructible_from<bytes, std::vector<word> &&>) {
+            if (Segments.size () == 1) {
+                Size = 0;
+                bytes z (std::move (Segments.back ()));
+                Segments.clear ();
+                return z;
+            }
+        }
+
+        return static_cast<const rope &> (*this).template flatten<bytes> ();
+    }
+
+}
+
+#endif
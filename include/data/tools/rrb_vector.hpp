@@ -0,0 +1,669 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_RRB_VECTOR
+#define DATA_TOOLS_RRB_VECTOR
+
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <data/functional/list.hpp>
+#include <data/reverse.hpp>
+
+// A persistent relaxed radix balanced vector (Bagwell and Rompf, "RRB-Trees:
+// Efficient Immutable Vectors", 2011; Stucki et al., "RRB Vector: A Practical
+// General Purpose Immutable Sequence", 2015).
+//
+// Elements are stored in leaves of up to 32 elements, which are the bottom
+// of a tree in which every node has up to 32 children. If all the children
+// of a node but the last are full, we find the child containing an element
+// from the bits of its index, as in Clojure's vector. Otherwise, the node has
+// a table of the cumulative sizes of its children, and we start searching
+// the table at the position that the bits of the index would give us. Since
+// all leaves are at the same depth, which is at most log32 (n) + 1, indexing
+// is effectively constant time.
+//
+// Concatenation merges the right edge of the first tree with the left edge of
+// the second. Nodes along that edge are repacked only as much as is needed to
+// keep the number of nodes within 2 of the minimum, so it takes O(log n).
+// Slicing copies only the path to the point where the vector is cut.
+
+namespace data {
+
+    template <Copyable elem> class rrb_vector;
+
+    namespace detail {
+        // given the number of slots used in each of a sequence of nodes, the number
+        // of slots in each node after moving the contents of nodes that are not
+        // nearly full forward until there are at most extra more nodes than needed.
+        inline std::vector<size_t> rrb_plan (std::vector<size_t> slots, size_t width, size_t extra);
+    }
+
+    template <typename elem> bool empty (const rrb_vector<elem> &);
+    template <typename elem> size_t size (const rrb_vector<elem> &);
+    template <typename elem> const elem &last (const rrb_vector<elem> &);
+
+    // concatenation in O(log n).
+    template <typename elem> rrb_vector<elem> operator + (const rrb_vector<elem> &, const rrb_vector<elem> &);
+
+    // slicing in O(log n).
+    template <typename elem> rrb_vector<elem> take (const rrb_vector<elem> &, size_t);
+    template <typename elem> rrb_vector<elem> drop (const rrb_vector<elem> &, size_t);
+
+    template <typename elem> requires requires (std::ostream &o, const elem &e) {
+        { o << e } -> Same<std::ostream &>;
+    } std::ostream &operator << (std::ostream &, const rrb_vector<elem> &);
+
+    template <Copyable elem> class rrb_vector {
+        constexpr static uint32 bits = 5;
+        constexpr static size_t width = size_t {1} << bits;
+
+        // how many more nodes than the minimum we allow when concatenating.
+        constexpr static size_t extra = 2;
+
+        // references are stored as std::reference_wrapper.
+        using stored = std::remove_const_t<wrapped<elem>>;
+
+        struct node;
+        using next = ptr<const node>;
+
+        // a leaf has height 0.
+        next Root;
+        uint32 Height;
+
+        rrb_vector (next r, uint32 h): Root {std::move (r)}, Height {h} {}
+
+        static next leaf (std::vector<stored> &&);
+        static next branch (std::vector<next> &&, uint32 height);
+
+        // find the leaf containing element i. i is set to the position within the leaf.
+        static const node *find (const node *, uint32 height, size_t &i);
+
+        // select the child of a branch containing element i and set i to its position in the child.
+        static size_t child (const node &, uint32 height, size_t &i);
+
+        // add an element to the end or the beginning. If the node is full,
+        // the second node returned is a new node of the same height.
+        static std::pair<next, next> push_back (const next &, uint32 height, inserted<elem>);
+        static std::pair<next, next> push_front (const next &, uint32 height, inserted<elem>);
+
+        // the first n elements and everything after the first n elements.
+        static next take (const next &, uint32 height, size_t n);
+        static next drop (const next &, uint32 height, size_t n);
+
+        // merge l and r into a list of nodes of height max (hl, hr).
+        static std::vector<next> merge (const next &l, uint32 hl, const next &r, uint32 hr);
+
+        // redistribute the contents of nodes of the given height so that there are not too many.
+        static std::vector<next> rebalance (const std::vector<next> &, uint32 height);
+
+        // put nodes of height h - 1 into nodes of height h.
+        static std::vector<next> group (const std::vector<next> &, uint32 height);
+
+        static rrb_vector collapse (next, uint32 height);
+
+        template <typename I, typename S> static rrb_vector build (I, S);
+
+    public:
+        rrb_vector (): Root {}, Height {0} {}
+        explicit rrb_vector (inserted<elem> x): rrb_vector {rrb_vector {}.append (x)} {}
+        rrb_vector (std::initializer_list<wrapped<elem>> x): rrb_vector {build (x.begin (), x.end ())} {}
+
+        template <std::input_iterator I, std::sentinel_for<I> S>
+        rrb_vector (I b, S e): rrb_vector {build (b, e)} {}
+
+        size_t size () const;
+        bool empty () const;
+        bool valid () const;
+
+        const elem &first () const;
+        const elem &last () const;
+
+        // drop (1). Takes O(log n).
+        rrb_vector rest () const;
+
+        const elem &operator [] (size_t) const;
+
+        rrb_vector prepend (inserted<elem>) const;
+        rrb_vector append (inserted<elem>) const;
+
+        template <typename X, typename Y, typename ... P>
+        rrb_vector prepend (X x, Y y, P ... p) const {
+            return prepend (x).prepend (y, p...);
+        }
+
+        rrb_vector operator >> (inserted<elem> x) const {
+            return prepend (x);
+        }
+
+        rrb_vector operator << (inserted<elem> x) const {
+            return append (x);
+        }
+
+        rrb_vector &operator >>= (inserted<elem> x) {
+            return *this = prepend (x);
+        }
+
+        rrb_vector &operator <<= (inserted<elem> x) {
+            return *this = append (x);
+        }
+
+        // the first n elements.
+        rrb_vector take (size_t n) const;
+
+        // all but the first n elements.
+        rrb_vector drop (size_t n) const;
+
+        // elements from position begin up to but not including end.
+        rrb_vector slice (size_t begin, size_t end) const {
+            return take (end).drop (begin);
+        }
+
+        rrb_vector concat (const rrb_vector &) const;
+
+        // join is found only by argument-dependent lookup so that it does not
+        // compete with the join for lists when its address is taken.
+        friend rrb_vector join (const rrb_vector &a, const rrb_vector &b) {
+            return a.concat (b);
+        }
+
+        rrb_vector reverse () const;
+
+        bool contains (inserted<elem>) const;
+
+        template <Sequence X> requires std::equality_comparable_with<elem, decltype (std::declval<X> ().first ())>
+        bool operator == (const X &x) const;
+
+        struct const_iterator {
+            using value_type        = unref<elem>;
+            using difference_type   = int;
+            using pointer           = const value_type *;
+            using reference         = const value_type &;
+            using iterator_category = std::forward_iterator_tag;
+
+            bool      operator == (const const_iterator &i) const;
+
+            reference operator *  () const;
+            pointer   operator -> () const;
+            const_iterator &operator ++ ();
+            const_iterator  operator ++ (int);
+
+            const_iterator (): Vector {nullptr}, Index {0}, Leaf {nullptr}, End {0} {}
+            const_iterator (const rrb_vector *, size_t);
+
+        private:
+            const rrb_vector *Vector;
+            size_t Index;
+
+            // the leaf we are in and the index at which it ends.
+            const stored *Leaf;
+            size_t End;
+
+            void seek ();
+        };
+
+        const_iterator begin () const;
+        const_iterator end () const;
+    };
+
+    template <Copyable elem> struct rrb_vector<elem>::node {
+        // total number of elements under this node.
+        size_t Size;
+
+        // a leaf has values and a branch has children.
+        std::vector<stored> Values;
+        std::vector<next> Children;
+
+        // cumulative sizes of the children if this node is relaxed; empty otherwise.
+        std::vector<size_t> Sizes;
+
+        size_t slots () const {
+            return Children.size () == 0 ? Values.size () : Children.size ();
+        }
+    };
+
+    template <typename elem> bool inline empty (const rrb_vector<elem> &x) {
+        return x.empty ();
+    }
+
+    template <typename elem> size_t inline size (const rrb_vector<elem> &x) {
+        return x.size ();
+    }
+
+    template <typename elem> const elem inline &last (const rrb_vector<elem> &x) {
+        return x.last ();
+    }
+
+    template <typename elem> rrb_vector<elem> inline operator + (const rrb_vector<elem> &a, const rrb_vector<elem> &b) {
+        return a.concat (b);
+    }
+
+    template <typename elem> rrb_vector<elem> inline take (const rrb_vector<elem> &x, size_t n) {
+        return x.take (n);
+    }
+
+    template <typename elem> rrb_vector<elem> inline drop (const rrb_vector<elem> &x, size_t n) {
+        return x.drop (n);
+    }
+
+    template <typename elem> requires requires (std::ostream &o, const elem &e) {
+        { o << e } -> Same<std::ostream &>;
+    } std::ostream inline &operator << (std::ostream &o, const rrb_vector<elem> &x) {
+        o << "vector {";
+        auto i = x.begin ();
+        if (i != x.end ()) {
+            o << *i;
+            while (++i != x.end ()) o << ", " << *i;
+        }
+        return o << "}";
+    }
+
+    template <Copyable elem> size_t inline rrb_vector<elem>::size () const {
+        return Root == nullptr ? 0 : Root->Size;
+    }
+
+    template <Copyable elem> bool inline rrb_vector<elem>::empty () const {
+        return Root == nullptr;
+    }
+
+    template <Copyable elem> bool rrb_vector<elem>::valid () const {
+        for (const auto &x : *this) if (!data::valid (x)) return false;
+        return true;
+    }
+
+    template <Copyable elem> const elem inline &rrb_vector<elem>::first () const {
+        if (empty ()) throw empty_sequence_exception {};
+        return (*this)[0];
+    }
+
+    template <Copyable elem> const elem inline &rrb_vector<elem>::last () const {
+        if (empty ()) throw empty_sequence_exception {};
+        return (*this)[size () - 1];
+    }
+
+    template <Copyable elem> rrb_vector<elem> inline rrb_vector<elem>::rest () const {
+        return drop (1);
+    }
+
+    template <Copyable elem> const elem inline &rrb_vector<elem>::operator [] (size_t i) const {
+        if (i >= size ()) throw std::out_of_range {"rrb_vector: index " + std::to_string (i) +
+            " out of range for vector of size " + std::to_string (size ())};
+        const node *n = find (Root.get (), Height, i);
+        return n->Values[i];
+    }
+
+    template <Copyable elem> bool rrb_vector<elem>::contains (inserted<elem> x) const {
+        for (const auto &z : *this) if (z == x) return true;
+        return false;
+    }
+
+    template <Copyable elem>
+    template <Sequence X> requires std::equality_comparable_with<elem, decltype (std::declval<X> ().first ())>
+    bool rrb_vector<elem>::operator == (const X &x) const {
+        if (size () != data::size (x)) return false;
+        if constexpr (ConstIterable<X>) {
+            auto j = x.begin ();
+            for (const auto &z : *this) if (z != *j) return false;
+            else j++;
+            return true;
+        } else return sequence_equal (*this, x);
+    }
+
+    template <Copyable elem> size_t inline rrb_vector<elem>::child (const node &n, uint32 height, size_t &i) {
+        uint32 shift = bits * height;
+        size_t index = i >> shift;
+        if (n.Sizes.size () == 0) {
+            i -= index << shift;
+            return index;
+        }
+
+        // a child holds at most 1 << shift elements, so index is never too far along.
+        while (n.Sizes[index] <= i) index++;
+        if (index > 0) i -= n.Sizes[index - 1];
+        return index;
+    }
+
+    template <Copyable elem> const rrb_vector<elem>::node inline *rrb_vector<elem>::find (const node *n, uint32 height, size_t &i) {
+        while (height > 0) {
+            n = n->Children[child (*n, height, i)].get ();
+            height--;
+        }
+
+        return n;
+    }
+
+    template <Copyable elem> rrb_vector<elem>::next inline rrb_vector<elem>::leaf (std::vector<stored> &&v) {
+        auto n = std::make_shared<node> ();
+        n->Size = v.size ();
+        n->Values = std::move (v);
+        return n;
+    }
+
+    template <Copyable elem> rrb_vector<elem>::next rrb_vector<elem>::branch (std::vector<next> &&c, uint32 height) {
+        auto n = std::make_shared<node> ();
+        size_t full = size_t {1} << (bits * height);
+        size_t total = 0;
+        bool relaxed = false;
+        for (size_t i = 0; i < c.size (); i++) {
+            if (i + 1 < c.size () && c[i]->Size != full) relaxed = true;
+            total += c[i]->Size;
+        }
+
+        n->Size = total;
+        if (relaxed) {
+            n->Sizes.reserve (c.size ());
+            size_t z = 0;
+            for (const next &x : c) n->Sizes.push_back (z += x->Size);
+        }
+
+        n->Children = std::move (c);
+        return n;
+    }
+
+    template <Copyable elem> std::pair<typename rrb_vector<elem>::next, typename rrb_vector<elem>::next>
+    rrb_vector<elem>::push_back (const next &n, uint32 height, inserted<elem> x) {
+        if (height == 0) {
+            if (n->Values.size () == width) return {n, leaf (std::vector<stored> {stored (x)})};
+            std::vector<stored> v {};
+            v.reserve (n->Values.size () + 1);
+            for (const stored &z : n->Values) v.push_back (z);
+            v.push_back (stored (x));
+            return {leaf (std::move (v)), nullptr};
+        }
+
+        auto [c, o] = push_back (n->Children.back (), height - 1, x);
+        std::vector<next> children = n->Children;
+        children.back () = std::move (c);
+        if (o == nullptr) return {branch (std::move (children), height), nullptr};
+        if (children.size () < width) {
+            children.push_back (std::move (o));
+            return {branch (std::move (children), height), nullptr};
+        }
+
+        return {branch (std::move (children), height), branch (std::vector<next> {std::move (o)}, height)};
+    }
+
+    template <Copyable elem> std::pair<typename rrb_vector<elem>::next, typename rrb_vector<elem>::next>
+    rrb_vector<elem>::push_front (const next &n, uint32 height, inserted<elem> x) {
+        if (height == 0) {
+            if (n->Values.size () == width) return {n, leaf (std::vector<stored> {stored (x)})};
+            std::vector<stored> v {};
+            v.reserve (n->Values.size () + 1);
+            v.push_back (stored (x));
+            for (const stored &z : n->Values) v.push_back (z);
+            return {leaf (std::move (v)), nullptr};
+        }
+
+        auto [c, o] = push_front (n->Children.front (), height - 1, x);
+        bool overflow = o != nullptr && n->Children.size () == width;
+        std::vector<next> children {};
+        children.reserve (n->Children.size () + 1);
+        if (o != nullptr && !overflow) children.push_back (std::move (o));
+        children.push_back (std::move (c));
+        for (size_t i = 1; i < n->Children.size (); i++) children.push_back (n->Children[i]);
+        if (!overflow) return {branch (std::move (children), height), nullptr};
+        return {branch (std::move (children), height), branch (std::vector<next> {std::move (o)}, height)};
+    }
+
+    template <Copyable elem> rrb_vector<elem> rrb_vector<elem>::append (inserted<elem> x) const {
+        if (empty ()) return rrb_vector {leaf (std::vector<stored> {stored (x)}), 0};
+        auto [r, o] = push_back (Root, Height, x);
+        if (o == nullptr) return rrb_vector {std::move (r), Height};
+        return rrb_vector {branch (std::vector<next> {std::move (r), std::move (o)}, Height + 1), Height + 1};
+    }
+
+    template <Copyable elem> rrb_vector<elem> rrb_vector<elem>::prepend (inserted<elem> x) const {
+        if (empty ()) return rrb_vector {leaf (std::vector<stored> {stored (x)}), 0};
+        auto [r, o] = push_front (Root, Height, x);
+        if (o == nullptr) return rrb_vector {std::move (r), Height};
+        return rrb_vector {branch (std::vector<next> {std::move (o), std::move (r)}, Height + 1), Height + 1};
+    }
+
+    template <Copyable elem> rrb_vector<elem> rrb_vector<elem>::collapse (next r, uint32 height) {
+        while (height > 0 && r->Children.size () == 1) {
+            next c = r->Children[0];
+            r = std::move (c);
+            height--;
+        }
+
+        return rrb_vector {std::move (r), height};
+    }
+
+    template <Copyable elem> rrb_vector<elem>::next rrb_vector<elem>::take (const next &n, uint32 height, size_t z) {
+        if (z == n->Size) return n;
+        if (height == 0) return leaf (std::vector<stored> (n->Values.begin (), n->Values.begin () + z));
+        size_t i = z - 1;
+        size_t index = child (*n, height, i);
+        std::vector<next> children (n->Children.begin (), n->Children.begin () + index);
+        children.push_back (take (n->Children[index], height - 1, i + 1));
+        return branch (std::move (children), height);
+    }
+
+    template <Copyable elem> rrb_vector<elem>::next rrb_vector<elem>::drop (const next &n, uint32 height, size_t z) {
+        if (z == 0) return n;
+        if (height == 0) return leaf (std::vector<stored> (n->Values.begin () + z, n->Values.end ()));
+        size_t i = z;
+        size_t index = child (*n, height, i);
+        std::vector<next> children {};
+        children.reserve (n->Children.size () - index);
+        children.push_back (drop (n->Children[index], height - 1, i));
+        for (size_t j = index + 1; j < n->Children.size (); j++) children.push_back (n->Children[j]);
+        return branch (std::move (children), height);
+    }
+
+    template <Copyable elem> rrb_vector<elem> rrb_vector<elem>::take (size_t n) const {
+        if (n >= size ()) return *this;
+        if (n == 0) return rrb_vector {};
+        return collapse (take (Root, Height, n), Height);
+    }
+
+    template <Copyable elem> rrb_vector<elem> rrb_vector<elem>::drop (size_t n) const {
+        if (n >= size ()) return rrb_vector {};
+        return collapse (drop (Root, Height, n), Height);
+    }
+
+    template <Copyable elem> std::vector<typename rrb_vector<elem>::next>
+    rrb_vector<elem>::group (const std::vector<next> &nodes, uint32 height) {
+        std::vector<next> result {};
+        for (size_t i = 0; i < nodes.size (); i += width)
+            result.push_back (branch (std::vector<next> (nodes.begin () + i,
+                nodes.begin () + std::min (i + width, nodes.size ())), height));
+        return result;
+    }
+
+    std::vector<size_t> inline detail::rrb_plan (std::vector<size_t> plan, size_t width, size_t extra) {
+        size_t total = 0;
+        for (size_t x : plan) total += x;
+
+        size_t optimal = (total + width - 1) / width;
+        size_t n = plan.size ();
+
+        // find nodes that are too small and spread their contents over the nodes after them.
+        size_t i = 0;
+        while (n > optimal + extra) {
+            while (i + 1 < n && plan[i] >= width - extra / 2) i++;
+            if (i + 1 == n) break;
+            size_t r = plan[i];
+            while (r > 0 && i + 1 < n) {
+                size_t z = std::min (r + plan[i + 1], width);
+                r = r + plan[i + 1] - z;
+                plan[i] = z;
+                i++;
+            }
+
+            // what did not fit stays in the last node, so no node has been emptied.
+            if (r > 0) {
+                plan[i] = r;
+                break;
+            }
+
+            // node i has been emptied.
+            for (size_t j = i; j + 1 < n; j++) plan[j] = plan[j + 1];
+            n--;
+            if (i > 0) i--;
+        }
+
+        plan.resize (n);
+        return plan;
+    }
+
+    template <Copyable elem> std::vector<typename rrb_vector<elem>::next>
+    rrb_vector<elem>::rebalance (const std::vector<next> &nodes, uint32 height) {
+        std::vector<size_t> slots {};
+        slots.reserve (nodes.size ());
+        for (const next &x : nodes) slots.push_back (x->slots ());
+
+        std::vector<size_t> plan = detail::rrb_plan (std::move (slots), width, extra);
+        size_t n = plan.size ();
+        if (n == nodes.size ()) return nodes;
+
+        // build the new nodes, keeping any old node that we can.
+        std::vector<next> result {};
+        result.reserve (n);
+        std::vector<stored> values {};
+        std::vector<next> children {};
+        size_t j = 0;
+        for (const next &x : nodes) {
+            if (j < n && values.size () == 0 && children.size () == 0 && x->slots () == plan[j]) {
+                result.push_back (x);
+                j++;
+                continue;
+            }
+
+            if (height == 0) {
+                values.insert (values.end (), x->Values.begin (), x->Values.end ());
+                while (j < n && values.size () >= plan[j]) {
+                    result.push_back (leaf (std::vector<stored> (values.begin (), values.begin () + plan[j])));
+                    values.erase (values.begin (), values.begin () + plan[j]);
+                    j++;
+                }
+            } else {
+                children.insert (children.end (), x->Children.begin (), x->Children.end ());
+                while (j < n && children.size () >= plan[j]) {
+                    result.push_back (branch (std::vector<next> (children.begin (), children.begin () + plan[j]), height));
+                    children.erase (children.begin (), children.begin () + plan[j]);
+                    j++;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    template <Copyable elem> std::vector<typename rrb_vector<elem>::next>
+    rrb_vector<elem>::merge (const next &l, uint32 hl, const next &r, uint32 hr) {
+        if (hl == 0 && hr == 0) return rebalance (std::vector<next> {l, r}, 0);
+
+        std::vector<next> all {};
+        uint32 height;
+        if (hl > hr) {
+            height = hl;
+            std::vector<next> mid = merge (l->Children.back (), hl - 1, r, hr);
+            all.insert (all.end (), l->Children.begin (), l->Children.end () - 1);
+            all.insert (all.end (), mid.begin (), mid.end ());
+        } else if (hl < hr) {
+            height = hr;
+            std::vector<next> mid = merge (l, hl, r->Children.front (), hr - 1);
+            all.insert (all.end (), mid.begin (), mid.end ());
+            all.insert (all.end (), r->Children.begin () + 1, r->Children.end ());
+        } else {
+            height = hl;
+            std::vector<next> mid = merge (l->Children.back (), hl - 1, r->Children.front (), hr - 1);
+            all.insert (all.end (), l->Children.begin (), l->Children.end () - 1);
+            all.insert (all.end (), mid.begin (), mid.end ());
+            all.insert (all.end (), r->Children.begin () + 1, r->Children.end ());
+        }
+
+        return group (rebalance (all, height - 1), height);
+    }
+
+    template <Copyable elem> rrb_vector<elem> rrb_vector<elem>::concat (const rrb_vector &x) const {
+        if (empty ()) return x;
+        if (x.empty ()) return *this;
+
+        uint32 height = std::max (Height, x.Height);
+        std::vector<next> nodes = merge (Root, Height, x.Root, x.Height);
+        while (nodes.size () > 1) nodes = group (nodes, ++height);
+        return collapse (nodes[0], height);
+    }
+
+    template <Copyable elem> template <typename I, typename S> rrb_vector<elem> rrb_vector<elem>::build (I b, S e) {
+        std::vector<next> nodes {};
+        std::vector<stored> values {};
+        for (; b != e; b++) {
+            values.push_back (stored (*b));
+            if (values.size () == width) {
+                nodes.push_back (leaf (std::move (values)));
+                values = std::vector<stored> {};
+            }
+        }
+
+        if (values.size () > 0) nodes.push_back (leaf (std::move (values)));
+        if (nodes.size () == 0) return rrb_vector {};
+
+        uint32 height = 0;
+        while (nodes.size () > 1) nodes = group (nodes, ++height);
+        return rrb_vector {nodes[0], height};
+    }
+
+    template <Copyable elem> rrb_vector<elem> rrb_vector<elem>::reverse () const {
+        std::vector<const stored *> v {};
+        v.reserve (size ());
+        for (auto i = begin (); i != end (); i++) v.push_back (&*i);
+        std::vector<stored> r {};
+        r.reserve (v.size ());
+        for (auto i = v.rbegin (); i != v.rend (); i++) r.push_back (**i);
+        return build (r.begin (), r.end ());
+    }
+
+    template <Copyable elem> rrb_vector<elem>::const_iterator inline rrb_vector<elem>::begin () const {
+        return const_iterator {this, 0};
+    }
+
+    template <Copyable elem> rrb_vector<elem>::const_iterator inline rrb_vector<elem>::end () const {
+        return const_iterator {this, size ()};
+    }
+
+    template <Copyable elem> inline rrb_vector<elem>::const_iterator::const_iterator (const rrb_vector *v, size_t i):
+        Vector {v}, Index {i}, Leaf {nullptr}, End {i} {
+        seek ();
+    }
+
+    template <Copyable elem> void inline rrb_vector<elem>::const_iterator::seek () {
+        if (Index >= Vector->size ()) return;
+        size_t i = Index;
+        const node *n = find (Vector->Root.get (), Vector->Height, i);
+        Leaf = n->Values.data () + i;
+        End = Index + n->Values.size () - i;
+    }
+
+    template <Copyable elem> bool inline rrb_vector<elem>::const_iterator::operator == (const const_iterator &i) const {
+        return Vector == i.Vector && Index == i.Index;
+    }
+
+    template <Copyable elem> rrb_vector<elem>::const_iterator::reference inline rrb_vector<elem>::const_iterator::operator * () const {
+        return *Leaf;
+    }
+
+    template <Copyable elem> rrb_vector<elem>::const_iterator::pointer inline rrb_vector<elem>::const_iterator::operator -> () const {
+        return &static_cast<reference> (*Leaf);
+    }
+
+    template <Copyable elem> rrb_vector<elem>::const_iterator inline &rrb_vector<elem>::const_iterator::operator ++ () {
+        Index++;
+        Leaf++;
+        if (Index == End) seek ();
+        return *this;
+    }
+
+    template <Copyable elem> rrb_vector<elem>::const_iterator inline rrb_vector<elem>::const_iterator::operator ++ (int) {
+        const_iterator i = *this;
+        ++(*this);
+        return i;
+    }
+
+}
+
+#endif
@@ -0,0 +1,376 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_SMALL_VECTOR
+#define DATA_TOOLS_SMALL_VECTOR
+
+#include <algorithm>
+#include <compare>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <vector>
+#include <data/types.hpp>
+
+namespace data {
+
+    // A replacement for std::vector that holds up to inline_size elements
+    // inside itself and only allocates when it grows beyond that. It is
+    // meant for short byte strings such as keys, digests and small numbers,
+    // which would otherwise each need an allocation.
+    //
+    // Only trivially copyable elements are supported so that elements can
+    // be moved around with memcpy. Like std::vector, new elements are value
+    // initialized, so resizing fills with zeros.
+    //
+    // Moving a small_vector that is stored inline copies its elements and
+    // invalidates iterators, unlike std::vector.
+    template <typename X, size_t inline_size> requires std::is_trivially_copyable_v<X>
+    class small_vector {
+    public:
+        using value_type = X;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = X &;
+        using const_reference = const X &;
+        using pointer = X *;
+        using const_pointer = const X *;
+        using iterator = X *;
+        using const_iterator = const X *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        constexpr static size_t inline_capacity = inline_size;
+
+        small_vector () noexcept : Data {Inline}, Size {0}, Capacity {inline_size} {}
+
+        explicit small_vector (size_t size) : small_vector {} {
+            resize (size);
+        }
+
+        small_vector (size_t size, const X &fill) : small_vector {} {
+            resize (size, fill);
+        }
+
+        template <std::input_iterator it>
+        small_vector (it b, it e) : small_vector {} {
+            assign (b, e);
+        }
+
+        small_vector (std::initializer_list<X> x) : small_vector {} {
+            assign (x.begin (), x.end ());
+        }
+
+        explicit small_vector (const std::vector<X> &v) : small_vector {} {
+            assign (v.begin (), v.end ());
+        }
+
+        small_vector (const small_vector &x) : small_vector {} {
+            assign (x.begin (), x.end ());
+        }
+
+        small_vector (small_vector &&x) noexcept : small_vector {} {
+            take (x);
+        }
+
+        ~small_vector () {
+            release ();
+        }
+
+        small_vector &operator = (const small_vector &x) {
+            if (this != &x) assign (x.begin (), x.end ());
+            return *this;
+        }
+
+        small_vector &operator = (small_vector &&x) noexcept {
+            if (this != &x) {
+                release ();
+                take (x);
+            }
+
+            return *this;
+        }
+
+        small_vector &operator = (std::initializer_list<X> x) {
+            assign (x.begin (), x.end ());
+            return *this;
+        }
+
+        void assign (size_t size, const X &fill) {
+            clear ();
+            resize (size, fill);
+        }
+
+        template <std::input_iterator it>
+        void assign (it b, it e) {
+            clear ();
+            if constexpr (std::forward_iterator<it>) {
+                size_t n = std::distance (b, e);
+                reserve (n);
+                std::copy (b, e, Data);
+                Size = n;
+            } else for (; b != e; b++) push_back (*b);
+        }
+
+        void assign (std::initializer_list<X> x) {
+            assign (x.begin (), x.end ());
+        }
+
+        X *data () noexcept {
+            return Data;
+        }
+
+        const X *data () const noexcept {
+            return Data;
+        }
+
+        size_t size () const noexcept {
+            return Size;
+        }
+
+        bool empty () const noexcept {
+            return Size == 0;
+        }
+
+        size_t capacity () const noexcept {
+            return Capacity;
+        }
+
+        size_t max_size () const noexcept {
+            return std::allocator_traits<std::allocator<X>>::max_size (std::allocator<X> {});
+        }
+
+        // whether the elements are stored inside the object.
+        bool is_inline () const noexcept {
+            return Data == Inline;
+        }
+
+        void reserve (size_t n) {
+            if (n > Capacity) reallocate (std::max (n, Capacity * 2));
+        }
+
+        void shrink_to_fit () {
+            if (is_inline () || Size == Capacity) return;
+            if (Size <= inline_size) {
+                X *heap = Data;
+                std::memcpy (Inline, heap, Size * sizeof (X));
+                std::allocator<X> {}.deallocate (heap, Capacity);
+                Data = Inline;
+                Capacity = inline_size;
+            } else reallocate (Size);
+        }
+
+        void resize (size_t n) {
+            resize (n, X {});
+        }
+
+        void resize (size_t n, const X &fill) {
+            // fill may be one of our own elements.
+            X copy = fill;
+            reserve (n);
+            if (n > Size) std::fill (Data + Size, Data + n, copy);
+            Size = n;
+        }
+
+        void clear () noexcept {
+            Size = 0;
+        }
+
+        void push_back (const X &x) {
+            if (Size == Capacity) {
+                // x may be one of our own elements.
+                X copy = x;
+                reserve (Size + 1);
+                Data[Size++] = copy;
+            } else Data[Size++] = x;
+        }
+
+        template <typename ... args>
+        X &emplace_back (args &&...a) {
+            push_back (X (std::forward<args> (a)...));
+            return back ();
+        }
+
+        void pop_back () noexcept {
+            Size--;
+        }
+
+        iterator insert (const_iterator pos, const X &x) {
+            return insert (pos, size_t {1}, x);
+        }
+
+        iterator insert (const_iterator pos, size_t n, const X &x) {
+            X copy = x;
+            X *at = open (pos, n);
+            std::fill (at, at + n, copy);
+            return at;
+        }
+
+        template <std::input_iterator it>
+        iterator insert (const_iterator pos, it b, it e) {
+            // as with std::vector, the range may not be part of this vector.
+            if constexpr (std::forward_iterator<it>) {
+                X *at = open (pos, std::distance (b, e));
+                std::copy (b, e, at);
+                return at;
+            } else {
+                size_t offset = pos - Data;
+                for (size_t i = offset; b != e; b++, i++) insert (Data + i, *b);
+                return Data + offset;
+            }
+        }
+
+        iterator insert (const_iterator pos, std::initializer_list<X> x) {
+            return insert (pos, x.begin (), x.end ());
+        }
+
+        iterator erase (const_iterator pos) {
+            return erase (pos, pos + 1);
+        }
+
+        iterator erase (const_iterator b, const_iterator e) {
+            X *at = Data + (b - Data);
+            std::memmove (at, e, (end () - e) * sizeof (X));
+            Size -= e - b;
+            return at;
+        }
+
+        void swap (small_vector &x) noexcept {
+            small_vector z {std::move (x)};
+            x = std::move (*this);
+            *this = std::move (z);
+        }
+
+        iterator begin () noexcept {
+            return Data;
+        }
+
+        iterator end () noexcept {
+            return Data + Size;
+        }
+
+        const_iterator begin () const noexcept {
+            return Data;
+        }
+
+        const_iterator end () const noexcept {
+            return Data + Size;
+        }
+
+        const_iterator cbegin () const noexcept {
+            return Data;
+        }
+
+        const_iterator cend () const noexcept {
+            return Data + Size;
+        }
+
+        reverse_iterator rbegin () noexcept {
+            return reverse_iterator {end ()};
+        }
+
+        reverse_iterator rend () noexcept {
+            return reverse_iterator {begin ()};
+        }
+
+        const_reverse_iterator rbegin () const noexcept {
+            return const_reverse_iterator {end ()};
+        }
+
+        const_reverse_iterator rend () const noexcept {
+            return const_reverse_iterator {begin ()};
+        }
+
+        X &operator [] (size_t i) {
+            return Data[i];
+        }
+
+        const X &operator [] (size_t i) const {
+            return Data[i];
+        }
+
+        X &at (size_t i) {
+            if (i >= Size) throw std::out_of_range {"small_vector::at"};
+            return Data[i];
+        }
+
+        const X &at (size_t i) const {
+            if (i >= Size) throw std::out_of_range {"small_vector::at"};
+            return Data[i];
+        }
+
+        X &front () {
+            return Data[0];
+        }
+
+        const X &front () const {
+            return Data[0];
+        }
+
+        X &back () {
+            return Data[Size - 1];
+        }
+
+        const X &back () const {
+            return Data[Size - 1];
+        }
+
+        bool operator == (const small_vector &x) const {
+            return Size == x.Size && std::equal (begin (), end (), x.begin ());
+        }
+
+        auto operator <=> (const small_vector &x) const {
+            return std::lexicographical_compare_three_way (begin (), end (), x.begin (), x.end ());
+        }
+
+    private:
+        X *Data;
+        size_t Size;
+        size_t Capacity;
+        X Inline[inline_size];
+
+        void reallocate (size_t n) {
+            X *fresh = std::allocator<X> {}.allocate (n);
+            std::memcpy (fresh, Data, Size * sizeof (X));
+            release ();
+            Data = fresh;
+            Capacity = n;
+        }
+
+        void release () noexcept {
+            if (!is_inline ()) std::allocator<X> {}.deallocate (Data, Capacity);
+        }
+
+        // take the contents of x, which is left empty.
+        void take (small_vector &x) noexcept {
+            if (x.is_inline ()) {
+                std::memcpy (Inline, x.Inline, x.Size * sizeof (X));
+                Data = Inline;
+                Capacity = inline_size;
+            } else {
+                Data = x.Data;
+                Capacity = x.Capacity;
+                x.Data = x.Inline;
+                x.Capacity = inline_size;
+            }
+
+            Size = x.Size;
+            x.Size = 0;
+        }
+
+        // make room for n elements at pos and return a pointer to them.
+        X *open (const_iterator pos, size_t n) {
+            size_t offset = pos - Data;
+            reserve (Size + n);
+            X *at = Data + offset;
+            std::memmove (at + n, at, (Size - offset) * sizeof (X));
+            Size += n;
+            return at;
+        }
+    };
+
+}
+
+#endif
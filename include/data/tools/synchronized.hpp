@@ -5,32 +5,88 @@
 #ifndef DATA_TOOLS_SYNCHRONIZED
 #define DATA_TOOLS_SYNCHRONIZED
 
+#include <mutex>
 #include <shared_mutex>
+#include <type_traits>
+#include <optional>
+#include <data/tools/atomic_snapshot.hpp>
 
 namespace data {
 
+    enum class synchronization {
+        // every access takes a lock.
+        locked,
+        // reads never wait for a writer to compute a new value. Writes copy
+        // the value and replace it with compare-and-swap. Use this for
+        // persistent types, which are cheap to copy, that are read much more
+        // often than they are written. See atomic_snapshot about locking.
+        read_mostly
+    };
+
     // turn any type into a threadsafe type.
-    template <typename X> class synchronized {
+    template <typename X, synchronization mode = synchronization::locked> class synchronized {
         X Value;
-        std::shared_mutex Mut;
-    
+        mutable std::shared_mutex Mut;
+
     public:
         template <typename... Args>
         synchronized (Args... args) : Value {args...}, Mut {} {}
 
-        template <typename fun> requires std::regular_invocable<fun, X>
+        template <typename fun> requires std::regular_invocable<fun, const X &>
         auto operator () (fun &&f) const {
             std::shared_lock<std::shared_mutex> lock {Mut};
             return f (Value);
         }
 
-        template <typename fun, typename ...args> requires std::regular_invocable<fun, X>
+        template <typename fun> requires std::invocable<fun, X &>
         auto operator () (fun &&f) {
             std::unique_lock<std::shared_mutex> lock {Mut};
             return f (Value);
         }
     };
 
+    // In read-mostly mode, a non-const call runs f on a copy of the value,
+    // which replaces the value unless another writer has replaced it first,
+    // in which case f is called again on the new value. Therefore f should
+    // have no side effects other than on its argument.
+    template <typename X> class synchronized<X, synchronization::read_mostly> {
+        atomic_snapshot<X> Value;
+
+    public:
+        template <typename... Args>
+        synchronized (Args... args) : Value {args...} {}
+
+        template <typename fun> requires std::regular_invocable<fun, const X &>
+        auto operator () (fun &&f) const {
+            return Value (f);
+        }
+
+        template <typename fun> requires std::invocable<fun, X &>
+        auto operator () (fun &&f) {
+            using result = std::invoke_result_t<fun, X &>;
+            if constexpr (std::is_void_v<result>) {
+                Value.update ([&f] (const X &old) -> X {
+                    X x = old;
+                    f (x);
+                    return x;
+                });
+            } else {
+                std::optional<std::remove_cvref_t<result>> r;
+                Value.update ([&f, &r] (const X &old) -> X {
+                    X x = old;
+                    r.emplace (f (x));
+                    return x;
+                });
+                return std::move (*r);
+            }
+        }
+
+        // a snapshot of the value, which will not change.
+        typename atomic_snapshot<X>::snapshot snapshot () const {
+            return Value.load ();
+        }
+    };
+
 }
 
 #endif
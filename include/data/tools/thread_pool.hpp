@@ -0,0 +1,180 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_THREAD_POOL
+#define DATA_TOOLS_THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <data/function.hpp>
+#include <data/types.hpp>
+
+namespace data {
+
+    // where the threads of a pool are allowed to run.
+    enum class placement {
+        // leave it to the operating system.
+        none,
+        // pin thread i to core i, going through the cores of one
+        // NUMA node before moving on to the next.
+        cores,
+        // distribute threads evenly over NUMA nodes. Each thread may run on
+        // any core of its node and steals from threads on the same node first.
+        numa
+    };
+
+    // The cores of the machine grouped by NUMA node. On systems where this
+    // cannot be determined, there is one node containing every core.
+    std::vector<std::vector<uint32>> numa_nodes ();
+
+    // A work-stealing thread pool.
+    //
+    // Every thread has its own queue. A task posted from inside the pool
+    // goes on the queue of the thread that posted it, and a task posted
+    // from outside goes on the queues in rotation. A thread runs the most
+    // recent task on its own queue, and when its queue is empty it steals
+    // the oldest task from another thread, looking first at threads on the
+    // same NUMA node. Threads with nothing to do sleep until a task is posted.
+    //
+    // If a task throws an exception, the pool stops and the exception
+    // is rethrown by wait.
+    class thread_pool {
+    public:
+        struct options {
+            uint32 Threads {std::thread::hardware_concurrency ()};
+            data::placement Placement {placement::none};
+        };
+
+        explicit thread_pool (options);
+        explicit thread_pool (uint32 threads): thread_pool {options {threads, placement::none}} {}
+
+        thread_pool (const thread_pool &) = delete;
+        thread_pool &operator = (const thread_pool &) = delete;
+
+        // stop the pool and join all threads.
+        ~thread_pool ();
+
+        void post (function<void ()>);
+
+        // tasks that have not started will not be run.
+        void stop ();
+
+        bool stopped () const {
+            return Stopped.load (std::memory_order_acquire);
+        }
+
+        // block until there are no tasks left or the pool is stopped.
+        // Rethrows the first exception thrown by a task.
+        void wait ();
+
+        uint32 size () const {
+            return Size;
+        }
+
+        // number of tasks that have finished.
+        uint64 completed () const {
+            return Completed.load (std::memory_order_relaxed);
+        }
+
+        // the pool that the current thread belongs to, if any.
+        static thread_pool *current ();
+
+        // index of the current thread in its pool.
+        static uint32 current_index ();
+
+    private:
+        struct alignas (64) queue {
+            std::mutex Mutex;
+            std::deque<function<void ()>> Tasks;
+            // other queues in the order in which they are searched for
+            // tasks to steal, which begins with those on the same node.
+            std::vector<uint32> Victims;
+        };
+
+        uint32 Size;
+        std::unique_ptr<queue[]> Queues;
+        std::vector<std::thread> Threads;
+
+        std::atomic<bool> Stopped {false};
+
+        // tasks that have been posted and not yet taken from a queue.
+        alignas (64) std::atomic<int64> Queued {0};
+        // tasks that have been posted and have not finished.
+        alignas (64) std::atomic<uint64> Outstanding {0};
+        alignas (64) std::atomic<uint64> Completed {0};
+        alignas (64) std::atomic<uint32> Sleeping {0};
+        std::atomic<uint32> NextQueue {0};
+
+        std::mutex Mutex;
+        // threads with nothing to do wait on this.
+        std::condition_variable Wake;
+        // wait waits on this.
+        std::condition_variable Idle;
+        std::exception_ptr Error;
+
+        void run (uint32 index);
+        bool take (uint32 index, function<void ()> &task);
+        void finish ();
+        void fail (std::exception_ptr);
+    };
+
+    // call f (i) for every i in [0, n) in parallel on a pool and wait for
+    // them all to finish. The calling thread takes part, so this may be
+    // called from inside the pool, even if it has one thread. Rethrows the
+    // first exception thrown by f.
+    template <std::invocable<size_t> fun> void parallel_for (thread_pool &pool, size_t n, fun &&f);
+
+    template <std::invocable<size_t> fun> void parallel_for (thread_pool &pool, size_t n, fun &&f) {
+        if (n == 0) return;
+        if (n == 1) {
+            f (size_t {0});
+            return;
+        }
+
+        // helpers may start after we have returned, so they
+        // must not refer to anything on our stack.
+        struct state {
+            std::remove_reference_t<fun> *Function;
+            std::atomic<size_t> Next {0};
+            std::latch Done;
+            std::mutex Mutex {};
+            std::exception_ptr Error {};
+
+            state (std::remove_reference_t<fun> *f, size_t n): Function {f}, Done {std::ptrdiff_t (n)} {}
+
+            void work (size_t n) {
+                for (size_t i = Next.fetch_add (1); i < n; i = Next.fetch_add (1)) {
+                    try {
+                        (*Function) (i);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock {Mutex};
+                        if (!Error) Error = std::current_exception ();
+                    }
+
+                    Done.count_down ();
+                }
+            }
+        };
+
+        auto z = std::make_shared<state> (&f, n);
+        for (size_t i = 1, helpers = std::min<size_t> (n, pool.size () + 1); i < helpers; i++)
+            pool.post ([z, n] {
+                z->work (n);
+            });
+
+        z->work (n);
+        z->Done.wait ();
+        if (z->Error) std::rethrow_exception (z->Error);
+    }
+
+}
+
+#endif
@@ -0,0 +1,463 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_TOOLS_UNROLLED_STACK
+#define DATA_TOOLS_UNROLLED_STACK
+
+#include <atomic>
+#include <ostream>
+#include <vector>
+#include <data/functional/stack.hpp>
+#include <data/tools/pool.hpp>
+
+namespace data {
+
+    // A persistent stack that keeps up to chunk_size elements in each node.
+    // Elements in a chunk are stored from the back so that prepending fills
+    // the chunk toward the front. A stack is a pointer to a chunk together
+    // with the position of its first element in that chunk, so rest takes O(1)
+    // and does not allocate. Iteration, operator [] and last follow one
+    // pointer per chunk rather than one per element.
+    //
+    // Chunks are never changed once an element has been written, but an empty
+    // slot in front of the first element can be claimed by the first stack
+    // that prepends onto it. If another stack has already claimed the slot,
+    // the elements of the head chunk are copied into a new chunk. The rest
+    // of the stack is always shared.
+    //
+    // alloc is the node storage policy. See tools/pool.hpp.
+    template <Copyable elem, size_t chunk_size = 32, typename alloc = pool::shared> class unrolled_stack;
+
+    template <typename elem, size_t z, typename alloc> bool empty (const unrolled_stack<elem, z, alloc> &x);
+    template <typename elem, size_t z, typename alloc> size_t size (const unrolled_stack<elem, z, alloc> &x);
+
+    // stack two stacks together.
+    template <typename elem, size_t z, typename alloc>
+    unrolled_stack<elem, z, alloc> operator + (unrolled_stack<elem, z, alloc>, unrolled_stack<elem, z, alloc>);
+
+    template <typename elem, size_t z, typename alloc> requires requires (std::ostream &o, const elem &e) {
+        { o << e } -> Same<std::ostream &>;
+    } std::ostream inline &operator << (std::ostream &o, const unrolled_stack<elem, z, alloc> &x);
+
+    template <typename elem, size_t z, typename alloc>
+    unrolled_stack<elem, z, alloc> values (const unrolled_stack<elem, z, alloc> &x);
+
+    template <typename elem, size_t z, typename alloc> const elem &last (const unrolled_stack<elem, z, alloc> &x);
+
+    // O(n / z) rather than O(n).
+    template <typename elem, size_t z, typename alloc>
+    unrolled_stack<elem, z, alloc> drop (const unrolled_stack<elem, z, alloc> &x, size_t n);
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    class unrolled_stack {
+        static_assert (chunk_size > 1 && chunk_size <= 65536);
+
+        // references are stored as std::reference_wrapper.
+        using stored = std::remove_const_t<wrapped<elem>>;
+
+        struct chunk;
+        using next = typename alloc::template pointer<chunk>;
+
+        next Chunk;
+        uint32 Offset;
+        size_t Size;
+
+        unrolled_stack (next c, uint32 o, size_t z);
+
+        static elem &get (stored &);
+
+    public:
+        constexpr unrolled_stack ();
+        unrolled_stack (const unrolled_stack &) = default;
+        unrolled_stack (unrolled_stack &&) = default;
+        ~unrolled_stack ();
+
+        unrolled_stack &operator = (const unrolled_stack &) = default;
+        unrolled_stack &operator = (unrolled_stack &&) = default;
+
+        explicit unrolled_stack (inserted<elem> e, const unrolled_stack &l);
+        explicit unrolled_stack (inserted<elem> e);
+
+        unrolled_stack (std::initializer_list<wrapped<elem>> init): unrolled_stack {} {
+            for (int i = init.size () - 1; i >= 0; i--) *this = prepend (*(init.begin () + i));
+        }
+
+        const elem &first () const;
+        elem &first ();
+
+        bool empty () const;
+
+        unrolled_stack rest () const;
+
+        bool valid () const;
+
+        bool contains (elem x) const;
+
+        size_t size () const;
+
+        unrolled_stack operator >> (inserted<elem> x) const;
+        unrolled_stack &operator >>= (inserted<elem> x);
+
+        unrolled_stack prepend (inserted<elem> x) const;
+
+        template <typename X, typename Y, typename ... P>
+        unrolled_stack prepend (X x, Y y, P ... p) const;
+
+        // skip n elements in O(n / chunk_size).
+        unrolled_stack from (size_t n) const;
+
+        elem &operator [] (size_t n);
+        const elem &operator [] (size_t n) const;
+
+        template <Sequence X> requires std::equality_comparable_with<elem, decltype (std::declval<X> ().first ())>
+        bool operator == (const X &x) const;
+
+        // automatic conversions
+        template <typename X> requires ImplicitlyConvertible<elem, X>
+        operator unrolled_stack<X, chunk_size, alloc> () const;
+
+        // explicit conversions
+        template <typename X> requires ExplicitlyConvertible<elem, X>
+        explicit operator unrolled_stack<X, chunk_size, alloc> () const;
+
+        template <typename V>
+        struct it {
+
+            using value_type        = unref<V>;
+            using difference_type   = int;
+            using pointer           = value_type *;
+            using reference         = value_type &;
+            using iterator_category = std::forward_iterator_tag;
+
+            bool      operator == (const it &i) const;
+
+            reference operator *  () const;
+            pointer   operator -> () const;
+            it       &operator ++ ();    // pre-increment
+            it        operator ++ (int); // post-increment
+
+            it (): Chunk {nullptr}, Offset {0} {}
+            it (chunk *c, uint32 o): Chunk {c}, Offset {o} {}
+
+        private:
+            // the stack being iterated over keeps the chunks alive.
+            chunk *Chunk;
+            uint32 Offset;
+        };
+
+        using iterator = it<elem>;
+        using const_iterator = it<const elem>;
+
+        iterator begin ();
+        iterator end ();
+
+        const_iterator begin () const;
+        const_iterator end () const;
+
+        template <typename e, size_t z, typename a> friend const e &last (const unrolled_stack<e, z, a> &);
+    };
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    struct unrolled_stack<elem, chunk_size, alloc>::chunk {
+        union slot {
+            slot () {}
+            ~slot () {}
+            stored Value;
+        };
+
+        // the lowest occupied slot.
+        std::atomic<uint32> Begin;
+        slot Slots[chunk_size];
+        unrolled_stack Rest;
+
+        chunk (unrolled_stack r): Begin {chunk_size}, Rest {std::move (r)} {}
+
+        // copy the elements of c from position o on.
+        chunk (const chunk &c, uint32 o): Begin {chunk_size}, Rest {c.Rest} {
+            try {
+                for (uint32 i = chunk_size; i > o; i--) {
+                    new (&Slots[i - 1].Value) stored (c.Slots[i - 1].Value);
+                    Begin = i - 1;
+                }
+            } catch (...) {
+                destroy ();
+                throw;
+            }
+        }
+
+        ~chunk () {
+            destroy ();
+        }
+
+        void destroy () {
+            for (uint32 i = Begin.load (std::memory_order_relaxed); i < chunk_size; i++) Slots[i].Value.~stored ();
+        }
+
+        // claim slot o - 1 for a new element if nobody else has.
+        bool claim (uint32 o) {
+            return o > 0 && Begin.compare_exchange_strong (o, o - 1, std::memory_order_acq_rel);
+        }
+    };
+
+    template <typename elem, size_t z, typename alloc>
+    unrolled_stack<elem, z, alloc> inline operator + (unrolled_stack<elem, z, alloc> a, unrolled_stack<elem, z, alloc> b) {
+        return join (a, b);
+    }
+
+    template <typename elem, size_t z, typename alloc> bool inline empty (const unrolled_stack<elem, z, alloc> &x) {
+        return x.empty ();
+    }
+
+    template <typename elem, size_t z, typename alloc> size_t inline size (const unrolled_stack<elem, z, alloc> &x) {
+        return x.size ();
+    }
+
+    template <typename elem, size_t z, typename alloc>
+    unrolled_stack<elem, z, alloc> inline values (const unrolled_stack<elem, z, alloc> &x) {
+        return x;
+    }
+
+    template <typename elem, size_t z, typename alloc> requires requires (std::ostream &o, const elem &e) {
+        { o << e } -> Same<std::ostream &>;
+    } std::ostream inline &operator << (std::ostream &o, const unrolled_stack<elem, z, alloc> &x) {
+        return functional::write (o << "stack ", x);
+    }
+
+    template <typename elem, size_t z, typename alloc>
+    unrolled_stack<elem, z, alloc> inline drop (const unrolled_stack<elem, z, alloc> &x, size_t n) {
+        return x.from (n);
+    }
+
+    template <typename elem, size_t z, typename alloc> const elem &last (const unrolled_stack<elem, z, alloc> &x) {
+        if (x.empty ()) throw empty_sequence_exception {};
+        auto *c = x.Chunk.get ();
+        while (!c->Rest.empty ()) c = c->Rest.Chunk.get ();
+        return unrolled_stack<elem, z, alloc>::get (c->Slots[z - 1].Value);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    elem inline &unrolled_stack<elem, chunk_size, alloc>::get (stored &x) {
+        if constexpr (std::is_reference_v<elem>) return x.get ();
+        else return x;
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    inline unrolled_stack<elem, chunk_size, alloc>::unrolled_stack (next c, uint32 o, size_t z):
+        Chunk {std::move (c)}, Offset {o}, Size {z} {}
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    constexpr inline unrolled_stack<elem, chunk_size, alloc>::unrolled_stack (): Chunk {nullptr}, Offset {0}, Size {0} {}
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    inline unrolled_stack<elem, chunk_size, alloc>::~unrolled_stack () {
+        // release uniquely-owned chunks one at a time so that
+        // destroying a long stack does not overflow the call stack.
+        while (Chunk != nullptr && Chunk.use_count () == 1) Chunk = std::move (Chunk->Rest.Chunk);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    inline unrolled_stack<elem, chunk_size, alloc>::unrolled_stack (inserted<elem> e, const unrolled_stack &l):
+        unrolled_stack {l.prepend (e)} {}
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    inline unrolled_stack<elem, chunk_size, alloc>::unrolled_stack (inserted<elem> e): unrolled_stack {unrolled_stack {}.prepend (e)} {}
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    unrolled_stack<elem, chunk_size, alloc> unrolled_stack<elem, chunk_size, alloc>::prepend (inserted<elem> x) const {
+        next c;
+        if (Chunk == nullptr) c = alloc::template make<chunk> (unrolled_stack {});
+        else if (Offset == 0) c = alloc::template make<chunk> (*this);
+        else if (Chunk->claim (Offset)) {
+            try {
+                new (&Chunk->Slots[Offset - 1].Value) stored (x);
+            } catch (...) {
+                // nobody else can have claimed a slot in front of ours.
+                Chunk->Begin.store (Offset, std::memory_order_release);
+                throw;
+            }
+
+            return unrolled_stack {Chunk, Offset - 1, Size + 1};
+        } else c = alloc::template make<chunk> (*Chunk, Offset);
+
+        // c is not shared yet, so the next slot is ours.
+        uint32 o = c->Begin.load (std::memory_order_relaxed);
+        new (&c->Slots[o - 1].Value) stored (x);
+        c->Begin.store (o - 1, std::memory_order_relaxed);
+        return unrolled_stack {std::move (c), o - 1, Size + 1};
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    const elem inline &unrolled_stack<elem, chunk_size, alloc>::first () const {
+        if (Chunk == nullptr) throw empty_sequence_exception {};
+        return get (Chunk->Slots[Offset].Value);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    elem inline &unrolled_stack<elem, chunk_size, alloc>::first () {
+        if (Chunk == nullptr) throw empty_sequence_exception {};
+        return get (Chunk->Slots[Offset].Value);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    bool inline unrolled_stack<elem, chunk_size, alloc>::empty () const {
+        return Chunk == nullptr;
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    size_t inline unrolled_stack<elem, chunk_size, alloc>::size () const {
+        return Size;
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    unrolled_stack<elem, chunk_size, alloc> inline unrolled_stack<elem, chunk_size, alloc>::rest () const {
+        if (empty ()) return {};
+        if (Offset + 1 == chunk_size) return Chunk->Rest;
+        return unrolled_stack {Chunk, Offset + 1, Size - 1};
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    bool unrolled_stack<elem, chunk_size, alloc>::valid () const {
+        for (const auto &x : *this) if (!data::valid (x)) return false;
+        return true;
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    bool unrolled_stack<elem, chunk_size, alloc>::contains (elem x) const {
+        for (const auto &z : *this) if (z == x) return true;
+        return false;
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    unrolled_stack<elem, chunk_size, alloc> inline unrolled_stack<elem, chunk_size, alloc>::operator >> (inserted<elem> x) const {
+        return prepend (x);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    unrolled_stack<elem, chunk_size, alloc> inline &unrolled_stack<elem, chunk_size, alloc>::operator >>= (inserted<elem> x) {
+        return *this = prepend (x);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    template <typename X, typename Y, typename ... P>
+    unrolled_stack<elem, chunk_size, alloc> inline unrolled_stack<elem, chunk_size, alloc>::prepend (X x, Y y, P ... p) const {
+        return prepend (x).prepend (y, p...);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    unrolled_stack<elem, chunk_size, alloc> unrolled_stack<elem, chunk_size, alloc>::from (size_t n) const {
+        if (n >= Size) return {};
+        const unrolled_stack *x = this;
+        while (n >= chunk_size - x->Offset) {
+            n -= chunk_size - x->Offset;
+            x = &x->Chunk->Rest;
+        }
+
+        return unrolled_stack {x->Chunk, uint32 (x->Offset + n), x->Size - n};
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    const elem inline &unrolled_stack<elem, chunk_size, alloc>::operator [] (size_t n) const {
+        if (n >= Size) throw empty_sequence_exception {};
+        const unrolled_stack *x = this;
+        while (n >= chunk_size - x->Offset) {
+            n -= chunk_size - x->Offset;
+            x = &x->Chunk->Rest;
+        }
+
+        return get (x->Chunk->Slots[x->Offset + n].Value);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    elem inline &unrolled_stack<elem, chunk_size, alloc>::operator [] (size_t n) {
+        return const_cast<elem &> (static_cast<const unrolled_stack &> (*this)[n]);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    template <Sequence X> requires std::equality_comparable_with<elem, decltype (std::declval<X> ().first ())>
+    bool inline unrolled_stack<elem, chunk_size, alloc>::operator == (const X &x) const {
+        return sequence_equal (*this, x);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    template <typename X> requires ImplicitlyConvertible<elem, X>
+    unrolled_stack<elem, chunk_size, alloc>::operator unrolled_stack<X, chunk_size, alloc> () const {
+        std::vector<const unref<elem> *> v {};
+        v.reserve (Size);
+        for (const auto &e : *this) v.push_back (&e);
+        unrolled_stack<X, chunk_size, alloc> x {};
+        for (auto i = v.rbegin (); i != v.rend (); i++) x >>= X (**i);
+        return x;
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    template <typename X> requires ExplicitlyConvertible<elem, X>
+    unrolled_stack<elem, chunk_size, alloc>::operator unrolled_stack<X, chunk_size, alloc> () const {
+        std::vector<const unref<elem> *> v {};
+        v.reserve (Size);
+        for (const auto &e : *this) v.push_back (&e);
+        unrolled_stack<X, chunk_size, alloc> x {};
+        for (auto i = v.rbegin (); i != v.rend (); i++) x >>= X (**i);
+        return x;
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    unrolled_stack<elem, chunk_size, alloc>::const_iterator inline unrolled_stack<elem, chunk_size, alloc>::begin () const {
+        return const_iterator {Chunk.get (), Offset};
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    unrolled_stack<elem, chunk_size, alloc>::const_iterator inline unrolled_stack<elem, chunk_size, alloc>::end () const {
+        return const_iterator {};
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    unrolled_stack<elem, chunk_size, alloc>::iterator inline unrolled_stack<elem, chunk_size, alloc>::begin () {
+        return iterator {Chunk.get (), Offset};
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    unrolled_stack<elem, chunk_size, alloc>::iterator inline unrolled_stack<elem, chunk_size, alloc>::end () {
+        return iterator {};
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    template <typename V>
+    bool inline unrolled_stack<elem, chunk_size, alloc>::it<V>::operator == (const it &i) const {
+        return Chunk == i.Chunk && Offset == i.Offset;
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    template <typename V>
+    unrolled_stack<elem, chunk_size, alloc>::it<V>::reference inline unrolled_stack<elem, chunk_size, alloc>::it<V>::operator * () const {
+        return get (Chunk->Slots[Offset].Value);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    template <typename V>
+    unrolled_stack<elem, chunk_size, alloc>::it<V>::pointer inline unrolled_stack<elem, chunk_size, alloc>::it<V>::operator -> () const {
+        return &get (Chunk->Slots[Offset].Value);
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    template <typename V>
+    unrolled_stack<elem, chunk_size, alloc>::it<V> inline &unrolled_stack<elem, chunk_size, alloc>::it<V>::operator ++ () {
+        if (Chunk == nullptr) return *this;
+        if (++Offset < chunk_size) return *this;
+        const unrolled_stack &r = Chunk->Rest;
+        Chunk = r.Chunk.get ();
+        Offset = r.Offset;
+        return *this;
+    }
+
+    template <Copyable elem, size_t chunk_size, typename alloc>
+    template <typename V>
+    unrolled_stack<elem, chunk_size, alloc>::it<V> inline unrolled_stack<elem, chunk_size, alloc>::it<V>::operator ++ (int) {
+        it n = *this;
+        ++(*this);
+        return n;
+    }
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/channel.hpp>
+
+namespace data::detail {
+
+    bool channel_signal::fire (const void *source) {
+        std::unique_ptr<handler> waiting;
+        {
+            std::lock_guard<std::mutex> lock {Mutex};
+            if (Fired) return false;
+            Fired = true;
+            Source = source;
+            waiting = std::move (Waiting);
+        }
+
+        if (waiting != nullptr) waiting->complete ();
+        return true;
+    }
+
+    void channel_waiters::add (ptr<channel_signal> s) {
+        std::lock_guard<std::mutex> lock {Mutex};
+        Signals.push_back (std::move (s));
+        Count.fetch_add (1, std::memory_order_seq_cst);
+    }
+
+    bool channel_waiters::remove (const ptr<channel_signal> &s) {
+        std::lock_guard<std::mutex> lock {Mutex};
+        for (auto i = Signals.begin (); i != Signals.end (); i++) if (*i == s) {
+            Signals.erase (i);
+            Count.fetch_sub (1, std::memory_order_relaxed);
+            return true;
+        }
+
+        return false;
+    }
+
+    void channel_waiters::notify_one (const void *source) {
+        // whoever made the channel ready must be ordered with
+        // respect to a waiter adding itself and checking again.
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        if (Count.load (std::memory_order_seq_cst) == 0) return;
+
+        while (true) {
+            ptr<channel_signal> s;
+            {
+                std::lock_guard<std::mutex> lock {Mutex};
+                if (Signals.empty ()) return;
+                s = std::move (Signals.front ());
+                Signals.pop_front ();
+                Count.fetch_sub (1, std::memory_order_relaxed);
+            }
+
+            // the signal may have been fired already by another channel in a select.
+            if (s->fire (source)) return;
+        }
+    }
+
+    void channel_waiters::notify_all (const void *source) {
+        std::deque<ptr<channel_signal>> signals;
+        {
+            std::lock_guard<std::mutex> lock {Mutex};
+            signals = std::move (Signals);
+            Signals.clear ();
+            Count.store (0, std::memory_order_relaxed);
+        }
+
+        for (auto &s : signals) s->fire (source);
+    }
+
+}
@@ -10,8 +10,7 @@ namespace data::net::HTTP {
         if (Session.get () == nullptr || Session->closed ())
             Session = co_await connect (version_1_1, REST.Host, SSL.get ());
 
-        std::chrono::milliseconds wait = Rate.get_time ();
-        if (wait != std::chrono::milliseconds {0}) co_await sleep (wait);
+        co_await Rate.acquire ();
         co_return co_await Session->request (r);
     }
 
@@ -3,30 +3,59 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "data/tools/rate_limiter.hpp"
+#include <boost/asio/steady_timer.hpp>
 
 namespace data {
 
+    rate_limiter::rate_limiter (size_t hits, millisecond duration) : State {} {
+        if (hits == 0 || duration <= millisecond {0}) return;
+        int64 d = std::chrono::duration_cast<std::chrono::nanoseconds> (duration).count ();
+        State = std::make_shared<state> (now (), std::max<int64> (d / int64 (hits), 1), d);
+    }
+
+    int64 rate_limiter::now () {
+        return std::chrono::duration_cast<std::chrono::nanoseconds> (clock::now ().time_since_epoch ()).count ();
+    }
+
+    std::chrono::nanoseconds rate_limiter::reserve (uint64 n) {
+        if (State == nullptr) return std::chrono::nanoseconds {0};
+
+        int64 t = now ();
+        int64 full = State->Full.load (std::memory_order_relaxed);
+        int64 next;
+        do {
+            // a bucket that has been full for a while is only full.
+            next = std::max (full, t) + int64 (n) * State->Interval;
+        } while (!State->Full.compare_exchange_weak (full, next, std::memory_order_relaxed));
+
+        // we can go once the bucket has room for n more.
+        return std::chrono::nanoseconds {std::max<int64> (next - State->Duration - t, 0)};
+    }
+
     millisecond rate_limiter::get_time () {
-        if (m_queue.size == 0) return millisecond {0};
-
-        std::scoped_lock lock (*mutex);
-
-        using namespace std::chrono;
-        if (m_duration == millisecond {0}) return millisecond {0};
-            
-        millisecond now = duration_cast<millisecond> (system_clock::now ().time_since_epoch ());
-                    
-        millisecond lastSent = m_queue.get ();
-            
-        if (now - lastSent < m_duration) {
-            millisecond wait_name = m_duration - (now - lastSent);
-            m_queue.set (now + wait_name);
-            return wait_name;
+        return std::chrono::ceil<millisecond> (reserve (1));
+    }
+
+    bool rate_limiter::try_acquire (uint64 n) {
+        if (State == nullptr) return true;
+
+        int64 t = now ();
+        int64 full = State->Full.load (std::memory_order_relaxed);
+        while (true) {
+            int64 next = std::max (full, t) + int64 (n) * State->Interval;
+            if (next - State->Duration > t) return false;
+            if (State->Full.compare_exchange_weak (full, next, std::memory_order_relaxed)) return true;
         }
+    }
 
-        m_queue.set (now);
+    awaitable<void> rate_limiter::acquire (uint64 n) {
+        std::chrono::nanoseconds wait = reserve (n);
+        if (wait == std::chrono::nanoseconds {0}) co_return;
 
-        return millisecond {0};
+        // our place in line was fixed by reserve, so waiters that
+        // reserved earlier will also wake up earlier.
+        boost::asio::steady_timer timer {co_await boost::asio::this_coro::executor};
+        timer.expires_after (wait);
+        co_await timer.async_wait (boost::asio::use_awaitable);
     }
 }
-
@@ -0,0 +1,245 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/tools/thread_pool.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace data {
+
+    namespace {
+
+        thread_local thread_pool *CurrentPool {nullptr};
+        thread_local uint32 CurrentIndex {0};
+
+        // parse a list of cpus such as "0-3,8-11".
+        std::vector<uint32> parse_cpu_list (const std::string &list) {
+            std::vector<uint32> cpus {};
+            std::stringstream ss {list};
+            std::string range;
+            while (std::getline (ss, range, ',')) {
+                if (range.empty () || range == "\n") continue;
+                size_t dash = range.find ('-');
+                try {
+                    uint32 first = std::stoul (range.substr (0, dash));
+                    uint32 last = dash == std::string::npos ? first : std::stoul (range.substr (dash + 1));
+                    for (uint32 c = first; c <= last; c++) cpus.push_back (c);
+                } catch (const std::exception &) {
+                    return {};
+                }
+            }
+
+            return cpus;
+        }
+
+        // restrict the current thread to the given cpus. Placement is only
+        // advisory, so if this fails the thread runs wherever it is put.
+        void pin (const std::vector<uint32> &cpus) {
+#ifdef __linux__
+            if (cpus.empty ()) return;
+            cpu_set_t set;
+            CPU_ZERO (&set);
+            for (uint32 c : cpus) if (c < CPU_SETSIZE) CPU_SET (c, &set);
+            pthread_setaffinity_np (pthread_self (), sizeof (set), &set);
+#endif
+        }
+
+    }
+
+    std::vector<std::vector<uint32>> numa_nodes () {
+        std::vector<std::vector<uint32>> nodes {};
+#ifdef __linux__
+        std::error_code err;
+        std::vector<std::pair<uint32, std::vector<uint32>>> found {};
+        for (const auto &entry : std::filesystem::directory_iterator {"/sys/devices/system/node", err}) {
+            std::string name = entry.path ().filename ().string ();
+            if (name.size () <= 4 || name.substr (0, 4) != "node" ||
+                !std::all_of (name.begin () + 4, name.end (), [] (char c) {
+                    return c >= '0' && c <= '9';
+                })) continue;
+
+            std::ifstream file {entry.path () / "cpulist"};
+            std::string list;
+            if (!std::getline (file, list)) continue;
+            std::vector<uint32> cpus = parse_cpu_list (list);
+            // nodes without cpus only have memory.
+            if (!cpus.empty ()) found.emplace_back (std::stoul (name.substr (4)), std::move (cpus));
+        }
+
+        std::sort (found.begin (), found.end ());
+        for (auto &[_, cpus] : found) nodes.push_back (std::move (cpus));
+#endif
+        if (nodes.empty ()) {
+            uint32 cores = std::max (std::thread::hardware_concurrency (), 1u);
+            nodes.emplace_back ();
+            for (uint32 c = 0; c < cores; c++) nodes.back ().push_back (c);
+        }
+
+        return nodes;
+    }
+
+    thread_pool::thread_pool (options o): Size {o.Threads == 0 ? 1 : o.Threads}, Queues {new queue[Size]} {
+        auto nodes = numa_nodes ();
+
+        // the node of each thread and the cpus it may run on.
+        std::vector<uint32> node (Size, 0);
+        std::vector<std::vector<uint32>> cpus (Size);
+
+        if (o.Placement == placement::cores) {
+            std::vector<std::pair<uint32, uint32>> cores {};
+            for (uint32 n = 0; n < nodes.size (); n++) for (uint32 c : nodes[n]) cores.emplace_back (n, c);
+            for (uint32 i = 0; i < Size; i++) {
+                auto [n, c] = cores[i % cores.size ()];
+                node[i] = n;
+                cpus[i] = {c};
+            }
+        } else if (o.Placement == placement::numa) for (uint32 i = 0; i < Size; i++) {
+            node[i] = i % nodes.size ();
+            cpus[i] = nodes[node[i]];
+        }
+
+        // each thread looks at the threads after it, so that
+        // thieves do not all start with the same victim.
+        for (uint32 i = 0; i < Size; i++) {
+            for (uint32 j = 1; j < Size; j++) if (node[(i + j) % Size] == node[i]) Queues[i].Victims.push_back ((i + j) % Size);
+            for (uint32 j = 1; j < Size; j++) if (node[(i + j) % Size] != node[i]) Queues[i].Victims.push_back ((i + j) % Size);
+        }
+
+        Threads.reserve (Size);
+        for (uint32 i = 0; i < Size; i++) Threads.emplace_back ([this, i, c = std::move (cpus[i])] {
+            pin (c);
+            run (i);
+        });
+    }
+
+    thread_pool::~thread_pool () {
+        stop ();
+        for (auto &t : Threads) t.join ();
+    }
+
+    thread_pool *thread_pool::current () {
+        return CurrentPool;
+    }
+
+    uint32 thread_pool::current_index () {
+        return CurrentIndex;
+    }
+
+    void thread_pool::post (function<void ()> f) {
+        if (stopped ()) return;
+
+        uint32 index = CurrentPool == this ? CurrentIndex : NextQueue.fetch_add (1, std::memory_order_relaxed) % Size;
+        Outstanding.fetch_add (1, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock {Queues[index].Mutex};
+            Queues[index].Tasks.push_back (std::move (f));
+        }
+
+        Queued.fetch_add (1, std::memory_order_seq_cst);
+
+        // a thread that is about to sleep either sees the new task or is
+        // waiting by the time we have the lock, so it cannot miss this.
+        if (Sleeping.load (std::memory_order_seq_cst) > 0) {
+            { std::lock_guard<std::mutex> lock {Mutex}; }
+            Wake.notify_one ();
+        }
+    }
+
+    void thread_pool::stop () {
+        Stopped.store (true, std::memory_order_release);
+        { std::lock_guard<std::mutex> lock {Mutex}; }
+        Wake.notify_all ();
+        Idle.notify_all ();
+    }
+
+    void thread_pool::wait () {
+        std::unique_lock<std::mutex> lock {Mutex};
+        Idle.wait (lock, [this] {
+            return stopped () || Outstanding.load (std::memory_order_acquire) == 0;
+        });
+
+        if (Error) std::rethrow_exception (Error);
+    }
+
+    void thread_pool::fail (std::exception_ptr err) {
+        {
+            std::lock_guard<std::mutex> lock {Mutex};
+            if (!Error) Error = err;
+        }
+
+        stop ();
+    }
+
+    void thread_pool::finish () {
+        Completed.fetch_add (1, std::memory_order_relaxed);
+        if (Outstanding.fetch_sub (1, std::memory_order_acq_rel) == 1) {
+            { std::lock_guard<std::mutex> lock {Mutex}; }
+            Idle.notify_all ();
+        }
+    }
+
+    bool thread_pool::take (uint32 index, function<void ()> &task) {
+        {
+            queue &q = Queues[index];
+            std::lock_guard<std::mutex> lock {q.Mutex};
+            if (!q.Tasks.empty ()) {
+                task = std::move (q.Tasks.back ());
+                q.Tasks.pop_back ();
+                Queued.fetch_sub (1, std::memory_order_seq_cst);
+                return true;
+            }
+        }
+
+        for (uint32 v : Queues[index].Victims) {
+            queue &q = Queues[v];
+            std::lock_guard<std::mutex> lock {q.Mutex};
+            if (!q.Tasks.empty ()) {
+                task = std::move (q.Tasks.front ());
+                q.Tasks.pop_front ();
+                Queued.fetch_sub (1, std::memory_order_seq_cst);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void thread_pool::run (uint32 index) {
+        CurrentPool = this;
+        CurrentIndex = index;
+
+        function<void ()> task;
+        while (!stopped ()) {
+            if (take (index, task)) {
+                try {
+                    task ();
+                } catch (...) {
+                    fail (std::current_exception ());
+                }
+
+                task = nullptr;
+                finish ();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock {Mutex};
+            Sleeping.fetch_add (1, std::memory_order_seq_cst);
+            Wake.wait (lock, [this] {
+                return stopped () || Queued.load (std::memory_order_seq_cst) > 0;
+            });
+            Sleeping.fetch_sub (1, std::memory_order_seq_cst);
+        }
+
+        CurrentPool = nullptr;
+    }
+
+}
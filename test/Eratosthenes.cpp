@@ -65,3 +65,14 @@ namespace data {
     }
 
 }
+
+namespace data {
+
+    // the sieve gives the same primes with either heap.
+    TEST (Eratosthenes, Heap) {
+        using tree_sieve = math::number::eratosthenes<uint64, priority_queue>;
+        using pairing_sieve = math::number::eratosthenes<uint64, pairing_heap>;
+        EXPECT_EQ (tree_sieve {uint64 {1000}}.Primes, pairing_sieve {uint64 {1000}}.Primes);
+    }
+
+}
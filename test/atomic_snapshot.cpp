@@ -0,0 +1,95 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/tools/synchronized.hpp>
+#include <data/map.hpp>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    TEST (AtomicSnapshot, Basic) {
+        atomic_snapshot<map<int, int>> a {};
+        EXPECT_EQ (a.version (), 0);
+        // true or false depending on the standard library, but it must be callable.
+        (void) a.is_lock_free ();
+
+        auto s = a.load ();
+        a.update ([] (const map<int, int> &m) {
+            return m.insert (1, 2);
+        });
+
+        EXPECT_EQ (a.version (), 1);
+        EXPECT_EQ (s->size (), 0);
+        EXPECT_EQ (a.load ()->size (), 1);
+        EXPECT_EQ (a ([] (const map<int, int> &m) {
+            return m[1];
+        }), 2);
+
+        atomic_snapshot<map<int, int>>::reader r {a};
+        EXPECT_EQ (r->size (), 1);
+        a.store (map<int, int> {{1, 1}, {2, 2}});
+        EXPECT_EQ (r->size (), 2);
+    }
+
+    // concurrent updates are not lost and readers see them in order.
+    TEST (AtomicSnapshot, Concurrent) {
+        atomic_snapshot<map<int, int>> a {};
+        const int writers = 4;
+        const int updates = 1000;
+
+        std::atomic<bool> done {false};
+        std::atomic<bool> ordered {true};
+        std::thread reader {[&] {
+            atomic_snapshot<map<int, int>>::reader r {a};
+            size_t last = 0;
+            while (!done) {
+                size_t z = r->size ();
+                if (z < last) ordered = false;
+                last = z;
+            }
+        }};
+
+        std::vector<std::thread> threads {};
+        for (int w = 0; w < writers; w++) threads.emplace_back ([&a, w] {
+            for (int i = 0; i < updates; i++) a.update ([w, i] (const map<int, int> &m) {
+                return m.insert (w * updates + i, i);
+            });
+        });
+
+        for (auto &t : threads) t.join ();
+        done = true;
+        reader.join ();
+
+        EXPECT_TRUE (ordered);
+        EXPECT_EQ (a.load ()->size (), writers * updates);
+        EXPECT_EQ (a.version (), writers * updates);
+    }
+
+    TEST (AtomicSnapshot, Synchronized) {
+        synchronized<map<int, int>, synchronization::read_mostly> m {};
+        std::vector<std::thread> threads {};
+        for (int w = 0; w < 4; w++) threads.emplace_back ([&m, w] {
+            for (int i = 0; i < 100; i++) m ([w, i] (map<int, int> &x) {
+                x = x.insert (w * 100 + i, i);
+            });
+        });
+
+        for (auto &t : threads) t.join ();
+
+        const auto &c = m;
+        EXPECT_EQ (c ([] (const map<int, int> &x) {
+            return x.size ();
+        }), 400);
+
+        EXPECT_EQ (m ([] (map<int, int> &x) -> size_t {
+            x = x.insert (1000, 0);
+            return x.size ();
+        }), 401);
+
+        EXPECT_EQ (m.snapshot ()->size (), 401);
+    }
+
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DATA_BENCHMARK
+#define DATA_BENCHMARK
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+// minimal timing utilities shared by the benchmarks.
+namespace data::benchmark {
+
+    using clock = std::chrono::steady_clock;
+
+    // run f once and return the elapsed time in seconds.
+    template <typename fun> double time (fun &&f) {
+        auto start = clock::now ();
+        f ();
+        return std::chrono::duration<double> (clock::now () - start).count ();
+    }
+
+    // run f repeatedly and return the best time.
+    template <typename fun> double best (size_t trials, fun &&f) {
+        double t = time (f);
+        for (size_t i = 1; i < trials; i++) t = std::min (t, time (f));
+        return t;
+    }
+
+    // prevent the compiler from optimizing away a result.
+    template <typename X> void keep (const X &x) {
+        asm volatile ("" : : "r" (&x) : "memory");
+    }
+
+    inline void header (const std::string &name) {
+        std::cout << "\n" << name << "\n" << std::string (name.size (), '-') << std::endl;
+    }
+
+    inline void row (const std::string &label, size_t n, double seconds) {
+        std::cout << "  " << std::left << std::setw (40) << label
+            << std::right << std::setw (10) << n
+            << std::setw (14) << std::fixed << std::setprecision (6) << seconds << " s"
+            << std::setw (12) << std::setprecision (2) << (seconds * 1e9 / (n == 0 ? 1 : n)) << " ns/op" << std::endl;
+    }
+
+}
+
+#endif
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Allocations and time for typical Bitcoin-sized byte strings, stored
+// in a std::vector and in a small_vector, and for arithmetic with N_bytes
+// and Z_bytes, which use whichever storage bytes is configured with.
+
+#include <data/numbers.hpp>
+#include <data/encoding/hex.hpp>
+#include "benchmark.hpp"
+#include <atomic>
+#include <new>
+#include <random>
+
+std::atomic<size_t> Allocations {0};
+
+void *operator new (size_t size) {
+    Allocations.fetch_add (1, std::memory_order_relaxed);
+    if (void *p = std::malloc (size == 0 ? 1 : size); p != nullptr) return p;
+    throw std::bad_alloc {};
+}
+
+void operator delete (void *p) noexcept {
+    std::free (p);
+}
+
+void operator delete (void *p, size_t) noexcept {
+    std::free (p);
+}
+
+using namespace data;
+
+// run f and print the time and the number of allocations per operation.
+template <typename fun> void measure (const std::string &label, size_t n, fun &&f) {
+    size_t before = Allocations.load ();
+    double seconds = benchmark::time (f);
+    size_t allocations = Allocations.load () - before;
+    benchmark::row (label, n, seconds);
+    std::cout << "    " << std::fixed << std::setprecision (2) << double (allocations) / double (n) << " allocations/op" << std::endl;
+}
+
+template <typename string> void strings (const std::string &name, const std::vector<std::array<byte, 32>> &digests) {
+    size_t n = digests.size ();
+    benchmark::header (name);
+
+    // a digest such as a txid or a private key.
+    measure ("copy 32 byte digest", n, [&] {
+        for (const auto &d : digests) {
+            string z (32);
+            std::copy (d.begin (), d.end (), z.begin ());
+            benchmark::keep (z);
+        }
+    });
+
+    // a compressed public key.
+    measure ("build 33 byte public key", n, [&] {
+        for (const auto &d : digests) {
+            string z {};
+            z.push_back (0x02);
+            z.insert (z.end (), d.begin (), d.end ());
+            benchmark::keep (z);
+        }
+    });
+
+    // a pay to address script around a 20 byte hash.
+    measure ("build 25 byte script", n, [&] {
+        for (const auto &d : digests) {
+            string z {0x76, 0xa9, 0x14};
+            z.insert (z.end (), d.begin (), d.begin () + 20);
+            z.push_back (0x88);
+            z.push_back (0xac);
+            benchmark::keep (z);
+        }
+    });
+
+    std::vector<string> keys (n);
+    for (size_t i = 0; i < n; i++) {
+        keys[i].resize (32);
+        std::copy (digests[i].begin (), digests[i].end (), keys[i].begin ());
+    }
+
+    measure ("sort 32 byte keys", n, [&] {
+        std::sort (keys.begin (), keys.end ());
+    });
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 1000000;
+
+    std::mt19937_64 random {1};
+    std::vector<std::array<byte, 32>> digests (n);
+    for (auto &d : digests) for (byte &b : d) b = byte (random ());
+
+    std::cout << "bytes stores up to " << DATA_BYTES_INLINE_CAPACITY << " bytes inline." << std::endl;
+
+    strings<cross<byte>> ("std::vector", digests);
+    strings<cross<byte, small_vector<byte, 40>>> ("small_vector<byte, 40>", digests);
+
+    std::vector<std::string> hexes (n);
+    for (size_t i = 0; i < n; i++) hexes[i] = encoding::hex::write (byte_slice {digests[i].data (), 20});
+
+    benchmark::header ("bytes");
+    measure ("read 20 byte hex", n, [&] {
+        for (const auto &h : hexes) benchmark::keep (encoding::hex::read (h));
+    });
+
+    using N = math::N_bytes<endian::little>;
+    using Z = math::Z_bytes<endian::little>;
+
+    std::vector<N> nats (n);
+    for (size_t i = 0; i < n; i++) nats[i] = N (slice<const byte> {digests[i].data (), 16});
+
+    measure ("add 16 byte N_bytes", n, [&] {
+        for (size_t i = 1; i < n; i++) benchmark::keep (nats[i] + nats[i - 1]);
+    });
+
+    measure ("multiply 16 byte N_bytes", n, [&] {
+        for (size_t i = 1; i < n; i++) benchmark::keep (nats[i] * nats[i - 1]);
+    });
+
+    std::vector<Z> ints (n);
+    for (size_t i = 0; i < n; i++) ints[i] = Z (int64 (random ()));
+
+    measure ("subtract 8 byte Z_bytes", n, [&] {
+        for (size_t i = 1; i < n; i++) benchmark::keep (ints[i] - ints[i - 1]);
+    });
+
+    return 0;
+}
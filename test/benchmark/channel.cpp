@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// throughput of channel with 1, 4 and 16 producer/consumer pairs, both
+// with coroutines on an io_context and with threads that call
+// try_send and try_receive.
+
+#include <data/channel.hpp>
+#include <thread>
+#include <vector>
+#include "benchmark.hpp"
+
+using namespace data;
+
+double run_coroutines (size_t capacity, size_t pairs, size_t n) {
+    channel<uint64> c {capacity};
+    std::atomic<size_t> finished {0};
+    size_t threads = std::min (pairs, size_t (std::max (1u, std::thread::hardware_concurrency ())));
+
+    return benchmark::time ([&] {
+        boost::asio::io_context io {};
+        for (size_t p = 0; p < pairs; p++) {
+            spawn (io.get_executor (), [&] () -> awaitable<void> {
+                for (size_t i = 0; i < n / pairs; i++) co_await c.send (i);
+                if (++finished == pairs) c.close ();
+            });
+
+            spawn (io.get_executor (), [&] () -> awaitable<void> {
+                uint64 total = 0;
+                while (true) {
+                    maybe<uint64> x = co_await c.receive ();
+                    if (!bool (x)) break;
+                    total += *x;
+                }
+
+                benchmark::keep (total);
+            });
+        }
+
+        std::vector<std::thread> pool {};
+        for (size_t t = 1; t < threads; t++) pool.emplace_back ([&io] {
+            io.run ();
+        });
+
+        io.run ();
+        for (auto &t : pool) t.join ();
+    });
+}
+
+double run_threads (size_t capacity, size_t pairs, size_t n) {
+    channel<uint64> c {capacity};
+    std::atomic<size_t> finished {0};
+
+    return benchmark::time ([&] {
+        std::vector<std::thread> threads {};
+        for (size_t p = 0; p < pairs; p++) {
+            threads.emplace_back ([&] {
+                for (size_t i = 0; i < n / pairs; i++) while (!c.try_send (i)) std::this_thread::yield ();
+                if (++finished == pairs) c.close ();
+            });
+
+            threads.emplace_back ([&] {
+                uint64 total = 0;
+                while (true) {
+                    maybe<uint64> x = c.try_receive ();
+                    if (bool (x)) total += *x;
+                    else if (c.closed ()) {
+                        // drain whatever was sent before the channel was closed.
+                        while (bool (x = c.try_receive ())) total += *x;
+                        break;
+                    } else std::this_thread::yield ();
+                }
+
+                benchmark::keep (total);
+            });
+        }
+
+        for (auto &t : threads) t.join ();
+    });
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 1000000;
+
+    for (size_t capacity : {size_t {1024}, size_t {0}}) {
+        std::string name = capacity == 0 ? "unbounded" : "capacity " + std::to_string (capacity);
+
+        benchmark::header ("channel<uint64>, " + name + ", send and receive");
+        for (size_t pairs : {1, 4, 16}) benchmark::row (std::to_string (pairs) + " pairs", n, run_coroutines (capacity, pairs, n));
+
+        benchmark::header ("channel<uint64>, " + name + ", try_send and try_receive");
+        for (size_t pairs : {1, 4, 16}) benchmark::row (std::to_string (pairs) + " pairs", n, run_threads (capacity, pairs, n));
+    }
+
+    return 0;
+}
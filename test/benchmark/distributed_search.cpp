@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// scaling of distributed::search over a key space from 1 to 64 threads,
+// comparing the locked searcher, which walks the range as a forward
+// iterator, with the work-stealing backend. The trial is a few rounds of
+// a hash function whose cost varies from key to key, so that some chunks
+// take longer than others. No key is a solution, so the whole space is
+// searched. Also measures how long it takes for a search to stop once a
+// solution has been found.
+
+#include <data/tools/distributed_search.hpp>
+#include <ranges>
+#include "benchmark.hpp"
+
+using namespace data;
+
+using key = std::ranges::iterator_t<std::ranges::iota_view<uint64, uint64>>;
+
+uint64 mix (uint64 x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    return x ^ (x >> 33);
+}
+
+// between 8 and 71 rounds, depending on the key. Since mix (0) == 0, the
+// hash is offset so that no key in the space is a solution.
+maybe<uint64> expensive (uint64 k) {
+    uint64 x = k + 1;
+    uint64 rounds = 8 + (mix (k) & 63);
+    for (uint64 i = 0; i < rounds; i++) x = mix (x);
+    if (x == 0) return k;
+    return {};
+}
+
+void report (const std::string &label, size_t threads, const distributed::progress &p) {
+    std::cout << "  " << std::left << std::setw (24) << label << std::right << std::setw (4) << threads << " threads"
+        << std::setw (12) << std::fixed << std::setprecision (3) << p.Seconds << " s"
+        << std::setw (16) << std::setprecision (0) << p.throughput () << " keys/s" << std::endl;
+}
+
+int main (int argc, char **argv) {
+    uint64 keys = argc > 1 ? std::stoull (argv[1]) : 1 << 22;
+    auto space = std::views::iota (uint64 {0}, keys);
+
+    distributed::test<uint64, key> trial = [] (const key &k) {
+        return expensive (*k);
+    };
+
+    benchmark::header ("distributed search, no solution");
+    for (uint32 threads : {1, 2, 4, 8, 16, 32, 64}) {
+        // the locked backend is selected by constructing it directly.
+        auto x = std::make_shared<distributed::searcher<uint64, key>> (space.begin (), space.end (), 10000);
+        double seconds = benchmark::time ([&] {
+            distributed::running<uint64, key> r {threads, trial, x};
+            benchmark::keep (r.wait ());
+        });
+        report ("locked", threads, distributed::progress {keys, keys, seconds});
+
+        auto s = distributed::search_in_background<uint64> (threads, trial, space.begin (), space.end ());
+        benchmark::keep (s->wait ());
+        report ("work stealing", threads, s->progress ());
+    }
+
+    // a solution in the first chunk, after which the threads should stop right away.
+    distributed::test<uint64, key> early = [] (const key &k) -> maybe<uint64> {
+        if (*k == 1000) return *k;
+        return expensive (*k);
+    };
+
+    benchmark::header ("distributed search, early solution");
+    for (uint32 threads : {1, 4, 16, 64}) {
+        auto s = distributed::search_in_background<uint64> (threads, early, space.begin (), space.end ());
+        benchmark::keep (s->wait ());
+        report ("time to stop", threads, s->progress ());
+    }
+
+    return 0;
+}
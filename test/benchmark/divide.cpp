@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Divide N_bytes of 2n bytes by n bytes, from 32 bytes to 64 kilobytes,
+// with the limb division that natural_divmod uses now and with GMP.
+//
+// The second part compares Knuth's algorithm D with the dispatching
+// division directly on limbs, which is how burnikel_ziegler_threshold
+// was chosen.
+
+#include <random>
+#include <data/numbers.hpp>
+#include <data/arithmetic/limbs.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+using namespace data::arithmetic;
+
+// the number of repetitions for operands of the given size, roughly
+// proportional to the inverse of the quadratic cost.
+size_t repetitions (size_t size) {
+    return std::max<size_t> (1, size_t (double (1 << 26) / (double (size) * size)));
+}
+
+N_bytes_little random_N_bytes (std::mt19937_64 &gen, size_t size) {
+    N_bytes_little z = N_bytes_little::zero (size);
+    for (byte &x : z) x = static_cast<byte> (gen ());
+    z[size - 1] |= 1;
+    return z;
+}
+
+int main (int argc, char **argv) {
+    size_t max = argc > 1 ? std::stoull (argv[1]) : 65536;
+
+    std::mt19937_64 gen {1};
+
+    for (size_t size = 32; size <= max; size *= 2) {
+        benchmark::header ("divide " + std::to_string (2 * size) + " bytes by " + std::to_string (size));
+        size_t reps = repetitions (size);
+
+        N_bytes_little a = random_N_bytes (gen, 2 * size);
+        N_bytes_little b = random_N_bytes (gen, size);
+
+        benchmark::row ("N_bytes, limbs", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) benchmark::keep (divmod (a, math::nonzero {b}));
+        }));
+
+        N na (a);
+        N nb (b);
+        benchmark::row ("GMP N", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) benchmark::keep (divmod (na, math::nonzero {nb}));
+        }));
+    }
+
+    for (size_t n : {8, 16, 24, 32, 48, 64, 96, 128, 192, 256, 512, 1024, 2048, 4096}) {
+        if (n * sizeof (limbs::limb) > max) break;
+        benchmark::header ("divide " + std::to_string (2 * n) + " limbs by " + std::to_string (n));
+        size_t reps = repetitions (n * sizeof (limbs::limb));
+
+        // a normalized divisor and a dividend whose top half is less than it.
+        std::vector<limbs::limb> a (2 * n);
+        std::vector<limbs::limb> b (n);
+        std::vector<limbs::limb> u (2 * n);
+        std::vector<limbs::limb> q (n);
+        for (size_t i = 0; i < n; i++) {
+            a[i] = gen ();
+            a[i + n] = gen ();
+            b[i] = gen ();
+        }
+
+        b[n - 1] |= limbs::limb {1} << (limbs::limb_bits - 1);
+        a[2 * n - 1] = 0;
+
+        benchmark::row ("knuth", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) {
+                u = a;
+                limbs::knuth (q.data (), u.data (), 2 * n, b.data (), n);
+                benchmark::keep (q);
+            }
+        }));
+
+        benchmark::row ("dispatch", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) {
+                u = a;
+                limbs::divide_normalized (q.data (), u.data (), 2 * n, b.data (), n);
+                benchmark::keep (q);
+            }
+        }));
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// compare the heaps that can be used as priority queues,
+// on their own and as the heap of the sieve of eratosthenes.
+
+#include <data/math/number/eratosthenes.hpp>
+#include <data/numbers.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+template <template <typename> class heap> void bench_heap (const std::string &name, size_t n) {
+    benchmark::header (name + "<int>");
+
+    heap<int> h {};
+    benchmark::row ("insert", n, benchmark::time ([&] {
+        for (size_t i = 0; i < n; i++) h = h.insert (int ((i * 7919) % n));
+    }));
+
+    heap<int> g {};
+    for (size_t i = 0; i < n; i++) g = g.insert (int ((i * 104729) % n));
+
+    benchmark::row ("merge", 1, benchmark::time ([&] {
+        benchmark::keep (merge (h, g));
+    }));
+
+    benchmark::row ("rest", n, benchmark::time ([&] {
+        while (!h.empty ()) h = h.rest ();
+    }));
+}
+
+template <template <typename> class heap> void bench_sieve (const std::string &name, size_t n) {
+    benchmark::header ("eratosthenes<uint64, " + name + ">");
+
+    for (size_t primes = n / 100; primes <= n; primes *= 10)
+        benchmark::row ("first " + std::to_string (primes) + " primes", primes, benchmark::time ([&] {
+            benchmark::keep (math::number::eratosthenes<uint64, heap> {uint64 (primes)});
+        }));
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 10000;
+
+    bench_heap<priority_queue> ("priority_queue", n);
+    bench_heap<pairing_heap> ("pairing_heap", n);
+
+    bench_sieve<priority_queue> ("priority_queue", n);
+    bench_sieve<pairing_heap> ("pairing_heap", n);
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// compare building a map from sorted entries with from_sorted
+// against inserting the entries one at a time.
+
+#include <data/map.hpp>
+#include <data/set.hpp>
+#include <data/cross.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+void bench (size_t n) {
+    benchmark::header ("n = " + std::to_string (n));
+
+    using entry = map<int, int>::entry;
+    std::vector<entry> entries {};
+    entries.reserve (n);
+    for (size_t i = 0; i < n; i++) entries.emplace_back (int (i), int (i));
+
+    benchmark::row ("map insert", n, benchmark::time ([&] {
+        map<int, int> m {};
+        for (const entry &e : entries) m = m.insert (e);
+        benchmark::keep (m);
+    }));
+
+    benchmark::row ("map from_sorted", n, benchmark::time ([&] {
+        benchmark::keep (map<int, int>::from_sorted (entries));
+    }));
+
+    benchmark::row ("map from_sorted_unique", n, benchmark::time ([&] {
+        benchmark::keep (map<int, int>::from_sorted_unique (entries));
+    }));
+
+    cross<int> values (n);
+    for (size_t i = 0; i < n; i++) values[i] = int (i);
+
+    benchmark::row ("set insert", n, benchmark::time ([&] {
+        set<int> x {};
+        for (int v : values) x = x.insert (v);
+        benchmark::keep (x);
+    }));
+
+    benchmark::row ("set from_sorted", n, benchmark::time ([&] {
+        benchmark::keep (set<int>::from_sorted (values));
+    }));
+}
+
+int main (int argc, char **argv) {
+    size_t max = argc > 1 ? std::stoull (argv[1]) : 1000000;
+    for (size_t n = 1000; n <= max; n *= 10) bench (n);
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// compare hash_map against map for keys that are digests.
+
+#include <data/hash_map.hpp>
+#include <data/map.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+template <typename M> void bench (const std::string &name, const std::vector<hash::digest256> &keys) {
+    benchmark::header (name);
+    size_t n = keys.size ();
+
+    M m {};
+    benchmark::row ("insert", n, benchmark::time ([&] {
+        for (size_t i = 0; i < n; i++) m = m.insert (keys[i], int (i));
+    }));
+
+    benchmark::row ("lookup", n, benchmark::best (3, [&] {
+        size_t total = 0;
+        for (const auto &k : keys) total += *m.contains (k);
+        benchmark::keep (total);
+    }));
+
+    benchmark::row ("lookup missing", n, benchmark::best (3, [&] {
+        size_t found = 0;
+        for (const auto &k : keys) {
+            hash::digest256 x = k;
+            x[31] ^= 1;
+            found += m.contains (x) != nullptr;
+        }
+        benchmark::keep (found);
+    }));
+
+    benchmark::row ("iterate", n, benchmark::best (3, [&] {
+        size_t total = 0;
+        for (const auto &e : m) total += e.Value;
+        benchmark::keep (total);
+    }));
+
+    benchmark::row ("remove", n, benchmark::time ([&] {
+        for (const auto &k : keys) m = m.remove (k);
+    }));
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 1000000;
+
+    std::mt19937_64 gen {1};
+    std::vector<hash::digest256> keys (n);
+    for (auto &k : keys) for (byte &b : k) b = byte (gen ());
+
+    bench<map<hash::digest256, int>> ("map<digest256, int>", keys);
+    bench<hash_map<hash::digest256, int>> ("hash_map<digest256, int>", keys);
+
+    return 0;
+}
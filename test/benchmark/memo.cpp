@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// a primality test by trial division, called directly and through a
+// shared memo, from several threads. Keys are drawn from a skewed
+// distribution so that some are looked up much more often than others,
+// and there are more distinct keys than the memo can hold.
+
+#include <data/tools/memo.hpp>
+#include <random>
+#include <thread>
+#include <vector>
+#include "benchmark.hpp"
+
+using namespace data;
+
+bool is_prime (const uint64 &n) {
+    if (n < 2) return false;
+    for (uint64 d = 2; d * d <= n; d++) if (n % d == 0) return false;
+    return true;
+}
+
+// keys between 2^36 and 2^36 + 2^20, mostly small offsets.
+std::vector<uint64> make_keys (size_t n, uint32 seed) {
+    std::mt19937_64 rng {seed};
+    std::geometric_distribution<uint64> offset {1.0 / 2000};
+    std::vector<uint64> keys (n);
+    for (auto &k : keys) k = (uint64 {1} << 36) + (offset (rng) & 0xfffff);
+    return keys;
+}
+
+template <typename fun> double run (size_t threads, size_t calls, fun &&f) {
+    std::vector<std::vector<uint64>> keys {};
+    for (size_t t = 0; t < threads; t++) keys.push_back (make_keys (calls, t));
+
+    return benchmark::time ([&] {
+        std::vector<std::thread> workers {};
+        for (size_t t = 0; t < threads; t++) workers.emplace_back ([&, t] {
+            for (uint64 k : keys[t]) benchmark::keep (f (k));
+        });
+
+        for (auto &w : workers) w.join ();
+    });
+}
+
+int main (int argc, char **argv) {
+    size_t calls = argc > 1 ? std::stoull (argv[1]) : 5000;
+
+    benchmark::header ("primality test with and without memo");
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        benchmark::row ("direct, " + std::to_string (threads) + " threads", threads * calls, run (threads, calls, is_prime));
+
+        memo<uint64, bool> cached {is_prime, 4096};
+        double seconds = run (threads, calls, [&cached] (uint64 k) {
+            return cached (k);
+        });
+
+        benchmark::row ("memo, " + std::to_string (threads) + " threads", threads * calls, seconds);
+        auto s = cached.stats ();
+        std::cout << "    hit rate " << std::setprecision (3) << s.hit_rate () << ", " << s.Shared
+            << " shared misses, " << s.Evictions << " evictions" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Multiplication and addition in modular<mod> for secp256k1's p and n.
+// Barrett reduction with constants computed at compile time is compared
+// to times_mod and plus_mod, which divide by the modulus.
+
+#include <random>
+#include <data/numbers.hpp>
+#include <data/math/number/modular.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+template <typename X> constexpr X uint_from_limbs (std::initializer_list<uint64> limbs) {
+    X z {0u};
+    auto w = z.words ().begin ();
+    for (uint64 x : limbs) *w++ = x;
+    return z;
+}
+
+constexpr uint256 secp256k1_p = uint_from_limbs<uint256> ({0xFFFFFFFEFFFFFC2F, ~0ull, ~0ull, ~0ull});
+constexpr uint256 secp256k1_n = uint_from_limbs<uint256> ({0xBFD25E8CD0364141, 0xBAAEDCE6AF48A03B, 0xFFFFFFFFFFFFFFFE, ~0ull});
+
+template <auto mod> void run (const std::string &name, std::mt19937_64 &gen, size_t reps) {
+    using M = math::number::modular<mod, uint256>;
+
+    benchmark::header ("modular " + name);
+
+    uint256 a, b;
+    for (uint64 &x : a.words ()) x = gen ();
+    for (uint64 &x : b.words ()) x = gen ();
+    M x {a};
+    M y {b};
+
+    math::nonzero<uint256> m {mod};
+
+    benchmark::row ("times_mod", reps, benchmark::best (3, [&] {
+        uint256 z = x.Value;
+        for (size_t i = 0; i < reps; i++) z = times_mod (z, y.Value, m);
+        benchmark::keep (z);
+    }));
+
+    benchmark::row ("modular *, Barrett", reps, benchmark::best (3, [&] {
+        M z = x;
+        for (size_t i = 0; i < reps; i++) z = z * y;
+        benchmark::keep (z);
+    }));
+
+    benchmark::row ("plus_mod", reps, benchmark::best (3, [&] {
+        uint256 z = x.Value;
+        for (size_t i = 0; i < reps; i++) z = plus_mod (z, y.Value, m);
+        benchmark::keep (z);
+    }));
+
+    benchmark::row ("modular +", reps, benchmark::best (3, [&] {
+        M z = x;
+        for (size_t i = 0; i < reps; i++) z = z + y;
+        benchmark::keep (z);
+    }));
+}
+
+int main (int argc, char **argv) {
+    size_t reps = argc > 1 ? std::stoull (argv[1]) : 100000;
+
+    std::mt19937_64 gen {1};
+    run<secp256k1_p> ("secp256k1 p", gen, reps);
+    run<secp256k1_n> ("secp256k1 n", gen, reps);
+
+    return 0;
+}
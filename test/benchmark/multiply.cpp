@@ -0,0 +1,104 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Multiply N_bytes of 32 bytes to 64 kilobytes with the old digit-by-digit
+// algorithm, with the size-dispatched limb algorithms that times uses now,
+// and with GMP. The digit-by-digit algorithm adds every partial product
+// all the way to the end of the result, so it is cubic and is only run up
+// to 512 bytes, with fewer repetitions.
+//
+// The second part compares schoolbook, Karatsuba and Toom-3 directly on
+// limbs, which is how karatsuba_threshold and toom3_threshold were chosen.
+
+#include <random>
+#include <data/numbers.hpp>
+#include <data/arithmetic/limbs.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+using namespace data::arithmetic;
+
+// the number of repetitions for operands of the given size, roughly
+// proportional to the inverse of the quadratic cost.
+size_t repetitions (size_t size) {
+    return std::max<size_t> (1, size_t (double (1 << 26) / (double (size) * size)));
+}
+
+N_bytes_little random_N_bytes (std::mt19937_64 &gen, size_t size) {
+    N_bytes_little z = N_bytes_little::zero (size);
+    for (byte &x : z) x = static_cast<byte> (gen ());
+    return z;
+}
+
+int main (int argc, char **argv) {
+    size_t max = argc > 1 ? std::stoull (argv[1]) : 65536;
+    size_t max_digits = std::min<size_t> (max, 512);
+
+    std::mt19937_64 gen {1};
+
+    for (size_t size = 32; size <= max; size *= 2) {
+        benchmark::header ("multiply " + std::to_string (size) + " bytes");
+        size_t reps = repetitions (size);
+
+        N_bytes_little a = random_N_bytes (gen, size);
+        N_bytes_little b = random_N_bytes (gen, size);
+
+        size_t digit_reps = std::max<size_t> (1, reps / size);
+        if (size <= max_digits) benchmark::row ("N_bytes, digit by digit", digit_reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < digit_reps; i++) {
+                N_bytes_little n = N_bytes_little::zero (a.size () + b.size () + 1);
+                auto w = n.words ();
+                times_schoolbook (w, a.words (), b.words ());
+                benchmark::keep (n);
+            }
+        }));
+
+        benchmark::row ("N_bytes, limbs", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) benchmark::keep (a * b);
+        }));
+
+        N na (a);
+        N nb (b);
+        benchmark::row ("GMP N", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) benchmark::keep (na * nb);
+        }));
+    }
+
+    for (size_t n : {8, 16, 24, 32, 48, 64, 96, 128, 160, 192, 256, 384, 512, 1024, 2048, 4096, 8192}) {
+        if (n * sizeof (limbs::limb) > max) break;
+        benchmark::header ("multiply " + std::to_string (n) + " limbs");
+        size_t reps = repetitions (n * sizeof (limbs::limb));
+
+        std::vector<limbs::limb> a (n);
+        std::vector<limbs::limb> b (n);
+        std::vector<limbs::limb> r (2 * n);
+        for (size_t i = 0; i < n; i++) {
+            a[i] = gen ();
+            b[i] = gen ();
+        }
+
+        benchmark::row ("schoolbook", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) {
+                limbs::schoolbook (r.data (), a.data (), n, b.data (), n);
+                benchmark::keep (r);
+            }
+        }));
+
+        benchmark::row ("karatsuba", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) {
+                limbs::karatsuba (r.data (), a.data (), b.data (), n);
+                benchmark::keep (r);
+            }
+        }));
+
+        benchmark::row ("toom3", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) {
+                limbs::toom3 (r.data (), a.data (), b.data (), n);
+                benchmark::keep (r);
+            }
+        }));
+    }
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// compare node storage policies for linked_stack and linked_tree.
+
+#include <data/stack.hpp>
+#include <data/map.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+template <typename alloc> void bench_stack (const std::string &name, size_t n) {
+    benchmark::header ("stack<int, " + name + ">");
+
+    linked_stack<int, alloc> s {};
+    benchmark::row ("prepend", n, benchmark::time ([&] {
+        for (size_t i = 0; i < n; i++) s >>= int (i);
+    }));
+
+    benchmark::row ("iterate", n, benchmark::time ([&] {
+        size_t total = 0;
+        for (int x : s) total += x;
+        benchmark::keep (total);
+    }));
+
+    benchmark::row ("copy and drop", n, benchmark::time ([&] {
+        auto z = s;
+        for (size_t i = 0; i < n; i++) z = z.rest ();
+        benchmark::keep (z);
+    }));
+
+    benchmark::row ("destroy", n, benchmark::time ([&] {
+        s = linked_stack<int, alloc> {};
+    }));
+}
+
+template <typename alloc> void bench_map (const std::string &name, size_t n) {
+    benchmark::header ("map<int, int, " + name + ">");
+
+    using entry = data::entry<const int, int>;
+    using map = binary_search_map<int, int, RB::tree<entry, linked_tree<RB::colored<entry>, alloc>>>;
+
+    map m {};
+    benchmark::row ("insert", n, benchmark::time ([&] {
+        for (size_t i = 0; i < n; i++) m = m.insert (int ((i * 7919) % n), int (i));
+    }));
+
+    benchmark::row ("iterate", n, benchmark::time ([&] {
+        size_t total = 0;
+        for (const auto &e : m) total += e.Value;
+        benchmark::keep (total);
+    }));
+
+    benchmark::row ("destroy", n, benchmark::time ([&] {
+        m = map {};
+    }));
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 10000000;
+
+    bench_stack<pool::shared> ("shared", n);
+    bench_stack<pool::concurrent> ("concurrent", n);
+    bench_stack<pool::local> ("local", n);
+
+    size_t m = n / 10;
+    bench_map<pool::shared> ("shared", m);
+    bench_map<pool::concurrent> ("concurrent", m);
+    bench_map<pool::local> ("local", m);
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// lift and fold over a million records, sequentially and with
+// parallel_lift and parallel_fold on 1 to 16 threads, for a cross
+// and for a list. fold only works on a list, so both folds are
+// compared on a list. lift on a list recurses once per element, so run
+// this with a large stack, e.g. ulimit -s unlimited.
+
+#include <data/parallel.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+struct record {
+    uint64 Key;
+    uint64 Value;
+};
+
+// a few hundred nanoseconds of work per record.
+uint64 process (const record &r) {
+    uint64 x = r.Key ^ r.Value;
+    for (int i = 0; i < 100; i++) x = x * 6364136223846793005ull + 1442695040888963407ull;
+    return x;
+}
+
+uint64 sum (uint64 a, uint64 b) {
+    return a + b;
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 1000000;
+
+    cross<record> c (n);
+    list<record> l {};
+    for (size_t i = 0; i < n; i++) {
+        c[i] = record {i, i * 7919};
+        l <<= c[i];
+    }
+
+    benchmark::header ("cross of " + std::to_string (n) + " records");
+    benchmark::row ("lift", n, benchmark::time ([&] {
+        benchmark::keep (lift (process, c));
+    }));
+
+    for (uint32 threads : {1, 2, 4, 8, 16}) {
+        thread_pool pool {threads};
+        benchmark::row ("parallel_lift, " + std::to_string (threads) + " threads", n, benchmark::time ([&] {
+            benchmark::keep (parallel_lift (pool, process, c));
+        }));
+    }
+
+    benchmark::header ("list of " + std::to_string (n) + " records");
+    benchmark::row ("lift", n, benchmark::time ([&] {
+        benchmark::keep (lift (process, l));
+    }));
+
+    for (uint32 threads : {1, 2, 4, 8, 16}) {
+        thread_pool pool {threads};
+        benchmark::row ("parallel_lift, " + std::to_string (threads) + " threads", n, benchmark::time ([&] {
+            benchmark::keep (parallel_lift (pool, process, l));
+        }));
+    }
+
+    auto processed = lift (process, l);
+    benchmark::row ("fold", n, benchmark::time ([&] {
+        benchmark::keep (fold (sum, uint64 {0}, processed));
+    }));
+
+    for (uint32 threads : {1, 2, 4, 8, 16}) {
+        thread_pool pool {threads};
+        benchmark::row ("parallel_fold, " + std::to_string (threads) + " threads", n, benchmark::time ([&] {
+            benchmark::keep (parallel_fold (pool, sum, uint64 {0}, processed));
+        }));
+    }
+
+    return 0;
+}
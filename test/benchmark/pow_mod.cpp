@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Modular exponentiation with an odd modulus and an exponent of the same
+// size, from 256 to 4096 bits. We compare the square-and-multiply algorithm
+// that N_bytes used before, with a division after every multiplication, to
+// Montgomery multiplication with sliding windows and to GMP.
+//
+// The last part times uint256 for 256-bit moduli.
+
+#include <random>
+#include <data/numbers.hpp>
+#include <data/math/number/montgomery.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+// the number of repetitions for operands of the given size, roughly
+// proportional to the inverse of the cubic cost.
+size_t repetitions (size_t size) {
+    return std::max<size_t> (1, size_t (double (1ull << 31) / (double (size) * size * size)));
+}
+
+N_bytes_little random_N_bytes (std::mt19937_64 &gen, size_t size) {
+    N_bytes_little z = N_bytes_little::zero (size);
+    for (byte &x : z) x = static_cast<byte> (gen ());
+    z[size - 1] |= 0x80;
+    return z;
+}
+
+uint256 random_uint256 (std::mt19937_64 &gen) {
+    uint256 z;
+    for (uint64 &x : z.words ()) x = gen ();
+    return z;
+}
+
+int main (int argc, char **argv) {
+    size_t max = argc > 1 ? std::stoull (argv[1]) : 512;
+
+    std::mt19937_64 gen {1};
+
+    for (size_t size = 32; size <= max; size *= 2) {
+        benchmark::header ("pow_mod " + std::to_string (size * 8) + " bits");
+        size_t reps = repetitions (size);
+
+        N_bytes_little x = random_N_bytes (gen, size);
+        N_bytes_little y = random_N_bytes (gen, size);
+        N_bytes_little m = random_N_bytes (gen, size);
+        m[0] |= 1;
+        math::nonzero<N_bytes_little> z {m};
+
+        // this is much slower, so we do it fewer times.
+        size_t slow = std::max<size_t> (1, reps / 32);
+        if (size <= 128) benchmark::row ("N_bytes, square and multiply", slow, benchmark::best (1, [&] {
+            for (size_t i = 0; i < slow; i++) benchmark::keep (math::binary_accumulate_pow_mod (x, y, z));
+        }));
+
+        benchmark::row ("N_bytes, Montgomery", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) benchmark::keep (pow_mod (x, y, z));
+        }));
+
+        math::number::montgomery_context<N_bytes_little> context {z};
+        benchmark::row ("N_bytes, reused montgomery_context", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) benchmark::keep (context.pow_mod (x, y));
+        }));
+
+        N nx (x);
+        N ny (y);
+        math::nonzero<N> nz {N (m)};
+        benchmark::row ("GMP N", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) benchmark::keep (pow_mod (nx, ny, nz));
+        }));
+    }
+
+    {
+        benchmark::header ("pow_mod uint256");
+        size_t reps = repetitions (32);
+
+        uint256 x = random_uint256 (gen);
+        uint256 y = random_uint256 (gen);
+        uint256 m = random_uint256 (gen);
+        m |= 1;
+        math::nonzero<uint256> z {m};
+
+        benchmark::row ("uint256, Montgomery", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) benchmark::keep (pow_mod (x, y, z));
+        }));
+
+        benchmark::row ("uint256, times_mod", reps, benchmark::best (3, [&] {
+            for (size_t i = 0; i < reps; i++) benchmark::keep (times_mod (x, y, z));
+        }));
+    }
+
+    return 0;
+}
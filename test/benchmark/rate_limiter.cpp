@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// contended throughput of rate_limiter, compared with the limiter that it
+// replaced, which kept a lock and a circular buffer of the last 'hits'
+// times. The limit is 100000 per second, which every thread exceeds, so
+// this measures the cost of bookkeeping rather than of waiting.
+
+#include <data/tools/rate_limiter.hpp>
+#include <data/tools/circular_queue.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "benchmark.hpp"
+
+using namespace data;
+
+// the previous implementation.
+struct locked_rate_limiter {
+    locked_rate_limiter (size_t hits, millisecond duration) : Queue (hits), Duration (duration) {}
+
+    millisecond get_time () {
+        std::scoped_lock lock (Mutex);
+
+        using namespace std::chrono;
+        millisecond now = duration_cast<millisecond> (system_clock::now ().time_since_epoch ());
+        millisecond last = Queue.get ();
+
+        if (now - last < Duration) {
+            millisecond wait = Duration - (now - last);
+            Queue.set (now + wait);
+            return wait;
+        }
+
+        Queue.set (now);
+        return millisecond {0};
+    }
+
+private:
+    tools::circular_queue<millisecond> Queue;
+    millisecond Duration;
+    std::mutex Mutex;
+};
+
+template <typename fun> double calls_per_second (size_t threads, size_t calls, fun &&f) {
+    double seconds = benchmark::time ([&] {
+        std::vector<std::thread> workers {};
+        for (size_t t = 0; t < threads; t++) workers.emplace_back ([&] {
+            for (size_t i = 0; i < calls; i++) benchmark::keep (f ());
+        });
+
+        for (auto &w : workers) w.join ();
+    });
+
+    return threads * calls / seconds;
+}
+
+void report (const std::string &label, size_t threads, double per_second) {
+    std::cout << "  " << std::left << std::setw (40) << label << std::right << std::setw (4) << threads << " threads"
+        << std::setw (16) << std::fixed << std::setprecision (0) << per_second << " calls/s" << std::endl;
+}
+
+int main (int argc, char **argv) {
+    size_t calls = argc > 1 ? std::stoull (argv[1]) : 1000000;
+    constexpr size_t hits = 100000;
+    constexpr millisecond duration {1000};
+
+    benchmark::header ("contended get_time, 100000 per second");
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        locked_rate_limiter old {hits, duration};
+        report ("mutex and circular buffer", threads, calls_per_second (threads, calls, [&] {
+            return old.get_time ();
+        }));
+
+        rate_limiter gcra {hits, duration};
+        report ("GCRA", threads, calls_per_second (threads, calls, [&] {
+            return gcra.get_time ();
+        }));
+    }
+
+    benchmark::header ("contended try_acquire");
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        rate_limiter gcra {hits, duration};
+        report ("GCRA", threads, calls_per_second (threads, calls, [&] {
+            return gcra.try_acquire ();
+        }));
+    }
+
+    benchmark::header ("per key, 64 keys");
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        rate_limiters<int> limiters {hits, duration};
+        std::atomic<int> next {0};
+        report ("rate_limiters<int>", threads, calls_per_second (threads, calls, [&] {
+            return limiters.try_acquire (next.fetch_add (1, std::memory_order_relaxed) & 63);
+        }));
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// compare the latency of individual operations on functional_queue
+// and realtime_queue. The total time is similar but functional_queue
+// has occasional O(n) operations, which realtime_queue avoids.
+
+#include <data/list.hpp>
+#include <algorithm>
+#include <vector>
+#include "benchmark.hpp"
+
+using namespace data;
+
+// print the distribution of the latencies of individual operations.
+void latencies (const std::string &label, std::vector<double> &t) {
+    std::sort (t.begin (), t.end ());
+    auto at = [&] (double p) -> double {
+        return t[std::min (t.size () - 1, size_t (p * t.size ()))] * 1e9;
+    };
+
+    std::cout << "  " << std::left << std::setw (40) << label << std::right << std::fixed << std::setprecision (0)
+        << "  p50 " << std::setw (8) << at (.5) << " ns"
+        << "  p99 " << std::setw (8) << at (.99) << " ns"
+        << "  p99.9 " << std::setw (8) << at (.999) << " ns"
+        << "  p99.99 " << std::setw (10) << at (.9999) << " ns"
+        << "  max " << std::setw (12) << t.back () * 1e9 << " ns" << std::endl;
+}
+
+template <typename queue> void bench (const std::string &name, size_t n) {
+    benchmark::header (name);
+
+    // fill the queue by appending, which puts everything on the back of a functional_queue.
+    queue q {};
+    std::vector<double> t (n);
+    for (size_t i = 0; i < n; i++) t[i] = benchmark::time ([&] {
+        q <<= int (i);
+    });
+
+    latencies ("append", t);
+
+    // take rest of the same shared queue repeatedly, as several
+    // readers of a persistent queue would.
+    size_t shared = std::min (n, size_t (100));
+    t.resize (shared);
+    for (size_t i = 0; i < shared; i++) t[i] = benchmark::time ([&] {
+        benchmark::keep (q.rest ());
+    });
+
+    latencies ("rest of shared queue", t);
+
+    // drain the queue while appending, one rest for each append.
+    t.resize (n);
+    for (size_t i = 0; i < n; i++) t[i] = benchmark::time ([&] {
+        q = q.rest () << int (i);
+    });
+
+    latencies ("rest and append", t);
+
+    benchmark::row ("drain", n, benchmark::time ([&] {
+        while (!q.empty ()) q = q.rest ();
+    }));
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 1000000;
+
+    for (size_t size : {n / 10, n}) {
+        bench<list<int>> ("functional_queue, " + std::to_string (size), size);
+        bench<list<int, realtime_queue>> ("realtime_queue, " + std::to_string (size), size);
+    }
+
+    return 0;
+}
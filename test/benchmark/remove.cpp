@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// compare removal from a red-black tree against rebuilding the tree
+// without the removed element, which is what remove used to do.
+
+#include <data/map.hpp>
+#include <data/set.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+set<int> rebuild_without (const set<int> &x, int v) {
+    set<int> result {};
+    for (int y : x) if (y != v) result = result.insert (y);
+    return result;
+}
+
+void bench (size_t n) {
+    benchmark::header ("n = " + std::to_string (n));
+
+    set<int> x {};
+    for (size_t i = 0; i < n; i++) x = x.insert (int ((i * 7919) % n));
+
+    map<int, int> m {};
+    for (size_t i = 0; i < n; i++) m = m.insert (int ((i * 7919) % n), int (i));
+
+    size_t k = std::min (n, size_t {1000});
+
+    benchmark::row ("set remove", k, benchmark::time ([&] {
+        for (size_t i = 0; i < k; i++) benchmark::keep (x.remove (int ((i * 104729) % n)));
+    }));
+
+    benchmark::row ("map remove", k, benchmark::time ([&] {
+        for (size_t i = 0; i < k; i++) benchmark::keep (m.remove (int ((i * 104729) % n)));
+    }));
+
+    // rebuilding is linear in n so only do a few.
+    size_t r = std::max (size_t {1}, k / 100);
+    benchmark::row ("set rebuild", r, benchmark::time ([&] {
+        for (size_t i = 0; i < r; i++) benchmark::keep (rebuild_without (x, int ((i * 104729) % n)));
+    }));
+
+    benchmark::row ("remove all", n, benchmark::time ([&] {
+        auto z = x;
+        for (size_t i = 0; i < n; i++) z = z.remove (int (i));
+        benchmark::keep (z);
+    }));
+}
+
+int main (int argc, char **argv) {
+    size_t max = argc > 1 ? std::stoull (argv[1]) : 1000000;
+    for (size_t n = 1000; n <= max; n *= 10) bench (n);
+    return 0;
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Serialize messages made of many small writes, the way a transaction or a
+// network message is written, into bytes with lazy_writer, into a rope that
+// is never flattened, and into a growing std::vector that is then copied
+// into bytes.
+
+#include <data/bytes.hpp>
+#include <data/tools/rope.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+// collect everything in one vector and copy it into the result.
+struct vector_writer final : writer<byte> {
+    std::vector<byte> Vector {};
+
+    void write (const byte *b, size_t size) final override {
+        Vector.insert (Vector.end (), b, b + size);
+    }
+};
+
+// a message of about the given size made of fields of a few bytes each.
+void serialize (writer<byte> &w, size_t size) {
+    byte field[36] {};
+    for (size_t written = 0; written < size;) {
+        w << uint32_little (written);
+        w.write (field, 36);
+        w << byte (0xff);
+        written += 41;
+    }
+}
+
+int main (int argc, char **argv) {
+    size_t total = argc > 1 ? std::stoull (argv[1]) : 100000000;
+
+    for (size_t size : {250, 4000, 1000000}) {
+        size_t messages = std::max<size_t> (total / size, 1);
+        benchmark::header (std::to_string (messages) + " messages of " + std::to_string (size) + " bytes");
+
+        benchmark::row ("lazy_writer into bytes", messages, benchmark::best (3, [&] {
+            for (size_t i = 0; i < messages; i++) benchmark::keep (write<bytes> ([size] (auto &&w) {
+                serialize (w, size);
+            }));
+        }));
+
+        benchmark::row ("rope", messages, benchmark::best (3, [&] {
+            for (size_t i = 0; i < messages; i++) {
+                rope<byte> r {};
+                serialize (r, size);
+                benchmark::keep (r);
+            }
+        }));
+
+        benchmark::row ("std::vector copied into bytes", messages, benchmark::best (3, [&] {
+            for (size_t i = 0; i < messages; i++) {
+                vector_writer w {};
+                serialize (w, size);
+                benchmark::keep (bytes {std::move (w.Vector)});
+            }
+        }));
+    }
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// compare rrb_vector with list for random access and concatenation.
+
+#include <data/list.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+template <typename L> L make (size_t n) {
+    L x {};
+    for (size_t i = 0; i < n; i++) x = x << int (i);
+    return x;
+}
+
+template <typename L> void bench (const std::string &name, size_t n) {
+    benchmark::header (name);
+
+    L x {};
+    benchmark::row ("append", n, benchmark::time ([&] {
+        x = make<L> (n);
+    }));
+
+    benchmark::row ("iterate", n, benchmark::best (5, [&] {
+        size_t total = 0;
+        for (int z : x) total += z;
+        benchmark::keep (total);
+    }));
+
+    // list indexing is linear, so do fewer lookups.
+    size_t m = std::min (n, size_t {1000});
+    benchmark::row ("operator []", m, benchmark::time ([&] {
+        size_t total = 0;
+        for (size_t i = 0; i < m; i++) total += x[(i * 7919) % n];
+        benchmark::keep (total);
+    }));
+
+    // concatenate many short sequences.
+    L short_piece = make<L> (100);
+    size_t pieces = n / 100;
+    benchmark::row ("concatenate short", pieces, benchmark::time ([&] {
+        L z {};
+        for (size_t i = 0; i < pieces; i++) z = z + short_piece;
+        benchmark::keep (z);
+    }));
+
+    // concatenate two long sequences.
+    benchmark::row ("concatenate long", 1, benchmark::time ([&] {
+        benchmark::keep (x + x);
+    }));
+
+    benchmark::row ("take and drop half", 1, benchmark::time ([&] {
+        benchmark::keep (take (x, n / 2));
+        benchmark::keep (drop (x, n / 2));
+    }));
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 100000;
+
+    bench<list<int>> ("list<int>", n);
+    bench<rrb_vector<int>> ("rrb_vector<int>", n);
+
+    return 0;
+}
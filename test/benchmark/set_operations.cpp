@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// set operations on large sets with split/join, with and without threads,
+// compared to walking both sets and inserting one element at a time.
+
+#include <data/set.hpp>
+#include <thread>
+#include "benchmark.hpp"
+
+using namespace data;
+
+set<int> build (size_t n, int stride, int offset) {
+    std::vector<int> v {};
+    v.reserve (n);
+    for (size_t i = 0; i < n; i++) v.push_back (int (i) * stride + offset);
+    return set<int>::from_sorted_unique (v);
+}
+
+// what intersection used to do.
+set<int> elementwise_intersect (const set<int> &a, const set<int> &b) {
+    auto i = a.begin ();
+    auto j = b.begin ();
+    set<int> result {};
+    while (i != a.end () && j != b.end ())
+        if (*i < *j) i++;
+        else if (*j < *i) j++;
+        else {
+            result = result.insert (*i);
+            i++;
+            j++;
+        }
+    return result;
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 2000000;
+    uint32 max_threads = std::max (1u, std::thread::hardware_concurrency ());
+
+    // a and b overlap in a third of their elements.
+    set<int> a = build (n, 2, 0);
+    set<int> b = build (n, 3, 0);
+    set<int> small = build (n / 1000, 3000, 1);
+
+    auto keep = [] (int x, int) -> int { return x; };
+
+    benchmark::header ("n = " + std::to_string (n));
+    benchmark::row ("elementwise intersect", n, benchmark::time ([&] {
+        benchmark::keep (elementwise_intersect (a, b));
+    }));
+
+    for (uint32 threads = 1; threads <= max_threads; threads *= 2) {
+        RB::parallel p {threads};
+        std::string t = " (" + std::to_string (threads) + " threads)";
+
+        benchmark::row ("merge" + t, n, benchmark::time ([&] {
+            benchmark::keep (RB::merge (a, b, keep, p));
+        }));
+
+        benchmark::row ("intersect" + t, n, benchmark::time ([&] {
+            benchmark::keep (RB::intersect (a, b, keep, p));
+        }));
+
+        benchmark::row ("difference" + t, n, benchmark::time ([&] {
+            benchmark::keep (RB::difference (a, b, p));
+        }));
+
+        benchmark::row ("symmetric difference" + t, n, benchmark::time ([&] {
+            benchmark::keep (RB::symmetric_difference (a, b, p));
+        }));
+    }
+
+    // when one set is much smaller, the work depends mainly on the smaller set.
+    benchmark::row ("intersect with small set", small.size (), benchmark::time ([&] {
+        benchmark::keep (RB::intersect (small, a, keep));
+    }));
+
+    benchmark::row ("merge with small set", small.size (), benchmark::time ([&] {
+        benchmark::keep (RB::merge (a, small, keep));
+    }));
+
+    return 0;
+}
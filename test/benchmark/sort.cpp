@@ -0,0 +1,58 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// the functional merge_sort of a list compared with sorting the same list
+// through a contiguous buffer on 1 to 16 threads, and parallel_sort of a
+// cross compared with std::sort. The functional sort is only run up to
+// 10^6 elements because it takes too long beyond that. It recurses once
+// per element, so run this with a large stack, e.g. ulimit -s unlimited.
+
+#include <data/list.hpp>
+#include <data/cross.hpp>
+#include <data/sort.hpp>
+#include <random>
+#include "benchmark.hpp"
+
+using namespace data;
+
+int main (int argc, char **argv) {
+    size_t max = argc > 1 ? std::stoull (argv[1]) : 10000000;
+    size_t max_functional = std::min<size_t> (max, 1000000);
+
+    std::mt19937_64 rng {1};
+
+    for (size_t n = 100000; n <= max; n *= 10) {
+        benchmark::header ("sort " + std::to_string (n) + " elements");
+
+        list<uint64> l {};
+        cross<uint64> c (n);
+        for (size_t i = 0; i < n; i++) {
+            c[i] = rng ();
+            l <<= c[i];
+        }
+
+        if (n <= max_functional) benchmark::row ("list, functional merge_sort", n, benchmark::time ([&] {
+            benchmark::keep (merge_sort (l));
+        }));
+
+        for (uint32 threads : {1, 2, 4, 8, 16}) {
+            benchmark::row ("list, " + std::to_string (threads) + " threads", n, benchmark::time ([&] {
+                benchmark::keep (sort (l, threads));
+            }));
+        }
+
+        benchmark::row ("cross, std::sort", n, benchmark::best (3, [&] {
+            benchmark::keep (sort (c));
+        }));
+
+        for (uint32 threads : {2, 4, 8, 16}) {
+            thread_pool pool {threads - 1};
+            benchmark::row ("cross, parallel_sort, " + std::to_string (threads) + " threads", n, benchmark::best (3, [&] {
+                benchmark::keep (sort (c, pool));
+            }));
+        }
+    }
+
+    return 0;
+}
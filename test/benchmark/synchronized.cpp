@@ -0,0 +1,111 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// read/write scaling of a shared map behind synchronized, in locked and
+// read-mostly mode, and behind an atomic_snapshot read through a reader.
+// One writer thread inserts continuously while the readers look up keys.
+
+#include <data/tools/synchronized.hpp>
+#include <data/map.hpp>
+#include <thread>
+#include <vector>
+#include "benchmark.hpp"
+
+using namespace data;
+
+using table = map<int, int>;
+
+constexpr int keys = 1000;
+
+table make_table () {
+    table t {};
+    for (int i = 0; i < keys; i++) t = t.insert (i, i);
+    return t;
+}
+
+// run read on each of the reader threads and write on one other thread
+// and return the total number of reads per second.
+template <typename read, typename write>
+double run (size_t threads, size_t reads, read &&r, write &&w) {
+    std::atomic<bool> done {false};
+    std::thread writer {[&] {
+        int i = 0;
+        while (!done) w (keys + i++ % keys);
+    }};
+
+    double seconds = benchmark::time ([&] {
+        std::vector<std::thread> readers {};
+        for (size_t t = 0; t < threads; t++) readers.emplace_back ([&, t] {
+            r (t, reads);
+        });
+
+        for (auto &x : readers) x.join ();
+    });
+
+    done = true;
+    writer.join ();
+    return threads * reads / seconds;
+}
+
+void report (const std::string &label, size_t threads, double per_second) {
+    std::cout << "  " << std::left << std::setw (40) << label << std::right << std::setw (4) << threads << " threads"
+        << std::setw (16) << std::fixed << std::setprecision (0) << per_second << " reads/s" << std::endl;
+}
+
+int main (int argc, char **argv) {
+    size_t reads = argc > 1 ? std::stoull (argv[1]) : 200000;
+
+    auto insert = [] (int k) {
+        return [k] (table &t) {
+            t = t.insert (k, k, [] (int, int n) {
+                return n;
+            });
+        };
+    };
+
+    auto lookup = [] (size_t t, size_t i) {
+        return [k = int ((t * 7919 + i) % keys)] (const table &m) {
+            return m[k];
+        };
+    };
+
+    benchmark::header ("synchronized<map<int, int>>");
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        synchronized<table> s {make_table ()};
+        const auto &c = s;
+        report ("locked", threads, run (threads, reads, [&] (size_t t, size_t n) {
+            for (size_t i = 0; i < n; i++) benchmark::keep (c (lookup (t, i)));
+        }, [&] (int k) {
+            s (insert (k));
+        }));
+    }
+
+    benchmark::header ("synchronized<map<int, int>, read_mostly>");
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        synchronized<table, synchronization::read_mostly> s {make_table ()};
+        const auto &c = s;
+        report ("read mostly", threads, run (threads, reads, [&] (size_t t, size_t n) {
+            for (size_t i = 0; i < n; i++) benchmark::keep (c (lookup (t, i)));
+        }, [&] (int k) {
+            s (insert (k));
+        }));
+    }
+
+    benchmark::header ("atomic_snapshot<map<int, int>>::reader");
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        atomic_snapshot<table> s {make_table ()};
+        report ("reader", threads, run (threads, reads, [&] (size_t t, size_t n) {
+            atomic_snapshot<table>::reader r {s};
+            for (size_t i = 0; i < n; i++) benchmark::keep (lookup (t, i) (*r));
+        }, [&] (int k) {
+            s.update ([k] (const table &m) {
+                return m.insert (k, k, [] (int, int n) {
+                    return n;
+                });
+            });
+        }));
+    }
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// task throughput of thread_pool as threads are added, for small tasks
+// posted from outside the pool and for a tree of tasks that post their
+// own children, which is where work stealing matters.
+
+#include <data/tools/thread_pool.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+// a little work so that a task is not only overhead.
+uint64 work (uint64 x) {
+    for (int i = 0; i < 64; i++) x = x * 6364136223846793005ull + 1442695040888963407ull;
+    return x;
+}
+
+void report (const std::string &label, uint32 threads, uint64 tasks, double seconds) {
+    std::cout << "  " << std::left << std::setw (24) << label << std::right << std::setw (4) << threads << " threads"
+        << std::setw (12) << std::fixed << std::setprecision (3) << seconds << " s"
+        << std::setw (16) << std::setprecision (0) << tasks / seconds << " tasks/s" << std::endl;
+}
+
+int main (int argc, char **argv) {
+    uint64 tasks = argc > 1 ? std::stoull (argv[1]) : 1 << 20;
+    int depth = std::bit_width (tasks) - 1;
+
+    std::cout << numa_nodes ().size () << " NUMA nodes, " << std::thread::hardware_concurrency () << " cores" << std::endl;
+
+    for (placement p : {placement::none, placement::cores, placement::numa}) {
+        benchmark::header (p == placement::none ? "no placement" : p == placement::cores ? "pinned to cores" : "NUMA placement");
+        for (uint32 threads : {1, 2, 4, 8, 16, 32, 64}) {
+            thread_pool pool {thread_pool::options {threads, p}};
+            std::atomic<uint64> sum {0};
+
+            double seconds = benchmark::time ([&] {
+                for (uint64 i = 0; i < tasks; i++) pool.post ([&sum, i] {
+                    sum.fetch_add (work (i), std::memory_order_relaxed);
+                });
+
+                pool.wait ();
+            });
+
+            report ("posted from outside", threads, tasks, seconds);
+
+            function<void (int)> tree = [&] (int d) {
+                sum.fetch_add (work (d), std::memory_order_relaxed);
+                if (d > 0) for (int i = 0; i < 2; i++) pool.post ([&tree, d] {
+                    tree (d - 1);
+                });
+            };
+
+            uint64 before = pool.completed ();
+            seconds = benchmark::time ([&] {
+                pool.post ([&tree, depth] {
+                    tree (depth);
+                });
+
+                pool.wait ();
+            });
+
+            report ("fork tree", threads, pool.completed () - before, seconds);
+            benchmark::keep (sum);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// compare building structures with persistent operations against transients.
+
+#include <data/list.hpp>
+#include <data/map.hpp>
+#include <data/set.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+
+void bench_stack (size_t n) {
+    benchmark::header ("stack<int>");
+
+    benchmark::row ("prepend and reverse", n, benchmark::time ([&] {
+        stack<int> s {};
+        for (size_t i = 0; i < n; i++) s >>= int (i);
+        benchmark::keep (reverse (s));
+    }));
+
+    benchmark::row ("transient append", n, benchmark::time ([&] {
+        stack<int>::transient s {};
+        for (size_t i = 0; i < n; i++) s.append (int (i));
+        benchmark::keep (s.freeze ());
+    }));
+}
+
+void bench_list (size_t n) {
+    benchmark::header ("list<int>");
+
+    benchmark::row ("append", n, benchmark::time ([&] {
+        list<int> l {};
+        for (size_t i = 0; i < n; i++) l <<= int (i);
+        benchmark::keep (l);
+    }));
+
+    benchmark::row ("transient append", n, benchmark::time ([&] {
+        list<int>::transient l {};
+        for (size_t i = 0; i < n; i++) l <<= int (i);
+        benchmark::keep (l.freeze ());
+    }));
+}
+
+void bench_map (size_t n) {
+    benchmark::header ("map<int, int>");
+
+    benchmark::row ("insert", n, benchmark::time ([&] {
+        map<int, int> m {};
+        for (size_t i = 0; i < n; i++) m = m.insert (int ((i * 7919) % n), int (i));
+        benchmark::keep (m);
+    }));
+
+    benchmark::row ("transient insert", n, benchmark::time ([&] {
+        map<int, int>::transient m {};
+        for (size_t i = 0; i < n; i++) m.insert (int ((i * 7919) % n), int (i));
+        benchmark::keep (m.freeze ());
+    }));
+
+    map<int, int> m {};
+    for (size_t i = 0; i < n; i++) m = m.insert (int (i), int (i));
+
+    benchmark::row ("select half", n, benchmark::time ([&] {
+        benchmark::keep (select (m, [] (int v) {
+            return v % 2 == 0;
+        }));
+    }));
+}
+
+void bench_set (size_t n) {
+    benchmark::header ("set<int>");
+
+    benchmark::row ("insert", n, benchmark::time ([&] {
+        set<int> s {};
+        for (size_t i = 0; i < n; i++) s = s.insert (int ((i * 7919) % n));
+        benchmark::keep (s);
+    }));
+
+    benchmark::row ("transient insert", n, benchmark::time ([&] {
+        set<int>::transient s {};
+        for (size_t i = 0; i < n; i++) s.insert (int ((i * 7919) % n));
+        benchmark::keep (s.freeze ());
+    }));
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 1000000;
+
+    bench_stack (n);
+    bench_list (n);
+    bench_map (n);
+    bench_set (n);
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// compare linked_stack with unrolled_stack.
+
+#include <new>
+#include <cstdlib>
+#include <data/stack.hpp>
+#include "benchmark.hpp"
+
+// count heap usage so that we can report memory per element.
+static size_t Allocated = 0;
+
+void *operator new (size_t z) {
+    Allocated += z;
+    if (void *p = std::malloc (z)) return p;
+    throw std::bad_alloc {};
+}
+
+void operator delete (void *p) noexcept {
+    std::free (p);
+}
+
+void operator delete (void *p, size_t z) noexcept {
+    Allocated -= z;
+    std::free (p);
+}
+
+using namespace data;
+
+template <typename stack> void bench (const std::string &name, size_t n) {
+    benchmark::header (name);
+
+    size_t before = Allocated;
+    stack s {};
+    benchmark::row ("prepend", n, benchmark::time ([&] {
+        for (size_t i = 0; i < n; i++) s >>= int (i);
+    }));
+
+    std::cout << "  " << std::left << std::setw (40) << "bytes per element"
+        << std::right << std::setw (10) << n
+        << std::setw (14) << std::setprecision (2) << double (Allocated - before) / n << std::endl;
+
+    benchmark::row ("iterate", n, benchmark::best (5, [&] {
+        size_t total = 0;
+        for (int x : s) total += x;
+        benchmark::keep (total);
+    }));
+
+    benchmark::row ("rest", n, benchmark::time ([&] {
+        auto z = s;
+        while (!z.empty ()) z = z.rest ();
+        benchmark::keep (z);
+    }));
+
+    // linked_stack::operator [] recurses, so don't look too deep.
+    size_t m = 1000;
+    size_t depth = std::min (n, size_t {10000});
+    benchmark::row ("operator []", m, benchmark::time ([&] {
+        size_t total = 0;
+        for (size_t i = 0; i < m; i++) total += s[(i * 7919) % depth];
+        benchmark::keep (total);
+    }));
+
+    benchmark::row ("last", 1, benchmark::time ([&] {
+        benchmark::keep (last (s));
+    }));
+
+    benchmark::row ("reverse", n, benchmark::time ([&] {
+        benchmark::keep (reverse (s));
+    }));
+
+    benchmark::row ("destroy", n, benchmark::time ([&] {
+        s = stack {};
+    }));
+}
+
+int main (int argc, char **argv) {
+    size_t n = argc > 1 ? std::stoull (argv[1]) : 1000000;
+
+    bench<linked_stack<int>> ("linked_stack<int>", n);
+    bench<unrolled_stack<int, 16>> ("unrolled_stack<int, 16>", n);
+    bench<unrolled_stack<int, 32>> ("unrolled_stack<int, 32>", n);
+    bench<unrolled_stack<int, 64>> ("unrolled_stack<int, 64>", n);
+
+    return 0;
+}
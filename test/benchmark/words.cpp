@@ -0,0 +1,152 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Add, subtract, compare, negate, and, or, xor and shift numbers made of
+// bytes in both endian orders, one digit at a time as they used to be and a
+// limb at a time as they are now outside of constant expressions.
+
+#include <random>
+#include <data/arithmetic/words.hpp>
+#include "benchmark.hpp"
+
+using namespace data;
+using namespace data::arithmetic;
+
+// the number of repetitions for operands of the given size.
+size_t repetitions (size_t size) {
+    return std::max<size_t> (1, size_t (double (1 << 26) / double (size)));
+}
+
+template <endian::order r> void run (std::mt19937_64 &gen, size_t size) {
+    std::string order = r == endian::little ? "little" : "big";
+    size_t reps = repetitions (size);
+
+    std::vector<byte> x (size);
+    std::vector<byte> y (size);
+    std::vector<byte> z (size);
+    for (size_t i = 0; i < size; i++) {
+        x[i] = static_cast<byte> (gen ());
+        y[i] = x[i];
+    }
+
+    // make them differ only in the least significant digit
+    // so that compare has to go all the way through.
+    Words<r, byte> a {slice<byte> (x)};
+    Words<r, byte> b {slice<byte> (y)};
+    Words<r, byte> o {slice<byte> (z)};
+    b[0] ^= 1;
+
+    benchmark::row ("plus, digits, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) {
+            auto io = o.begin ();
+            auto ia = a.begin ();
+            auto ib = b.begin ();
+            benchmark::keep (add_with_carry<byte> (o.end (), io, ia, ib));
+        }
+    }));
+
+    benchmark::row ("plus, limbs, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) benchmark::keep (plus (o, a, b));
+    }));
+
+    benchmark::row ("minus, digits, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) {
+            auto io = o.begin ();
+            auto ia = a.begin ();
+            auto ib = b.begin ();
+            benchmark::keep (subtract_with_carry<byte> (o.end (), io, ia, ib));
+        }
+    }));
+
+    benchmark::row ("minus, limbs, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) benchmark::keep (minus (o, a, b));
+    }));
+
+    benchmark::row ("compare, digits, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) benchmark::keep (arithmetic::compare (a.rbegin (), a.rend (), b.rbegin ()));
+    }));
+
+    benchmark::row ("compare, limbs, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) benchmark::keep (arithmetic::compare<negativity::nones> (a, b));
+    }));
+
+    // the digit-by-digit loops that the bitwise operations used to have.
+    benchmark::row ("negate, digits, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) {
+            auto ia = a.begin ();
+            for (auto io = o.begin (); io != o.end (); io++, ia++) *io = ~*ia;
+            benchmark::keep (z);
+        }
+    }));
+
+    benchmark::row ("negate, limbs, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) {
+            bit_negate<byte> (o.begin (), o.end (), a.begin ());
+            benchmark::keep (z);
+        }
+    }));
+
+    benchmark::row ("xor, digits, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) {
+            auto ia = a.begin ();
+            auto ib = b.begin ();
+            for (auto io = o.begin (); io != o.end (); io++, ia++, ib++) *io = *ia ^ *ib;
+            benchmark::keep (z);
+        }
+    }));
+
+    benchmark::row ("xor, limbs, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) {
+            bit_xor<byte> (o.begin (), o.end (), a.begin (), b.begin ());
+            benchmark::keep (z);
+        }
+    }));
+
+    // and and or are the same as xor.
+
+    benchmark::row ("shift left 13, digits, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) {
+            if constexpr (r == endian::little) bit_shift_left<byte> (z.rbegin (), z.rend (), 13, false);
+            else bit_shift_left<byte> (z.begin (), z.end (), 13, false);
+            benchmark::keep (z);
+        }
+    }));
+
+    benchmark::row ("shift left 13, limbs, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) {
+            o.bit_shift_left (13);
+            benchmark::keep (z);
+        }
+    }));
+
+    benchmark::row ("shift right 13, digits, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) {
+            if constexpr (r == endian::little) bit_shift_right<byte> (z.begin (), z.end (), 13, false);
+            else bit_shift_right<byte> (z.rbegin (), z.rend (), 13, false);
+            benchmark::keep (z);
+        }
+    }));
+
+    benchmark::row ("shift right 13, limbs, " + order, reps, benchmark::best (3, [&] {
+        for (size_t i = 0; i < reps; i++) {
+            o.bit_shift_right (13);
+            benchmark::keep (z);
+        }
+    }));
+}
+
+int main (int argc, char **argv) {
+    size_t max = argc > 1 ? std::stoull (argv[1]) : 4096;
+
+    std::mt19937_64 gen {1};
+
+    for (size_t size : {8, 32, 256, 4096, 65536}) {
+        if (size > max) break;
+        benchmark::header (std::to_string (size) + " bytes");
+        run<endian::little> (gen, size);
+        run<endian::big> (gen, size);
+    }
+
+    return 0;
+}
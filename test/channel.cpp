@@ -0,0 +1,122 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "data/channel.hpp"
+#include "data/string.hpp"
+#include <thread>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    TEST (Channel, Try) {
+        channel<int> c {3};
+        EXPECT_EQ (c.capacity (), 4);
+        EXPECT_FALSE (bool (c.try_receive ()));
+        for (int i = 0; i < 4; i++) EXPECT_TRUE (c.try_send (i));
+        EXPECT_FALSE (c.try_send (4));
+        for (int i = 0; i < 4; i++) EXPECT_EQ (c.try_receive (), i);
+        EXPECT_FALSE (bool (c.try_receive ()));
+
+        channel<string> u {};
+        EXPECT_EQ (u.capacity (), 0);
+        for (int i = 0; i < 100; i++) EXPECT_TRUE (u.try_send (std::to_string (i)));
+        for (int i = 0; i < 100; i++) EXPECT_EQ (u.try_receive (), string {std::to_string (i)});
+
+        u.try_send ("x");
+        u.close ();
+        EXPECT_FALSE (u.try_send ("y"));
+        EXPECT_EQ (u.try_receive (), string {"x"});
+        EXPECT_FALSE (bool (u.try_receive ()));
+    }
+
+    // a producer sends more values than the channel can hold while a consumer receives them.
+    void send_and_receive (size_t capacity, int producers, int threads) {
+        channel<int> c {capacity};
+        const int n = 2000;
+        std::atomic<int> finished {0};
+        std::atomic<int64> total {0};
+        std::atomic<int> received {0};
+
+        boost::asio::io_context io {};
+        for (int p = 0; p < producers; p++) spawn (io.get_executor (), [&] () -> awaitable<void> {
+            for (int i = 1; i <= n; i++) co_await c.send (i);
+            if (++finished == producers) c.close ();
+        });
+
+        for (int p = 0; p < producers; p++) spawn (io.get_executor (), [&] () -> awaitable<void> {
+            while (true) {
+                maybe<int> x = co_await c.receive ();
+                if (!bool (x)) co_return;
+                total += *x;
+                received++;
+            }
+        });
+
+        std::vector<std::thread> pool {};
+        for (int t = 1; t < threads; t++) pool.emplace_back ([&io] {
+            io.run ();
+        });
+
+        io.run ();
+        for (auto &t : pool) t.join ();
+
+        EXPECT_EQ (received, producers * n);
+        EXPECT_EQ (total, int64 (producers) * n * (n + 1) / 2);
+    }
+
+    TEST (Channel, Await) {
+        send_and_receive (2, 1, 1);
+        send_and_receive (2, 4, 1);
+        send_and_receive (4, 4, 4);
+        send_and_receive (0, 4, 4);
+    }
+
+    TEST (Channel, Closed) {
+        channel<int> c {2};
+        c.close ();
+        EXPECT_THROW (synced ([&] {
+            return c.send (1);
+        }), channel_closed);
+
+        EXPECT_FALSE (bool (synced ([&] {
+            return c.receive ();
+        })));
+    }
+
+    TEST (Channel, Select) {
+        channel<int> a {2};
+        channel<int> b {};
+
+        b.try_send (2);
+        auto x = synced ([&] {
+            return select (a, b);
+        });
+
+        EXPECT_EQ (x.first, 1);
+        EXPECT_EQ (x.second, 2);
+
+        // wait for a value to arrive from another thread.
+        std::thread t {[&a] {
+            std::this_thread::sleep_for (std::chrono::milliseconds {10});
+            a.try_send (1);
+        }};
+
+        x = synced ([&] {
+            return select (a, b);
+        });
+
+        t.join ();
+        EXPECT_EQ (x.first, 0);
+        EXPECT_EQ (x.second, 1);
+
+        b.close ();
+        x = synced ([&] {
+            return select (a, b);
+        });
+
+        EXPECT_EQ (x.first, 1);
+        EXPECT_FALSE (bool (x.second));
+    }
+
+}
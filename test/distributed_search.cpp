@@ -0,0 +1,98 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/tools/distributed_search.hpp>
+#include <data/list.hpp>
+#include <ranges>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    using counter = std::ranges::iterator_t<std::ranges::iota_view<uint64, uint64>>;
+
+    TEST (DistributedSearch, Forward) {
+        list<int> candidates {};
+        for (int i = 0; i < 1000; i++) candidates <<= i;
+
+        using it = decltype (candidates.begin ());
+        distributed::test<int, it> trial = [] (const it &i) -> maybe<int> {
+            if (*i == 777) return *i;
+            return {};
+        };
+
+        EXPECT_EQ (distributed::search<int> (4, trial, candidates.begin (), candidates.end (), 10), maybe<int> {777});
+
+        distributed::test<int, it> fail = [] (const it &) -> maybe<int> {
+            return {};
+        };
+
+        EXPECT_EQ (distributed::search<int> (4, fail, candidates.begin (), candidates.end (), 10), maybe<int> {});
+    }
+
+    TEST (DistributedSearch, Stealing) {
+        auto space = std::views::iota (uint64 {0}, uint64 {1000000});
+        std::atomic<uint64> calls {0};
+        distributed::test<uint64, counter> trial = [&calls] (const counter &i) -> maybe<uint64> {
+            calls++;
+            if (*i == 999999) return *i;
+            return {};
+        };
+
+        for (uint32 threads : {1, 2, 7}) {
+            calls = 0;
+            auto s = distributed::search_in_background<uint64> (threads, trial, space.begin (), space.end (), 100);
+            EXPECT_EQ (s->wait (), maybe<uint64> {999999});
+            auto p = s->progress ();
+            EXPECT_EQ (p.Total, 1000000);
+            EXPECT_EQ (p.Tested, calls.load ());
+            EXPECT_LE (p.Tested, 1000000);
+        }
+
+        // every candidate is tested exactly once if there is no solution.
+        std::vector<std::atomic<uint32>> seen (100000);
+        distributed::test<uint64, counter> none = [&seen] (const counter &i) -> maybe<uint64> {
+            seen[*i]++;
+            return {};
+        };
+
+        auto small = std::views::iota (uint64 {0}, uint64 {100000});
+        EXPECT_EQ (distributed::search<uint64> (5, none, small.begin (), small.end (), 1000), maybe<uint64> {});
+        for (auto &x : seen) EXPECT_EQ (x.load (), 1);
+        EXPECT_EQ (distributed::search<uint64> (3, none, small.begin (), small.begin (), 1000), maybe<uint64> {});
+    }
+
+    TEST (DistributedSearch, Cancellation) {
+        auto space = std::views::iota (uint64 {0}, uint64 {1} << 40);
+
+        // a solution found early stops all the other threads.
+        distributed::test<uint64, counter> early = [] (const counter &i) -> maybe<uint64> {
+            if (*i == 12345) return *i;
+            return {};
+        };
+
+        auto s = distributed::search_in_background<uint64> (4, early, space.begin (), space.end (), 1000);
+        EXPECT_EQ (s->wait (), maybe<uint64> {12345});
+        EXPECT_TRUE (s->stopped ());
+
+        distributed::test<uint64, counter> never = [] (const counter &) -> maybe<uint64> {
+            return {};
+        };
+
+        auto c = distributed::search_in_background<uint64> (4, never, space.begin (), space.end ());
+        std::this_thread::sleep_for (std::chrono::milliseconds {20});
+        c->cancel ();
+        EXPECT_EQ (c->wait (), maybe<uint64> {});
+        EXPECT_GT (c->progress ().Tested, 0);
+        EXPECT_GT (c->progress ().throughput (), 0);
+
+        distributed::test<uint64, counter> bad = [] (const counter &i) -> maybe<uint64> {
+            if (*i == 5000) throw std::logic_error {"bad candidate"};
+            return {};
+        };
+
+        auto e = distributed::search_in_background<uint64> (4, bad, space.begin (), space.end ());
+        EXPECT_THROW (e->wait (), std::logic_error);
+    }
+
+}
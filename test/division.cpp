@@ -7,6 +7,7 @@
 #include "data/numbers.hpp"
 #include "data/tuple.hpp"
 #include "gtest/gtest.h"
+#include <random>
 
 namespace data {
     template <typename N>
@@ -260,5 +261,76 @@ namespace data {
         test_division_integer<Z, N> {};
     }
 
-}
+    using namespace arithmetic::limbs;
+
+    // check a / b against a == q b + r with r < b.
+    void test_limb_division (const std::vector<limb> &a, const std::vector<limb> &b) {
+        size_t an = a.size ();
+        size_t bn = b.size ();
+        std::vector<limb> q (an - bn + 1);
+        std::vector<limb> r (bn);
+        divide (q.data (), r.data (), a.data (), an, b.data (), bn);
+
+        EXPECT_LT (compare_n (r.data (), b.data (), bn), 0) << "sizes " << an << " and " << bn;
+
+        std::vector<limb> x (an + 1);
+        multiply (x.data (), q.data (), q.size (), b.data (), bn);
+        add_to (x.data (), an + 1, r.data (), bn);
+        EXPECT_EQ (std::vector<limb> (x.begin (), x.begin () + an), a) << "sizes " << an << " and " << bn;
+        EXPECT_EQ (x[an], 0);
+    }
+
+    TEST (LimbDivision, Divide) {
+        std::mt19937_64 gen {1};
+        auto random_limbs = [&gen] (size_t size) {
+            std::vector<limb> z (size);
+            for (limb &x : z) x = gen ();
+            if (z.back () == 0) z.back () = 1;
+            return z;
+        };
+
+        constexpr size_t t = burnikel_ziegler_threshold;
+        for (size_t bn : std::vector<size_t> {1, 2, 3, 17, t - 1, t, t + 1, 2 * t, 3 * t + 5, 8 * t + 3})
+            for (size_t extra : std::vector<size_t> {0, 1, 2, 7, t - 1, t, 2 * t + 1, 5 * t}) {
+                test_limb_division (random_limbs (bn + extra), random_limbs (bn));
+
+                // divisors with small top limbs need the most normalization, and
+                // dividends made of all ones make the quotient estimates hardest.
+                std::vector<limb> b = random_limbs (bn);
+                b.back () = 1;
+                test_limb_division (std::vector<limb> (bn + extra, ~limb {0}), b);
+                test_limb_division (random_limbs (bn + extra), std::vector<limb> (bn, ~limb {0}));
+            }
+    }
 
+    template <typename N> void test_big_division (std::mt19937_64 &gen, size_t as, size_t bs) {
+        auto random_N = [&gen] (size_t size) {
+            bytes z (size);
+            for (byte &x : z) x = static_cast<byte> (gen ());
+            return data::N ("0x" + encoding::hex::write (z));
+        };
+
+        data::N a = random_N (as);
+        data::N b = random_N (bs) + data::N {1};
+        auto expected = divmod (a, math::nonzero {b});
+        auto result = divmod (N (a), math::nonzero {N (b)});
+        EXPECT_EQ (data::N (result.Quotient), expected.Quotient) << "sizes " << as << " and " << bs;
+        EXPECT_EQ (data::N (result.Remainder), expected.Remainder) << "sizes " << as << " and " << bs;
+    }
+
+    TEST (LimbDivision, NBytes) {
+        std::mt19937_64 gen {2};
+        for (size_t as : {1, 9, 64, 512, 3000}) for (size_t bs : {1, 7, 8, 33, 400, 1000})
+            if (bs <= as) {
+                test_big_division<N_bytes_little> (gen, as, bs);
+                test_big_division<N_bytes_big> (gen, as, bs);
+                test_big_division<math::N_bytes<endian::big, unsigned int>> (gen, as, bs);
+            }
+
+        for (size_t bs : {1, 16, 64, 128}) {
+            test_big_division<uint_little<128>> (gen, 127, bs);
+            test_big_division<uint_big<128>> (gen, 128, bs);
+        }
+    }
+
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/hash_map.hpp>
+#include <data/map.hpp>
+#include <data/string.hpp>
+#include <unordered_map>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    // a bad hash function so that we can test collisions.
+    struct constant_hash {
+        size_t operator () (int) const {
+            return 12345;
+        }
+    };
+
+    // only uses the lowest 10 bits so that we get deep collisions.
+    struct narrow_hash {
+        size_t operator () (int x) const {
+            return size_t (x) & 1023;
+        }
+    };
+
+    template <typename M> void test_hash_map_against_std (int seed) {
+        std::mt19937 gen (seed);
+        M m {};
+        std::unordered_map<int, int> expected {};
+
+        for (int i = 0; i < 20000; i++) {
+            int k = gen () % 3000;
+            if (gen () % 3 == 0) {
+                m = m.remove (k);
+                expected.erase (k);
+            } else {
+                int v = gen ();
+                m = m.insert (k, v, [] (int, int new_v) { return new_v; });
+                expected[k] = v;
+            }
+        }
+
+        EXPECT_EQ (m.size (), expected.size ());
+        size_t count = 0;
+        for (const auto &e : m) {
+            count++;
+            auto i = expected.find (e.Key);
+            ASSERT_NE (i, expected.end ());
+            EXPECT_EQ (i->second, e.Value);
+        }
+        EXPECT_EQ (count, expected.size ());
+
+        for (const auto &[k, v] : expected) {
+            ASSERT_NE (m.contains (k), nullptr);
+            EXPECT_EQ (*m.contains (k), v);
+        }
+
+        // remove everything.
+        for (const auto &[k, v] : expected) m = m.remove (k);
+        EXPECT_TRUE (m.empty ());
+        EXPECT_EQ (m.begin (), m.end ());
+    }
+
+    TEST (HashMap, Basic) {
+        hash_map<int, string> empty {};
+        EXPECT_TRUE (empty.empty ());
+        EXPECT_EQ (empty.size (), 0);
+        EXPECT_EQ (empty.contains (1), nullptr);
+        EXPECT_EQ (empty.begin (), empty.end ());
+        EXPECT_EQ (empty.remove (1), empty);
+
+        hash_map<int, string> m {{1, "a"}, {2, "b"}, {3, "c"}};
+        EXPECT_EQ (m.size (), 3);
+        EXPECT_EQ (m[2], "b");
+        using strings = hash_map<int, string>;
+        EXPECT_THROW (m[4], strings::key_does_not_exist);
+        EXPECT_THROW (m.insert (1, "z"), strings::key_already_exists);
+        EXPECT_TRUE (m.contains (entry<const int, string> {3, "c"}));
+        EXPECT_FALSE (m.contains (entry<const int, string> {3, "d"}));
+
+        // the old map is unchanged.
+        auto n = m.remove (2).insert (4, "d");
+        EXPECT_EQ (m, (hash_map<int, string> {{3, "c"}, {2, "b"}, {1, "a"}}));
+        EXPECT_EQ (n, (hash_map<int, string> {{1, "a"}, {3, "c"}, {4, "d"}}));
+        EXPECT_NE (m, n);
+        EXPECT_EQ (n.keys ().size (), 3);
+        EXPECT_EQ (n.values ().size (), 3);
+    }
+
+    TEST (HashMap, RandomOperations) {
+        test_hash_map_against_std<hash_map<int, int>> (1);
+        test_hash_map_against_std<hash_map<int, int, narrow_hash>> (2);
+    }
+
+    TEST (HashMap, Collisions) {
+        hash_map<int, int, constant_hash> m {};
+        for (int i = 0; i < 100; i++) m = m.insert (i, i * i);
+        EXPECT_EQ (m.size (), 100);
+        for (int i = 0; i < 100; i++) EXPECT_EQ (m[i], i * i);
+        for (int i = 0; i < 100; i += 2) m = m.remove (i);
+        EXPECT_EQ (m.size (), 50);
+        EXPECT_EQ (m.contains (2), nullptr);
+        EXPECT_EQ (m[3], 9);
+
+        test_hash_map_against_std<hash_map<int, int, constant_hash>> (3);
+    }
+
+    TEST (HashMap, Digest) {
+        hash_map<hash::digest256, int> m {};
+        map<hash::digest256, int> expected {};
+        for (int i = 0; i < 1000; i++) {
+            hash::digest256 d {};
+            for (byte &b : d) b = byte (std::rand ());
+            m = m.insert (d, i);
+            expected = expected.insert (d, i);
+        }
+
+        EXPECT_EQ (m.size (), expected.size ());
+        for (const auto &[k, v] : expected) EXPECT_EQ (m[k], v);
+    }
+
+    // a key that can be compared for equality but not ordered.
+    struct point {
+        int X;
+        int Y;
+        bool operator == (const point &) const = default;
+    };
+
+    struct point_hash {
+        size_t operator () (const point &p) const {
+            return std::hash<int> {} (p.X) * 31 + std::hash<int> {} (p.Y);
+        }
+    };
+
+    TEST (HashMap, UnorderedKey) {
+        static_assert (!Ordered<point>);
+        hash_map<point, int, point_hash> m {};
+        for (int i = 0; i < 100; i++) m = m.insert (point {i, -i}, i);
+        EXPECT_EQ (m.size (), 100);
+        EXPECT_EQ ((m[point {7, -7}]), 7);
+        EXPECT_EQ ((m.contains (point {7, 7})), nullptr);
+    }
+
+    TEST (HashMap, WideElements) {
+        // keys that agree only in their first few bytes.
+        std::vector<uint32> a {1, 2};
+        std::vector<uint32> b {1, 3};
+        EXPECT_NE (key_hash<std::vector<uint32>> {} (a), key_hash<std::vector<uint32>> {} (b));
+    }
+
+    TEST (HashMap, String) {
+        hash_map<string, int> m {{"one", 1}, {"two", 2}};
+        EXPECT_EQ (m["two"], 2);
+        EXPECT_EQ (m.contains ("three"), nullptr);
+    }
+
+}
@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <iterator>
+#include <thread>
 #include "data/remove.hpp"
 // TODO Right now numbers provides N and Z as well as Z_bytes and N_bytes
 // we don't like this because N has a dependency and Z_bytes does not.
@@ -12,6 +13,7 @@
 #include "data/replace.hpp"
 #include "data/lift.hpp"
 #include "data/iterable.hpp"
+#include "data/select.hpp"
 #include "gtest/gtest.h"
 
 namespace data {
@@ -227,6 +229,97 @@ namespace data {
         (void) (stack<stack<int>> {} == stack<stack<int &>> {});
         (void) (stack<stack<int>> {} == stack<stack<const int &>> {});*/
     }
+
+    template <typename alloc> void test_stack_storage () {
+        using type = linked_stack<int, alloc>;
+        static_assert (Stack<type>);
+
+        type t {1, 2, 3};
+        EXPECT_EQ (size (t), 3);
+        EXPECT_EQ (t, (stack<int> {1, 2, 3}));
+        EXPECT_EQ (reverse (t), (stack<int> {3, 2, 1}));
+        EXPECT_EQ (rest (t), (stack<int> {2, 3}));
+
+        // nodes are shared between versions.
+        type u = t >> 0;
+        EXPECT_EQ (u, (stack<int> {0, 1, 2, 3}));
+        EXPECT_EQ (t, (stack<int> {1, 2, 3}));
+
+        // long stacks can be destroyed without overflowing the call stack.
+        type big {};
+        for (int i = 0; i < 1000000; i++) big >>= i;
+        EXPECT_EQ (size (big), 1000000);
+        big = type {};
+        EXPECT_TRUE (empty (big));
+
+        linked_stack<string, alloc> strings {"a", "b", "c"};
+        EXPECT_EQ (strings, (stack<string> {"a", "b", "c"}));
+    }
+
+    TEST (LinkedStack, Storage) {
+        test_stack_storage<pool::shared> ();
+        test_stack_storage<pool::local> ();
+        test_stack_storage<pool::concurrent> ();
+    }
+
+    TEST (LinkedStack, StorageThreadExit) {
+        // a thread_local stack that is constructed before the pool's own thread_local
+        // cache is destroyed after it, so its nodes are released after the cache is gone.
+        std::thread {[] {
+            thread_local linked_stack<int, pool::local> held {};
+            for (int i = 0; i < 1000; i++) held >>= i;
+        }}.join ();
+
+        // those nodes went to the global list, where other threads can use them.
+        std::thread {[] {
+            linked_stack<int, pool::local> t {};
+            for (int i = 0; i < 1000; i++) t >>= i;
+            EXPECT_EQ (size (t), 1000);
+        }}.join ();
+    }
+
+    template <typename alloc> void test_stack_transient () {
+        using stack = linked_stack<int, alloc>;
+
+        typename stack::transient t {};
+        for (int i = 0; i < 10; i++) t.append (i);
+        t.prepend (-1);
+        EXPECT_EQ (t.size (), 11);
+
+        stack x = t.freeze ();
+        EXPECT_TRUE (t.empty ());
+        EXPECT_EQ (x, (stack {-1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+        EXPECT_EQ (size (x), 11);
+        EXPECT_EQ (size (rest (x)), 10);
+
+        // the original stack must not be changed by a transient made from it.
+        typename stack::transient u {x};
+        u.append (10);
+        u.prepend (-2);
+        stack y = u.freeze ();
+        EXPECT_EQ (x, (stack {-1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+        EXPECT_EQ (y, (stack {-2, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+        EXPECT_EQ (size (rest (y)), 12);
+
+        // a stack that is not shared is modified in place.
+        const int *first = &y.first ();
+        typename stack::transient v {std::move (y)};
+        v.append (11);
+        stack z = v.freeze ();
+        EXPECT_EQ (&z.first (), first);
+        EXPECT_EQ (size (z), 14);
+        EXPECT_EQ (last (z), 11);
+    }
+
+    TEST (LinkedStack, Transient) {
+        test_stack_transient<pool::shared> ();
+        test_stack_transient<pool::local> ();
+        test_stack_transient<pool::concurrent> ();
+
+        EXPECT_EQ (select (stack<int> {1, 2, 3, 4, 5, 6}, [] (int x) {
+            return x % 2 == 0;
+        }), (stack<int> {2, 4, 6}));
+    }
 }
 
 template <typename X> struct Stack : ::testing::Test {
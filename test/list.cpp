@@ -7,6 +7,7 @@
 #include <data/string.hpp>
 #include <data/numbers.hpp>
 #include <data/shuffle.hpp>
+#include <data/select.hpp>
 #include "gtest/gtest.h"
 
 namespace data {
@@ -111,6 +112,22 @@ namespace data {
         EXPECT_EQ (list<int> {0} << 1, (list<int> {0, 1}));
     }
 
+    TEST (List, Transient) {
+        list<int> x {1, 2, 3};
+        x = x << 4 << 5;
+
+        list<int>::transient t {x};
+        t <<= 6;
+        t >>= 0;
+        EXPECT_EQ (t.size (), 7);
+        EXPECT_EQ (t.freeze (), (list<int> {0, 1, 2, 3, 4, 5, 6}));
+        EXPECT_EQ (x, (list<int> {1, 2, 3, 4, 5}));
+
+        EXPECT_EQ (select (x, [] (int z) {
+            return z % 2 == 1;
+        }), (list<int> {1, 3, 5}));
+    }
+
     void accept_stack_of_string_views (list<string_view>) {}
 
     TEST (List, Convert) {
@@ -100,6 +100,19 @@ namespace data {
         auto m1r2 = m1.remove (3);
         
         EXPECT_EQ (m1r2, m2);
+        EXPECT_EQ (m1.remove (4), m1);
+        EXPECT_EQ (remove (m1r2, 2).remove (1), (map<int, int> {}));
+
+        map<int, int> big {};
+        for (int i = 0; i < 1000; i++) big = big.insert (i, i % 7);
+        for (int i = 0; i < 1000; i += 2) big = remove (big, i);
+        EXPECT_EQ (big.size (), 500);
+        EXPECT_EQ (big.contains (2), nullptr);
+        EXPECT_EQ (big[999], 999 % 7);
+
+        auto erased = erase (big, 0);
+        EXPECT_EQ (erased.size (), 500 - 500 / 7);
+        for (const auto &[key, value] : erased) EXPECT_NE (value, 0);
     }
     
     TEST (Map, Iterate) {
@@ -152,6 +165,49 @@ namespace data {
 
     }
 
+    TEST (Map, FromSorted) {
+        using sorted = map<int, string>;
+        using entry = sorted::entry;
+        std::vector<entry> entries {{1, "a"}, {2, "b"}, {5, "c"}};
+        EXPECT_EQ (sorted::from_sorted (entries), (sorted {{1, "a"}, {2, "b"}, {5, "c"}}));
+        EXPECT_EQ (sorted::from_sorted_unique (entries.begin (), entries.end ()), (sorted {{1, "a"}, {2, "b"}, {5, "c"}}));
+        EXPECT_EQ (sorted::from_sorted (std::vector<entry> {}), (sorted {}));
+        EXPECT_THROW (sorted::from_sorted (std::vector<entry> {{1, "a"}, {1, "b"}}), sorted::key_already_exists);
+        EXPECT_THROW (sorted::from_sorted (std::vector<entry> {{2, "a"}, {1, "b"}}), exception);
+
+        std::vector<entry> many {};
+        for (int i = 0; i < 1000; i++) many.emplace_back (i, std::to_string (i));
+        auto m = sorted::from_sorted (many);
+        EXPECT_EQ (m.size (), 1000);
+        EXPECT_EQ (m[500], "500");
+        EXPECT_EQ (m.insert (1000, "1000").remove (0).size (), 1000);
+    }
+
+    TEST (Map, Transient) {
+        using transient = map<int, int>::transient;
+        using key_already_exists = map<int, int>::key_already_exists;
+        map<int, int> m {{1, 1}, {2, 2}};
+
+        transient t {m};
+        for (int i = 0; i < 100; i++) t.insert (i % 10, 1, [] (int a, int b) {
+            return a + b;
+        });
+
+        EXPECT_THROW (t.insert (1, 1), key_already_exists);
+
+        map<int, int> n = t.freeze ();
+        EXPECT_EQ (n.size (), 10);
+        EXPECT_EQ (n[0], 10);
+        EXPECT_EQ (n[1], 11);
+        EXPECT_EQ (n[2], 12);
+        EXPECT_EQ (n[9], 10);
+        EXPECT_EQ (m, (map<int, int> {{1, 1}, {2, 2}}));
+
+        EXPECT_EQ (select (n, [] (int v) {
+            return v > 10;
+        }), (map<int, int> {{1, 11}, {2, 12}}));
+    }
+
     TEST (Map, Comparison) {
         (void) (map<int, int> {} == map<int, const int> {});
         (void) (map<int, int> {} == map<int, int &> {});
@@ -0,0 +1,125 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/tools/memo.hpp>
+#include <data/numbers.hpp>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    TEST (Memo, Basic) {
+        int calls = 0;
+        memo<int, int> square {[&calls] (const int &x) {
+            calls++;
+            return x * x;
+        }, 8, 1};
+
+        EXPECT_EQ (square (3), 9);
+        EXPECT_EQ (square (3), 9);
+        EXPECT_EQ (calls, 1);
+        EXPECT_EQ (square.cached (3), maybe<int> {9});
+        EXPECT_EQ (square.cached (4), maybe<int> {});
+
+        auto s = square.stats ();
+        EXPECT_EQ (s.Hits, 1);
+        EXPECT_EQ (s.Misses, 1);
+
+        // fill the cache beyond its capacity.
+        for (int i = 0; i < 20; i++) EXPECT_EQ (square (i), i * i);
+        EXPECT_EQ (square.size (), 8);
+        EXPECT_EQ (square.stats ().Evictions, 12);
+
+        // recently used entries survive eviction.
+        for (int i = 0; i < 10; i++) {
+            EXPECT_EQ (square (19), 361);
+            EXPECT_EQ (square (100 + i), (100 + i) * (100 + i));
+        }
+
+        EXPECT_EQ (square.cached (19), maybe<int> {361});
+
+        square.clear ();
+        EXPECT_EQ (square.size (), 0);
+        EXPECT_EQ (square.cached (19), maybe<int> {});
+    }
+
+    TEST (Memo, Keys) {
+        // a hashable key.
+        memo<std::string, size_t> length {[] (const std::string &x) {
+            return x.size ();
+        }};
+
+        EXPECT_EQ (length ("hello"), 5);
+        EXPECT_EQ (length ("hello"), 5);
+        EXPECT_EQ (length.stats ().Hits, 1);
+
+        // a key that is ordered but not hashable.
+        memo<N, N> twice {[] (const N &x) -> N {
+            return x + x;
+        }};
+
+        EXPECT_EQ (twice (N {"1000000000000000000000000"}), N {"2000000000000000000000000"});
+        EXPECT_EQ (twice (N {"1000000000000000000000000"}), N {"2000000000000000000000000"});
+        EXPECT_EQ (twice.stats ().Hits, 1);
+    }
+
+    TEST (Memo, Exception) {
+        memo<int, int> fail {[] (const int &x) -> int {
+            if (x < 0) throw std::invalid_argument {"negative"};
+            return x;
+        }};
+
+        EXPECT_THROW (fail (-1), std::invalid_argument);
+        EXPECT_THROW (fail (-1), std::invalid_argument);
+        EXPECT_EQ (fail.size (), 0);
+        EXPECT_EQ (fail (1), 1);
+    }
+
+    TEST (Memo, SingleFlight) {
+        std::atomic<int> calls {0};
+        memo<int, int> slow {[&calls] (const int &x) {
+            calls++;
+            std::this_thread::sleep_for (std::chrono::milliseconds {50});
+            return x + 1;
+        }};
+
+        std::vector<std::thread> threads {};
+        std::atomic<int> wrong {0};
+        for (int t = 0; t < 8; t++) threads.emplace_back ([&] {
+            if (slow (7) != 8) wrong++;
+        });
+
+        for (auto &t : threads) t.join ();
+        EXPECT_EQ (wrong, 0);
+        EXPECT_EQ (calls, 1);
+        auto s = slow.stats ();
+        EXPECT_EQ (s.Misses, 1);
+        EXPECT_EQ (s.Hits + s.Shared, 7);
+    }
+
+    TEST (Memo, Threads) {
+        memo<uint64, uint64> collatz {[] (const uint64 &x) {
+            uint64 steps = 0;
+            for (uint64 n = x; n > 1; steps++) n = n % 2 == 0 ? n / 2 : 3 * n + 1;
+            return steps;
+        }, 256};
+
+        std::vector<std::thread> threads {};
+        std::atomic<int> wrong {0};
+        for (int t = 0; t < 8; t++) threads.emplace_back ([&, t] {
+            for (uint64 i = 1; i < 2000; i++) {
+                uint64 x = (i * (t + 1)) % 1000 + 1;
+                uint64 steps = 0;
+                for (uint64 n = x; n > 1; steps++) n = n % 2 == 0 ? n / 2 : 3 * n + 1;
+                if (collatz (x) != steps) wrong++;
+            }
+        });
+
+        for (auto &t : threads) t.join ();
+        EXPECT_EQ (wrong, 0);
+        EXPECT_LE (collatz.size (), collatz.capacity ());
+    }
+
+}
@@ -5,6 +5,7 @@
 #include "data/numbers.hpp"
 #include "data/math.hpp"
 #include "gtest/gtest.h"
+#include <random>
 
 namespace data {
 
@@ -144,4 +145,65 @@ namespace data {
         test_modular<typename TestFixture::number> ();
     }
 
+    // a uint from its 64-bit limbs, least significant first. Each limb is
+    // split into as many digits of X as it takes to hold it.
+    template <typename X> constexpr X uint_from_limbs (std::initializer_list<uint64> limbs) {
+        using digit = std::remove_cvref_t<decltype (*std::declval<X &> ().words ().begin ())>;
+        X z {0u};
+        auto w = z.words ().begin ();
+        for (uint64 x : limbs)
+            for (size_t i = 0; i < sizeof (uint64) / sizeof (digit); i++) {
+                *w++ = static_cast<digit> (x);
+                if constexpr (sizeof (digit) < sizeof (uint64)) x >>= 8 * sizeof (digit);
+            }
+        return z;
+    }
+
+    // secp256k1's p and n.
+    template <typename X> constexpr X secp256k1_p = uint_from_limbs<X> ({0xFFFFFFFEFFFFFC2F, ~0ull, ~0ull, ~0ull});
+    template <typename X> constexpr X secp256k1_n = uint_from_limbs<X> ({0xBFD25E8CD0364141, 0xBAAEDCE6AF48A03B, 0xFFFFFFFFFFFFFFFE, ~0ull});
+
+    // compare modular arithmetic against N for random arguments.
+    template <typename X, auto mod> void test_modular_uint (std::mt19937_64 &gen) {
+        using M = math::number::modular<mod, X>;
+        N m (mod);
+        for (int i = 0; i < 500; i++) {
+            X a, b;
+            for (auto &w : a.words ()) w = gen ();
+            for (auto &w : b.words ()) w = gen ();
+            if (i % 7 == 0) a = mod - 1u;
+            if (i % 11 == 0) b = X {0u};
+
+            M x {a};
+            M y {b};
+            N na = N (a) % m;
+            N nb = N (b) % m;
+
+            EXPECT_EQ (N (x.Value), na);
+            EXPECT_EQ (N ((x * y).Value), (na * nb) % m);
+            EXPECT_EQ (N ((x + y).Value), (na + nb) % m);
+            EXPECT_EQ (N ((x - y).Value), (na + m - nb) % m);
+            EXPECT_EQ (N ((-x).Value), (m - na) % m);
+        }
+    }
+
+    TEST (Modular, Barrett) {
+        std::mt19937_64 gen {1};
+
+        static_assert (math::number::barrett_modulus<secp256k1_p<uint256>, uint256>);
+        static_assert (!math::number::barrett_modulus<uint_from_limbs<uint128> ({0, 1}), uint128>);
+
+        EXPECT_EQ (N (secp256k1_n<uint256_big>), N (secp256k1_n<uint256>));
+        EXPECT_EQ (N (secp256k1_n<uint256_little>), N (secp256k1_n<uint256>));
+        EXPECT_EQ (N (secp256k1_p<uint256_big>), N (secp256k1_p<uint256>));
+
+        test_modular_uint<uint256, secp256k1_p<uint256>> (gen);
+        test_modular_uint<uint256, secp256k1_n<uint256>> (gen);
+        test_modular_uint<uint256_big, secp256k1_n<uint256_big>> (gen);
+        test_modular_uint<uint128, uint128 {7}> (gen);
+        test_modular_uint<uint128, uint_from_limbs<uint128> ({1, 1})> (gen);
+        test_modular_uint<uint128, uint_from_limbs<uint128> ({0, 1})> (gen);
+        test_modular_uint<uint80, uint80 {65521}> (gen);
+    }
+
 }
@@ -0,0 +1,98 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <random>
+#include <data/numbers.hpp>
+#include <data/arithmetic/limbs.hpp>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    using namespace arithmetic::limbs;
+
+    std::vector<limb> random_limbs (std::mt19937_64 &gen, size_t size) {
+        std::vector<limb> z (size);
+        for (limb &x : z) x = static_cast<limb> (gen ());
+        return z;
+    }
+
+    // a random number of the given size in bytes as a hex string.
+    std::string random_hex (std::mt19937_64 &gen, size_t size) {
+        bytes z (size);
+        for (byte &x : z) x = static_cast<byte> (gen ());
+        return "0x" + encoding::hex::write (z);
+    }
+
+    // sizes in limbs that are on either side of the thresholds.
+    const std::vector<size_t> &test_sizes () {
+        static std::vector<size_t> sizes {1, 2, 3, 5,
+            karatsuba_threshold - 1, karatsuba_threshold, karatsuba_threshold + 1, 2 * karatsuba_threshold + 1,
+            toom3_threshold - 1, toom3_threshold, toom3_threshold + 1, 3 * toom3_threshold + 2};
+        return sizes;
+    }
+
+    TEST (Multiply, Limbs) {
+        std::mt19937_64 gen {1};
+        for (size_t an : test_sizes ()) for (size_t bn : test_sizes ()) {
+            if (bn > an) continue;
+            std::vector<limb> a = random_limbs (gen, an);
+            std::vector<limb> b = random_limbs (gen, bn);
+
+            std::vector<limb> expected (an + bn);
+            schoolbook (expected.data (), a.data (), an, b.data (), bn);
+
+            std::vector<limb> result (an + bn);
+            multiply (result.data (), a.data (), an, b.data (), bn);
+            EXPECT_EQ (result, expected) << "sizes " << an << " and " << bn;
+        }
+
+        // the carries are worst when every limb is at its maximum.
+        for (size_t n : test_sizes ()) {
+            std::vector<limb> a (n, ~limb {0});
+            std::vector<limb> expected (2 * n);
+            schoolbook (expected.data (), a.data (), n, a.data (), n);
+
+            std::vector<limb> result (2 * n);
+            multiply (result.data (), a.data (), n, a.data (), n);
+            EXPECT_EQ (result, expected) << "size " << n;
+        }
+    }
+
+    template <endian::order r> void test_N_bytes_times (std::mt19937_64 &gen, size_t as, size_t bs) {
+        math::N_bytes<r, byte> a = math::N_bytes<r, byte>::read (random_hex (gen, as));
+        math::N_bytes<r, byte> b = math::N_bytes<r, byte>::read (random_hex (gen, bs));
+        EXPECT_EQ (N (a * b), N (a) * N (b)) << "sizes " << as << " and " << bs;
+    }
+
+    TEST (Multiply, NBytes) {
+        std::mt19937_64 gen {2};
+        for (size_t as : {1, 7, 8, 9, 32, 191, 193, 500, 1281, 4000})
+            for (size_t bs : {1, 8, 33, 190, 1279, 4001}) {
+                test_N_bytes_times<endian::little> (gen, as, bs);
+                test_N_bytes_times<endian::big> (gen, as, bs);
+            }
+    }
+
+    TEST (Multiply, ZBytes) {
+        std::mt19937_64 gen {3};
+        for (size_t size : {3, 200, 1500}) for (int sa : {1, -1}) for (int sb : {1, -1}) {
+            Z a = Z (N (random_hex (gen, size))) * sa;
+            Z b = Z (N (random_hex (gen, size + 11))) * sb;
+            EXPECT_EQ (Z (Z_bytes_little (a) * Z_bytes_little (b)), a * b);
+            EXPECT_EQ (Z (Z_bytes_big (a) * Z_bytes_big (b)), a * b);
+        }
+    }
+
+    TEST (Multiply, Bounded) {
+        std::mt19937_64 gen {4};
+        N modulus = N (1) << (8 * 256);
+        for (int i = 0; i < 10; i++) {
+            N a = N (random_hex (gen, 256));
+            N b = N (random_hex (gen, 256));
+            EXPECT_EQ (N (uint_little<256> (a) * uint_little<256> (b)), (a * b) % modulus);
+            EXPECT_EQ (N (uint_big<256> (a) * uint_big<256> (b)), (a * b) % modulus);
+        }
+    }
+
+}
@@ -10,8 +10,10 @@
 #include "data/math/number/factor.hpp"
 #include "data/math/number/totient.hpp"
 #include "data/math/number/primitive_root.hpp"
+#include "data/math/number/montgomery.hpp"
 #include "data/tuple.hpp"
 #include "gtest/gtest.h"
+#include <random>
 
 namespace data::math {
 /*
@@ -152,6 +154,62 @@ namespace data::math {
         test_power_mod<hex_uint> ();
     }
 
+    // compare with GMP for big numbers. Even moduli are not done
+    // with Montgomery multiplication, so we test those too.
+    template <typename X> void test_big_power_mod (std::mt19937_64 &gen, size_t size) {
+        auto random_N = [&gen] (size_t size) {
+            bytes z (size);
+            for (byte &x : z) x = static_cast<byte> (gen ());
+            return N ("0x" + encoding::hex::write (z));
+        };
+
+        N base = random_N (size);
+        N exp = random_N (size);
+        N odd = random_N (size);
+        if (!data::odd (odd)) odd += 1;
+        N even = N (odd - 1);
+
+        for (const N &m : {odd, even}) if (m != 0) {
+            EXPECT_EQ (N (data::pow_mod (X (base), X (exp), nonzero {X (m)})), data::pow_mod (base, exp, nonzero {m}))
+                << base << " ^ " << exp << " % " << m;
+            EXPECT_EQ (N (data::pow_mod (X (base), 65537, nonzero {X (m)})), data::pow_mod (base, 65537, nonzero {m}))
+                << base << " ^ 65537 % " << m;
+            EXPECT_EQ (N (data::times_mod (X (base), X (exp), nonzero {X (m)})), (base * exp) % m)
+                << base << " * " << exp << " % " << m;
+        }
+
+        number::montgomery_context<X> context {nonzero {X (odd)}};
+        X a = context.to_mont (X (base));
+        X b = context.to_mont (X (exp));
+        EXPECT_EQ (N (context.from_mont (a)), base % odd);
+        EXPECT_EQ (N (context.from_mont (context.mul (a, b))), (base * exp) % odd);
+        EXPECT_EQ (N (context.from_mont (context.sqr (a))), (base * base) % odd);
+        EXPECT_EQ (N (context.pow_mod (X (base), X (exp))), data::pow_mod (base, exp, nonzero {odd}));
+    }
+
+    TEST (NumberTheory, Montgomery) {
+        std::mt19937_64 gen {1};
+        for (size_t size : {1, 7, 8, 9, 33, 100, 256}) {
+            test_big_power_mod<N> (gen, size);
+            test_big_power_mod<N_bytes_little> (gen, size);
+            test_big_power_mod<N_bytes_big> (gen, size);
+        }
+
+        for (size_t size : {1, 8, 20, 32}) {
+            test_big_power_mod<uint256> (gen, size);
+            test_big_power_mod<uint256_big> (gen, size);
+        }
+
+        // modulus 1 and exponent 0.
+        EXPECT_EQ (data::pow_mod (N_bytes_little {5}, N_bytes_little {3}, nonzero {N_bytes_little {1}}), N_bytes_little {0});
+        EXPECT_EQ (data::pow_mod (N_bytes_little {5}, N_bytes_little {0}, nonzero {N_bytes_little {7}}), N_bytes_little {1});
+        EXPECT_EQ (data::pow_mod (N_bytes_little {0}, N_bytes_little {0}, nonzero {N_bytes_little {8}}), N_bytes_little {1});
+        EXPECT_EQ (data::pow_mod (uint256 {5}, uint256 {0}, nonzero {uint256 {1}}), uint256 {0});
+
+        EXPECT_THROW (number::montgomery_context<N_bytes_little> {nonzero {N_bytes_little {8}}}, exception);
+        EXPECT_THROW (data::pow_mod (N_bytes_little {3}, -1, nonzero {N_bytes_little {7}}), exception);
+    }
+
     TEST (NumberTheory, PrimitiveRoot) {
         EXPECT_EQ ((*number::primitive_root<N> (nonzero<N> {761}, e)), N {6});
     }
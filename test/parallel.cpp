@@ -0,0 +1,95 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/parallel.hpp>
+#include <data/tools/small_vector.hpp>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    template <typename L> L numbers (int n) {
+        if constexpr (detail::is_cross<L>::value) {
+            L z (n);
+            for (int i = 0; i < n; i++) z[i] = i;
+            return z;
+        } else {
+            L z {};
+            if constexpr (Queue<L>) for (int i = 0; i < n; i++) z <<= i;
+            else for (int i = n - 1; i >= 0; i--) z >>= i;
+            return z;
+        }
+    }
+
+    template <typename L> void test_parallel (thread_pool &pool) {
+        for (int n : {0, 1, 7, 1000, 10007}) {
+            L x = numbers<L> (n);
+
+            std::atomic<int64> sum {0};
+            parallel_for_each (pool, [&sum] (const int &i) {
+                sum += i;
+            }, x);
+            EXPECT_EQ (sum.load (), int64 (n) * (n - 1) / 2);
+
+            auto squares = parallel_lift (pool, [] (const int &i) -> int64 {
+                return int64 (i) * i;
+            }, x);
+            EXPECT_EQ (data::size (squares), n);
+            int64 i = 0;
+            for (const int64 &z : squares) {
+                EXPECT_EQ (z, i * i);
+                i++;
+            }
+
+            EXPECT_EQ (parallel_fold (pool, [] (int64 a, int64 b) {
+                return a + b;
+            }, int64 {5}, x), int64 (n) * (n - 1) / 2 + 5);
+
+            // not commutative, so the order must be preserved.
+            EXPECT_EQ (parallel_fold (pool, [] (const std::string &a, const std::string &b) {
+                return a + b;
+            }, std::string {"x"}, parallel_lift (pool, [] (const int &i) {
+                return std::string (1, char ('a' + i % 26));
+            }, x)).size (), n + 1);
+
+            L evens = parallel_select (pool, x, [] (const int &i) {
+                return i % 2 == 0;
+            });
+
+            EXPECT_EQ (data::size (evens), (n + 1) / 2);
+            int e = 0;
+            for (const int &z : evens) {
+                EXPECT_EQ (z, e);
+                e += 2;
+            }
+        }
+    }
+
+    TEST (Parallel, Sequences) {
+        for (uint32 threads : {1, 4}) {
+            thread_pool pool {threads};
+            test_parallel<cross<int>> (pool);
+            test_parallel<cross<int, small_vector<int, 8>>> (pool);
+            test_parallel<stack<int>> (pool);
+            test_parallel<list<int>> (pool);
+            test_parallel<list<int, realtime_queue>> (pool);
+            test_parallel<unrolled_stack<int>> (pool);
+        }
+    }
+
+    TEST (Parallel, FoldOrder) {
+        thread_pool pool {3};
+        list<std::string> words {};
+        std::string expected {};
+        for (int i = 0; i < 500; i++) {
+            std::string w = std::to_string (i) + " ";
+            words <<= w;
+            expected += w;
+        }
+
+        EXPECT_EQ (parallel_fold (pool, [] (const std::string &a, const std::string &b) {
+            return a + b;
+        }, std::string {}, words), expected);
+    }
+
+}
@@ -5,6 +5,8 @@
 #include "data/string.hpp"
 #include "data/container.hpp"
 #include "data/priority_queue.hpp"
+#include <random>
+#include <set>
 #include "gtest/gtest.h"
 
 namespace data {
@@ -132,3 +134,98 @@ TYPED_TEST (PriQue, Insert) {
     using has_insert = decltype (insert (type {}, std::declval<element> ()));
 }
 
+
+namespace data {
+    static_assert (Sequence<pairing_heap<int>, int>);
+    static_assert (Sequence<pairing_heap<int &>, int &>);
+    static_assert (Sequence<pairing_heap<const int *>, const int *>);
+    static_assert (Sequence<pairing_heap<const string &>, const string &>);
+
+    static_assert (Sack<pairing_heap<int>, int>);
+    static_assert (Sack<pairing_heap<const int &>, const int &>);
+    static_assert (Sack<pairing_heap<string>, string>);
+}
+
+TEST (PriorityQueue, PairingHeap) {
+    using namespace data;
+
+    using ph = pairing_heap<int>;
+
+    EXPECT_EQ (ph {}, ph {});
+    EXPECT_THROW (first (ph {}), empty_sequence_exception);
+    EXPECT_EQ (first (ph {} << 1), 1);
+    EXPECT_NE (ph {} << 1, ph {});
+    EXPECT_EQ (ph {} << 1 << 2, ph {} << 2 << 1);
+    EXPECT_EQ (1, first (ph {} << 2 << 1));
+    EXPECT_EQ ((ph {3, 1, 2}), (stack<int> {1, 2, 3}));
+    EXPECT_EQ ((ph {3, 1} & ph {4, 2}), (stack<int> {1, 2, 3, 4}));
+    EXPECT_EQ (values (ph {3, 1, 2}), (stack<int> {1, 2, 3}));
+    EXPECT_EQ ((ph {3, 1, 2}).values (), (stack<int> {1, 2, 3}));
+    EXPECT_TRUE ((ph {3, 1, 2}).contains (2));
+    EXPECT_FALSE ((ph {3, 1, 2}).contains (4));
+    EXPECT_TRUE ((ph {3, 1, 2}).valid ());
+}
+
+// compare against std::multiset under random inserts, merges and removals.
+TEST (PriorityQueue, PairingHeapRandom) {
+    using namespace data;
+
+    using ph = pairing_heap<int>;
+
+    std::mt19937 gen {1};
+    ph h {};
+    std::multiset<int> expected {};
+    for (int i = 0; i < 20000; i++) {
+        int o = gen () % 8;
+        if (o < 4) {
+            int x = gen () % 1000;
+            h <<= x;
+            expected.insert (x);
+        } else if (o < 5) {
+            ph g {};
+            for (int j = gen () % 10; j > 0; j--) {
+                int x = gen () % 1000;
+                g <<= x;
+                expected.insert (x);
+            }
+
+            h = gen () % 2 ? h & g : g & h;
+        } else if (!expected.empty ()) {
+            ASSERT_EQ (h.first (), *expected.begin ());
+            h = h.rest ();
+            expected.erase (expected.begin ());
+        }
+
+        ASSERT_EQ (h.size (), expected.size ());
+        if (i % 1000 == 0) ASSERT_TRUE (h.valid ());
+    }
+
+    EXPECT_TRUE (std::equal (expected.begin (), expected.end (), h.values ().begin ()));
+}
+
+// destroying a deep heap must not overflow the call stack.
+TEST (PriorityQueue, PairingHeapDeep) {
+    using namespace data;
+    pairing_heap<int> h {};
+    for (int i = 1000000; i > 0; i--) h <<= i;
+    EXPECT_EQ (h.first (), 1);
+    EXPECT_EQ (h.rest ().first (), 2);
+}
+
+// assigning over a deep heap releases its nodes, which must not overflow the call stack either.
+TEST (PriorityQueue, PairingHeapDeepAssign) {
+    using namespace data;
+    pairing_heap<int> h {};
+    for (int i = 1; i <= 1000000; i++) h <<= i;
+    h = h.rest ();
+    EXPECT_EQ (h.first (), 2);
+    h = pairing_heap<int> {};
+    EXPECT_TRUE (h.empty ());
+
+    tool::pairing_heap<int, pool::local> p {};
+    for (int i = 1; i <= 1000000; i++) p <<= i;
+    p = p.rest ();
+    EXPECT_EQ (p.first (), 2);
+    p = tool::pairing_heap<int, pool::local> {};
+    EXPECT_TRUE (p.empty ());
+}
@@ -3,42 +3,81 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 
-#include <data/tools/rate_limiter.h>
+#include <data/tools/rate_limiter.hpp>
 #include "gtest/gtest.h"
-#include <iostream>
+#include <thread>
+#include <vector>
 
 namespace data {
-    namespace tools {
-        TEST (RateLimiter, Long) {
-            rate_limiter limiter (3, 10);
-            ASSERT_EQ (limiter.getTime (), 0);
-            ASSERT_EQ (limiter.getTime (), 0);
-            ASSERT_EQ (limiter.getTime (), 0);
-            long time1 = limiter.getTime ();
-            ASSERT_GT (time1, 9);
-            sleep (2);
-            long time2 = limiter.getTime ();
-
-            ASSERT_LT (time2,time1);
-            sleep (time2);
-            ASSERT_EQ (limiter.getTime (), 0);
-            sleep (30);
-            ASSERT_EQ (limiter.getTime (), 0);
-            ASSERT_EQ (limiter.getTime (), 0);
-            ASSERT_EQ (limiter.getTime (), 0);
-        }
 
-        TEST (RateLimiter, Short) {
-            rate_limiter limiter (3, 10);
-            ASSERT_EQ (limiter.getTime (), 0);
-            ASSERT_EQ (limiter.getTime (), 0);
-            ASSERT_EQ (limiter.getTime (), 0);
-            long time1 = limiter.getTime ();
-            ASSERT_GT (time1, 9);
-            sleep (1);
-            long time2 = limiter.getTime ();
-
-            ASSERT_LT (time2, time1);
+    using namespace std::chrono_literals;
+
+    TEST (RateLimiter, Unlimited) {
+        rate_limiter limiter {};
+        EXPECT_TRUE (limiter.unlimited ());
+        for (int i = 0; i < 100; i++) {
+            EXPECT_EQ (limiter.get_time (), 0ms);
+            EXPECT_TRUE (limiter.try_acquire (1000));
         }
     }
+
+    TEST (RateLimiter, Burst) {
+        // 3 actions per 30 ms, so one action comes back every 10 ms.
+        rate_limiter limiter {3, 30ms};
+        EXPECT_EQ (limiter.get_time (), 0ms);
+        EXPECT_EQ (limiter.get_time (), 0ms);
+        EXPECT_EQ (limiter.get_time (), 0ms);
+
+        // the burst is used up. Each further action waits 10 ms longer.
+        millisecond time1 = limiter.get_time ();
+        EXPECT_GT (time1, 5ms);
+        EXPECT_LE (time1, 10ms);
+        millisecond time2 = limiter.get_time ();
+        EXPECT_GT (time2, time1);
+        EXPECT_FALSE (limiter.try_acquire ());
+
+        // a copy shares the same limit.
+        rate_limiter copy = limiter;
+        EXPECT_GT (copy.get_time (), time2);
+
+        std::this_thread::sleep_for (80ms);
+        EXPECT_TRUE (limiter.try_acquire ());
+        EXPECT_TRUE (limiter.try_acquire (2));
+        EXPECT_FALSE (limiter.try_acquire ());
+    }
+
+    TEST (RateLimiter, Threads) {
+        // many threads reserving at once never get more than the limit.
+        rate_limiter limiter {100, 1000ms};
+        std::atomic<int> immediate {0};
+        std::vector<std::thread> threads {};
+        for (int t = 0; t < 8; t++) threads.emplace_back ([&] {
+            for (int i = 0; i < 50; i++) if (limiter.reserve () == 0ns) immediate++;
+        });
+
+        for (auto &t : threads) t.join ();
+        EXPECT_GE (immediate.load (), 100);
+        // a little is refilled while the threads are running.
+        EXPECT_LE (immediate.load (), 110);
+    }
+
+    TEST (RateLimiter, Acquire) {
+        rate_limiter limiter {2, 20ms};
+        auto start = rate_limiter::clock::now ();
+        synced ([&limiter] () -> awaitable<void> {
+            for (int i = 0; i < 4; i++) co_await limiter.acquire ();
+        });
+
+        // two come back after 20 ms.
+        EXPECT_GE (rate_limiter::clock::now () - start, 19ms);
+    }
+
+    TEST (RateLimiter, Keys) {
+        rate_limiters<std::string> limiters {1, 1000ms};
+        EXPECT_TRUE (limiters.try_acquire ("a"));
+        EXPECT_FALSE (limiters.try_acquire ("a"));
+        EXPECT_TRUE (limiters.try_acquire ("b"));
+        EXPECT_FALSE (limiters["b"].try_acquire ());
+        EXPECT_EQ (limiters.size (), 2);
+    }
 }
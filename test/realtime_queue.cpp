@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/list.hpp>
+#include <data/container.hpp>
+#include <data/string.hpp>
+#include <random>
+#include <deque>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    using queue = list<int, realtime_queue>;
+
+    static_assert (Same<queue, realtime_queue<stack<int>, int>>);
+    static_assert (Same<list<int>, functional_queue<stack<int>, int>>);
+
+    static_assert (Queue<list<int, realtime_queue>>);
+    static_assert (Queue<list<const int, realtime_queue>>);
+    static_assert (Queue<list<int *, realtime_queue>>);
+    static_assert (Queue<list<const int &, realtime_queue>>);
+    static_assert (Queue<list<string, realtime_queue>>);
+
+    static_assert (Container<queue, int>);
+    static_assert (ConstIterable<queue>);
+    static_assert (ConstIterable<list<const int &, realtime_queue>>);
+
+    void expect_same (const queue &q, const std::deque<int> &expected) {
+        ASSERT_EQ (q.size (), expected.size ());
+        ASSERT_EQ (q.empty (), expected.empty ());
+        EXPECT_TRUE (std::equal (q.begin (), q.end (), expected.begin (), expected.end ()));
+        if (expected.size () > 0) {
+            EXPECT_EQ (q.first (), expected.front ());
+            EXPECT_EQ (last (q), expected.back ());
+        }
+    }
+
+    TEST (RealtimeQueue, Basic) {
+        queue q {1, 2, 3};
+        expect_same (q, {1, 2, 3});
+        expect_same (q.rest (), {2, 3});
+        expect_same (q >> 0, {0, 1, 2, 3});
+        expect_same (q << 4, {1, 2, 3, 4});
+        expect_same (q + queue {4, 5}, {1, 2, 3, 4, 5});
+        EXPECT_EQ (q, (list<int> {1, 2, 3}));
+        EXPECT_NE (q, (list<int> {1, 2}));
+        EXPECT_EQ (q[2], 3);
+        EXPECT_THROW (q[3], empty_sequence_exception);
+        EXPECT_THROW (last (queue {}), empty_sequence_exception);
+        EXPECT_EQ (q.rest ().rest ().rest (), queue {});
+    }
+
+    // random operations compared against std::deque.
+    TEST (RealtimeQueue, Random) {
+        std::mt19937 gen {1};
+        std::uniform_int_distribution<int> op {0, 9};
+        queue q {};
+        std::deque<int> expected {};
+        for (int i = 0; i < 20000; i++) {
+            int o = op (gen);
+            if (o < 5) {
+                q <<= i;
+                expected.push_back (i);
+            } else if (o < 6) {
+                q >>= i;
+                expected.push_front (i);
+            } else if (!expected.empty ()) {
+                q = q.rest ();
+                expected.pop_front ();
+            }
+
+            ASSERT_EQ (q.size (), expected.size ());
+            if (!expected.empty ()) {
+                ASSERT_EQ (q.first (), expected.front ());
+                ASSERT_EQ (last (q), expected.back ());
+            }
+
+            if (i % 1000 == 0) expect_same (q, expected);
+        }
+
+        expect_same (q, expected);
+    }
+
+    // old versions of the queue remain valid while rotations
+    // are in progress on newer versions.
+    TEST (RealtimeQueue, Persistence) {
+        std::vector<queue> versions {queue {}};
+        std::vector<std::deque<int>> expected {{}};
+        std::mt19937 gen {2};
+        for (int i = 0; i < 2000; i++) {
+            size_t from = std::uniform_int_distribution<size_t> {0, versions.size () - 1} (gen);
+            queue q = versions[from];
+            std::deque<int> e = expected[from];
+            if (e.empty () || gen () % 3 != 0) {
+                q <<= i;
+                e.push_back (i);
+            } else {
+                q = q.rest ();
+                e.pop_front ();
+            }
+
+            versions.push_back (q);
+            expected.push_back (e);
+        }
+
+        for (size_t i = 0; i < versions.size (); i++) expect_same (versions[i], expected[i]);
+    }
+
+    TEST (RealtimeQueue, Convert) {
+        list<int, realtime_queue> q {1, 2, 3};
+        list<const int &, realtime_queue> r = q;
+        EXPECT_EQ (r, q);
+    }
+
+}
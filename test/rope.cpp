@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/bytes.hpp>
+#include <data/tools/rope.hpp>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    bytes test_pattern (size_t size) {
+        bytes z (size);
+        for (size_t i = 0; i < size; i++) z[i] = byte (i * 7 + i / 251);
+        return z;
+    }
+
+    // write x in pieces of the given sizes, repeating them until all of it is written.
+    void write_in_pieces (writer<byte> &w, const bytes &x, std::initializer_list<size_t> pieces) {
+        size_t at = 0;
+        while (at < x.size ()) for (size_t p : pieces) {
+            size_t n = std::min (p, x.size () - at);
+            w.write (x.data () + at, n);
+            at += n;
+        }
+    }
+
+    TEST (Rope, Write) {
+        for (size_t size : {0, 1, 100, 1023, 1024, 1025, 5000, 300000}) {
+            bytes expected = test_pattern (size);
+
+            rope<byte> r {};
+            write_in_pieces (r, expected, {1, 7, 300, 2000, 3});
+            EXPECT_EQ (r.size (), size);
+            EXPECT_EQ (r.empty (), size == 0);
+            EXPECT_EQ (r.flatten<bytes> (), expected);
+
+            size_t total = 0;
+            for (slice<const byte> s : r.segments ()) {
+                EXPECT_GT (s.size (), 0);
+                EXPECT_EQ (bytes (s), bytes (slice<const byte> (expected).range (total, total + s.size ())));
+                total += s.size ();
+            }
+
+            EXPECT_EQ (total, size);
+            if (size > 0) EXPECT_EQ (r[size - 1], expected[size - 1]);
+
+            // segments grow, so there are not too many of them.
+            EXPECT_LE (r.segments ().size (), 12);
+
+            rope<byte> copied {r};
+            EXPECT_EQ (std::move (copied).flatten<std::vector<byte>> (), std::vector<byte> (expected.begin (), expected.end ()));
+        }
+    }
+
+    TEST (Rope, Append) {
+        rope<byte> r {};
+        r << byte (1);
+        r.append (std::vector<byte> {2, 3, 4});
+        r << byte (5);
+        EXPECT_EQ (r.size (), 5);
+        EXPECT_EQ (r.flatten<bytes> (), (bytes {1, 2, 3, 4, 5}));
+
+        rope<byte> q {};
+        q << r;
+        EXPECT_EQ (q.flatten<bytes> (), (bytes {1, 2, 3, 4, 5}));
+
+        r.clear ();
+        EXPECT_TRUE (r.empty ());
+        EXPECT_EQ (r.flatten<bytes> (), bytes {});
+    }
+
+    // writes that cross from one segment into the next must not repeat anything.
+    TEST (Rope, LazyWriter) {
+        for (size_t size : {0, 10, 1024, 1500, 4000, 100000}) {
+            bytes expected = test_pattern (size);
+            bytes written = write<bytes> ([&expected] (auto &&w) {
+                write_in_pieces (w, expected, {1000, 13});
+            });
+
+            EXPECT_EQ (written, expected);
+
+            rope<byte> r = write<rope<byte>> ([&expected] (auto &&w) {
+                write_in_pieces (w, expected, {1000, 13});
+                EXPECT_EQ (w.size (), expected.size ());
+            });
+
+            EXPECT_EQ (r.flatten<bytes> (), expected);
+        }
+
+        EXPECT_EQ ((write<rope<byte>> (byte (0x76), uint32_little (12))).flatten<bytes> (), (bytes {0x76, 0x0c, 0x00, 0x00, 0x00}));
+    }
+
+}
@@ -0,0 +1,211 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/list.hpp>
+#include <data/container.hpp>
+#include <data/string.hpp>
+#include <numeric>
+#include <random>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    static_assert (List<rrb_vector<int>>);
+    static_assert (List<rrb_vector<const int>>);
+    static_assert (List<rrb_vector<int *>>);
+    static_assert (List<rrb_vector<int &>>);
+    static_assert (List<rrb_vector<const int &>>);
+    static_assert (List<rrb_vector<string>>);
+
+    static_assert (Container<rrb_vector<int>, int>);
+    static_assert (ConstIterable<rrb_vector<int>>);
+    static_assert (ConstIterable<rrb_vector<const int &>>);
+
+    using vector = rrb_vector<int>;
+
+    void expect_same (const vector &v, const std::vector<int> &expected) {
+        ASSERT_EQ (v.size (), expected.size ());
+        EXPECT_TRUE (std::equal (v.begin (), v.end (), expected.begin (), expected.end ()));
+        for (size_t i = 0; i < expected.size (); i++) ASSERT_EQ (v[i], expected[i]);
+        if (expected.size () > 0) {
+            EXPECT_EQ (v.first (), expected.front ());
+            EXPECT_EQ (last (v), expected.back ());
+        }
+    }
+
+    std::vector<int> make (int begin, int end) {
+        std::vector<int> v {};
+        for (int i = begin; i < end; i++) v.push_back (i);
+        return v;
+    }
+
+    TEST (RRBVector, Pend) {
+        vector a {};
+        vector b {};
+        std::vector<int> expected_a {};
+        std::vector<int> expected_b {};
+        for (int i = 0; i < 3000; i++) {
+            a = a << i;
+            b = b >> i;
+            expected_a.push_back (i);
+            expected_b.insert (expected_b.begin (), i);
+        }
+
+        expect_same (a, expected_a);
+        expect_same (b, expected_b);
+        expect_same (reverse (a), expected_b);
+        list<int> l {};
+        for (int i : expected_a) l <<= i;
+        EXPECT_EQ (a, l);
+
+        EXPECT_EQ (vector {}, vector {});
+        EXPECT_EQ ((vector {1, 2, 3}), (vector {} << 1 << 2 << 3));
+        EXPECT_EQ ((vector {1, 2, 3}), (vector {} >> 3 >> 2 >> 1));
+        EXPECT_NE ((vector {1, 2, 3}), (vector {1, 2}));
+        EXPECT_THROW (vector {}.first (), empty_sequence_exception);
+    }
+
+    TEST (RRBVector, Slice) {
+        for (int n : {1, 31, 32, 33, 1024, 1025, 5000}) {
+            std::vector<int> expected = make (0, n);
+            vector v (expected.begin (), expected.end ());
+            expect_same (v, expected);
+
+            for (int i : {0, 1, 31, 32, 33, n / 2, n - 1, n}) {
+                if (i > n) continue;
+                expect_same (take (v, i), std::vector<int> (expected.begin (), expected.begin () + i));
+                expect_same (drop (v, i), std::vector<int> (expected.begin () + i, expected.end ()));
+            }
+
+            // rest all the way down.
+            vector r = v;
+            for (int i = 0; i < n; i++) {
+                ASSERT_EQ (r.first (), i);
+                r = r.rest ();
+            }
+
+            EXPECT_TRUE (r.empty ());
+        }
+    }
+
+    TEST (RRBVector, Concat) {
+        std::mt19937 gen {3};
+
+        // concatenate vectors of many different sizes.
+        for (int a : {0, 1, 2, 31, 32, 33, 100, 1023, 1024, 1025, 40000})
+            for (int b : {0, 1, 2, 31, 32, 33, 100, 1023, 1024, 1025, 40000}) {
+                std::vector<int> x = make (0, a);
+                std::vector<int> y = make (a, a + b);
+                std::vector<int> z = x;
+                z.insert (z.end (), y.begin (), y.end ());
+                expect_same (vector (x.begin (), x.end ()) + vector (y.begin (), y.end ()), z);
+                expect_same (join (vector (x.begin (), x.end ()), vector (y.begin (), y.end ())), z);
+            }
+
+        // random sequence of concatenations, slices and pends.
+        vector v {};
+        std::vector<int> expected {};
+        int next = 0;
+        for (int round = 0; round < 400; round++) {
+            switch (gen () % 5) {
+                case 0: {
+                    size_t n = gen () % 200;
+                    std::vector<int> w = make (next, next + n);
+                    next += n;
+                    v = v + vector (w.begin (), w.end ());
+                    expected.insert (expected.end (), w.begin (), w.end ());
+                    break;
+                }
+                case 1: {
+                    size_t n = gen () % 200;
+                    std::vector<int> w = make (next, next + n);
+                    next += n;
+                    v = vector (w.begin (), w.end ()) + v;
+                    expected.insert (expected.begin (), w.begin (), w.end ());
+                    break;
+                }
+                case 2: {
+                    size_t b = expected.size () == 0 ? 0 : gen () % expected.size ();
+                    size_t e = b + (expected.size () == b ? 0 : gen () % (expected.size () - b));
+                    v = v.slice (b, e) + v;
+                    std::vector<int> w (expected.begin () + b, expected.begin () + e);
+                    expected.insert (expected.begin (), w.begin (), w.end ());
+                    break;
+                }
+                case 3: {
+                    v = v << next;
+                    expected.push_back (next++);
+                    v = v >> next;
+                    expected.insert (expected.begin (), next++);
+                    break;
+                }
+                default: {
+                    if (expected.size () > 10000) {
+                        size_t b = gen () % (expected.size () / 2);
+                        v = v.drop (b);
+                        expected.erase (expected.begin (), expected.begin () + b);
+                    }
+                }
+            }
+
+            expect_same (v, expected);
+        }
+    }
+
+    TEST (RRBVector, Index) {
+        vector v {1, 2, 3};
+        EXPECT_EQ (v[2], 3);
+        EXPECT_THROW (v[3], std::out_of_range);
+        EXPECT_THROW (vector {}[0], std::out_of_range);
+    }
+
+    // the plan for rebalancing nodes must keep every element and fill no node past the width.
+    void test_plan (const std::vector<size_t> &slots, size_t expected_nodes) {
+        std::vector<size_t> plan = detail::rrb_plan (slots, 32, 2);
+        EXPECT_EQ (plan.size (), expected_nodes);
+        EXPECT_EQ (std::accumulate (plan.begin (), plan.end (), size_t {0}),
+            std::accumulate (slots.begin (), slots.end (), size_t {0}));
+        for (size_t x : plan) {
+            EXPECT_GT (x, 0);
+            EXPECT_LE (x, 32);
+        }
+    }
+
+    TEST (RRBVector, Plan) {
+        test_plan ({32, 32}, 2);
+        test_plan ({1, 1, 1, 1, 1}, 3);
+        test_plan ({16, 16, 16, 16, 16, 16}, 5);
+        test_plan ({32, 1, 32, 1, 32, 1, 32}, 7);
+
+        // the small node is spread over the last node, which cannot take all of it.
+        std::vector<size_t> slots (70, 31);
+        slots.push_back (2);
+        slots.push_back (31);
+        test_plan (slots, 72);
+        EXPECT_EQ (detail::rrb_plan (slots, 32, 2).back (), 1);
+
+        std::mt19937 gen {5};
+        for (int round = 0; round < 1000; round++) {
+            std::vector<size_t> random (1 + gen () % 100);
+            for (size_t &x : random) x = 1 + gen () % 32;
+            std::vector<size_t> plan = detail::rrb_plan (random, 32, 2);
+            EXPECT_EQ (std::accumulate (plan.begin (), plan.end (), size_t {0}),
+                std::accumulate (random.begin (), random.end (), size_t {0}));
+            for (size_t x : plan) EXPECT_LE (x, 32);
+        }
+    }
+
+    TEST (RRBVector, Reference) {
+        int i = 1, j = 2, k = 3;
+        rrb_vector<int &> x {i, j, k};
+        rrb_vector<const int &> y {i, j, k};
+        i = 10;
+        EXPECT_EQ (x[0], 10);
+        EXPECT_EQ (y.first (), 10);
+
+        rrb_vector<string> s {"a", "b"};
+        EXPECT_EQ (s + s, (rrb_vector<string> {"a", "b", "a", "b"}));
+    }
+
+}
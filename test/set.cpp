@@ -4,6 +4,9 @@
 
 #include <data/set.hpp>
 #include <data/numbers.hpp>
+#include <set>
+#include <algorithm>
+#include <random>
 #include "gtest/gtest.h"
 
 namespace data {
@@ -60,6 +63,166 @@ namespace data {
         set<const N> dx;
     }
 
+    template <typename X> bool balanced (const set<X> &x) {
+        return RB::valid<X> (static_cast<const tree<RB::colored<X>> &> (x));
+    }
+
+    TEST (Set, Balanced) {
+        set<int> ascending {};
+        set<int> descending {};
+        for (int i = 0; i < 1000; i++) {
+            ascending = ascending.insert (i);
+            descending = descending.insert (999 - i);
+        }
+
+        EXPECT_TRUE (balanced (ascending));
+        EXPECT_TRUE (balanced (descending));
+        EXPECT_EQ (ascending, descending);
+    }
+
+    TEST (Set, Remove) {
+        set<int> x {};
+        std::set<int> expected {};
+        std::mt19937 gen {42};
+
+        for (int i = 0; i < 5000; i++) {
+            int n = gen () % 1000;
+            if (gen () % 3 == 0) {
+                x = remove (x, n);
+                expected.erase (n);
+            } else {
+                x = x.insert (n);
+                expected.insert (n);
+            }
+
+            if (i % 100 == 0) EXPECT_TRUE (balanced (x));
+        }
+
+        EXPECT_TRUE (balanced (x));
+        EXPECT_EQ (x.size (), expected.size ());
+        EXPECT_TRUE (std::equal (x.begin (), x.end (), expected.begin (), expected.end ()));
+
+        // removing an element that is not there returns the same set.
+        set<int> y {1, 2, 3};
+        EXPECT_EQ (y.remove (4), y);
+        EXPECT_EQ (y.remove (2), (set<int> {1, 3}));
+        EXPECT_EQ (y, (set<int> {1, 2, 3}));
+        EXPECT_EQ (y.remove (1).remove (2).remove (3), set<int> {});
+        EXPECT_EQ (erase (y, 3), (set<int> {1, 2}));
+    }
+
+    TEST (Set, FromSorted) {
+        EXPECT_EQ (set<int>::from_sorted (cross<int> {}), set<int> {});
+        EXPECT_EQ (set<int>::from_sorted (cross<int> {1, 1, 2, 3, 3, 3, 5}), (set<int> {1, 2, 3, 5}));
+        EXPECT_THROW (set<int>::from_sorted (cross<int> {1, 3, 2}), exception);
+        EXPECT_EQ (set<int>::from_sorted (ordered_sequence<int> {4, 2, 9, 2}), (set<int> {2, 4, 9}));
+
+        // every size up to a few full levels must produce a balanced tree.
+        for (int n = 0; n < 300; n++) {
+            cross<int> values (n);
+            for (int i = 0; i < n; i++) values[i] = 2 * i;
+
+            set<int> x = set<int>::from_sorted_unique (values.begin (), values.end ());
+            EXPECT_TRUE (balanced (x)) << "n = " << n;
+            EXPECT_EQ (x.size (), n);
+            EXPECT_TRUE (std::equal (x.begin (), x.end (), values.begin (), values.end ()));
+
+            // the result is a normal set that can be modified.
+            set<int> y = x.insert (n + 1).remove (0);
+            EXPECT_TRUE (balanced (y));
+            EXPECT_TRUE (y.contains (n + 1));
+        }
+    }
+
+    set<int> random_set (std::mt19937 &gen, int size, int range) {
+        set<int> x {};
+        for (int i = 0; i < size; i++) x = x.insert (gen () % range);
+        return x;
+    }
+
+    std::set<int> to_std (const set<int> &x) {
+        return std::set<int> (x.begin (), x.end ());
+    }
+
+    TEST (Set, Transient) {
+        std::mt19937 gen {7};
+        std::uniform_int_distribution<int> dist {0, 999};
+
+        set<int> x {};
+        std::set<int> expected {};
+        for (int i = 0; i < 100; i++) {
+            int z = dist (gen);
+            x = x.insert (z);
+            expected.insert (z);
+        }
+
+        set<int> before = x;
+        set<int>::transient t {x};
+        for (int i = 0; i < 2000; i++) {
+            int z = dist (gen);
+            t.insert (z);
+            expected.insert (z);
+        }
+
+        EXPECT_EQ (t.size (), expected.size ());
+        set<int> y = t.freeze ();
+        EXPECT_TRUE (balanced (y));
+        EXPECT_TRUE (t.empty ());
+        EXPECT_EQ (y.size (), expected.size ());
+        EXPECT_TRUE (std::equal (y.begin (), y.end (), expected.begin (), expected.end ()));
+
+        // the tree that the transient was made from is unchanged.
+        EXPECT_EQ (x, before);
+        EXPECT_TRUE (balanced (x));
+
+        set<int>::transient ascending {};
+        for (int i = 0; i < 1000; i++) ascending.insert (i);
+        set<int> a = ascending.freeze ();
+        EXPECT_TRUE (balanced (a));
+        EXPECT_EQ (a.size (), 1000);
+        int i = 0;
+        for (int z : a) EXPECT_EQ (z, i++);
+    }
+
+    TEST (Set, Operations) {
+        std::mt19937 gen {7};
+        auto keep = [] (int a, int) -> int { return a; };
+
+        for (RB::parallel p : {RB::parallel {}, RB::parallel {4, 64}})
+            for (auto [m, n] : std::vector<std::pair<int, int>> {{0, 0}, {0, 10}, {10, 0}, {1, 1000}, {50, 2000}, {1000, 1000}, {3000, 100}}) {
+                set<int> a = random_set (gen, m, 4000);
+                set<int> b = random_set (gen, n, 4000);
+                std::set<int> sa = to_std (a);
+                std::set<int> sb = to_std (b);
+
+                std::set<int> expected_union, expected_intersection, expected_difference, expected_symmetric;
+                std::set_union (sa.begin (), sa.end (), sb.begin (), sb.end (), std::inserter (expected_union, expected_union.end ()));
+                std::set_intersection (sa.begin (), sa.end (), sb.begin (), sb.end (), std::inserter (expected_intersection, expected_intersection.end ()));
+                std::set_difference (sa.begin (), sa.end (), sb.begin (), sb.end (), std::inserter (expected_difference, expected_difference.end ()));
+                std::set_symmetric_difference (sa.begin (), sa.end (), sb.begin (), sb.end (), std::inserter (expected_symmetric, expected_symmetric.end ()));
+
+                set<int> u = RB::merge (a, b, keep, p);
+                set<int> i = RB::intersect (a, b, keep, p);
+                set<int> d = RB::difference (a, b, p);
+                set<int> s = RB::symmetric_difference (a, b, p);
+
+                EXPECT_TRUE (balanced (u));
+                EXPECT_TRUE (balanced (i));
+                EXPECT_TRUE (balanced (d));
+                EXPECT_TRUE (balanced (s));
+
+                EXPECT_EQ (to_std (u), expected_union);
+                EXPECT_EQ (to_std (i), expected_intersection);
+                EXPECT_EQ (to_std (d), expected_difference);
+                EXPECT_EQ (to_std (s), expected_symmetric);
+
+                EXPECT_EQ (u.size (), expected_union.size ());
+                EXPECT_EQ (a | b, u);
+                EXPECT_EQ (a & b, i);
+                EXPECT_EQ (a ^ b, s);
+            }
+    }
+
     // TODO a lot more tests are needed here.
 
 }
@@ -0,0 +1,145 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/tools/small_vector.hpp>
+#include <data/bytes.hpp>
+#include <data/numbers.hpp>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    // apply the same operations to a small_vector and a std::vector and
+    // check that they agree as the small_vector moves to the heap.
+    TEST (SmallVector, LikeVector) {
+        small_vector<int, 4> s {};
+        std::vector<int> v {};
+
+        auto check = [&] {
+            ASSERT_EQ (s.size (), v.size ());
+            EXPECT_TRUE (std::equal (s.begin (), s.end (), v.begin ()));
+            EXPECT_EQ (s.is_inline (), s.capacity () == 4);
+        };
+
+        check ();
+        EXPECT_TRUE (s.is_inline ());
+
+        for (int i = 0; i < 3; i++) {
+            s.push_back (i);
+            v.push_back (i);
+        }
+
+        check ();
+        EXPECT_TRUE (s.is_inline ());
+
+        s.insert (s.begin () + 1, 10);
+        v.insert (v.begin () + 1, 10);
+        check ();
+        EXPECT_TRUE (s.is_inline ());
+
+        s.insert (s.end (), {20, 21, 22});
+        v.insert (v.end (), {20, 21, 22});
+        check ();
+        EXPECT_FALSE (s.is_inline ());
+
+        std::vector<int> part {30, 31, 32};
+        s.insert (s.begin (), part.begin (), part.end ());
+        v.insert (v.begin (), part.begin (), part.end ());
+        check ();
+
+        s.erase (s.begin () + 1, s.begin () + 4);
+        v.erase (v.begin () + 1, v.begin () + 4);
+        check ();
+
+        s.erase (s.begin ());
+        v.erase (v.begin ());
+        check ();
+
+        s.resize (12);
+        v.resize (12);
+        check ();
+        EXPECT_EQ (s.back (), 0);
+
+        s.resize (3);
+        v.resize (3);
+        s.shrink_to_fit ();
+        check ();
+        EXPECT_TRUE (s.is_inline ());
+
+        s.push_back (s[0]);
+        v.push_back (v[0]);
+        check ();
+
+        // fill with one of our own elements while the buffer moves
+        // to the heap and then to a bigger buffer on the heap.
+        s.resize (100, s[1]);
+        v.resize (100, v[1]);
+        check ();
+        s.resize (1000, s[2]);
+        v.resize (1000, v[2]);
+        check ();
+    }
+
+    TEST (SmallVector, CopyAndMove) {
+        for (size_t n : {0, 3, 4, 5, 100}) {
+            small_vector<uint16, 4> a (n);
+            for (size_t i = 0; i < n; i++) a[i] = uint16 (i * 3);
+
+            small_vector<uint16, 4> b {a};
+            EXPECT_EQ (a, b);
+            EXPECT_NE (a.data (), b.data ());
+
+            small_vector<uint16, 4> c {std::move (b)};
+            EXPECT_EQ (a, c);
+            EXPECT_TRUE (b.empty ());
+            EXPECT_EQ (c.is_inline (), n <= 4);
+
+            small_vector<uint16, 4> d (7, 1);
+            d = c;
+            EXPECT_EQ (a, d);
+
+            small_vector<uint16, 4> e {1, 2};
+            e = std::move (d);
+            EXPECT_EQ (a, e);
+
+            e.swap (b);
+            EXPECT_EQ (a, b);
+            EXPECT_TRUE (e.empty ());
+
+            if (n > 0) {
+                EXPECT_LT ((small_vector<uint16, 4> {}), a);
+                EXPECT_EQ ((small_vector<uint16, 4> {} <=> a), std::strong_ordering::less);
+            }
+        }
+    }
+
+    // bytes that fit are stored inline and behave the same as before.
+    TEST (SmallVector, Bytes) {
+#if DATA_BYTES_INLINE_CAPACITY >= 33
+        {
+            bytes digest (32);
+            EXPECT_TRUE (digest.is_inline ());
+            EXPECT_EQ (digest, bytes (32, 0));
+
+            bytes key = *encoding::hex::read ("0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798");
+            EXPECT_EQ (key.size (), 33);
+            EXPECT_TRUE (key.is_inline ());
+            EXPECT_EQ (key[-1], 0x98);
+            EXPECT_EQ (bytes (slice<const byte> (key)), key);
+
+            bytes script = write<bytes> (100, key, digest, key, bytes (2));
+            EXPECT_FALSE (script.is_inline ());
+            EXPECT_EQ (bytes (slice<const byte> (script).range (33, 65)), digest);
+        }
+#endif
+
+        using N = math::N_bytes<endian::little>;
+        using Z = math::Z_bytes<endian::big>;
+
+        N a = N::read ("0xffffffffffffffffffffffffffffffff");
+        EXPECT_EQ (a + 1, N::read ("0x0100000000000000000000000000000000"));
+        Z z {-5};
+        EXPECT_EQ (z * z * z, Z {-125});
+    }
+
+}
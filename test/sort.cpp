@@ -7,6 +7,7 @@
 #include <data/ordered_sequence.hpp>
 #include <data/priority_queue.hpp>
 #include <data/cross.hpp>
+#include <random>
 #include "gtest/gtest.h"
 
 namespace data {
@@ -73,4 +74,52 @@ namespace data {
 
     }
     
+    TEST (SortTest, ParallelSort) {
+
+        std::mt19937 rng {7};
+        for (size_t n : {0, 1, 5, 1000, 20000, 100003}) for (uint32 threads : {1, 2, 3, 8}) {
+            std::vector<int> v (n);
+            // few distinct values so that there are many ties.
+            for (int &x : v) x = rng () % 1000;
+            std::vector<int> expected = v;
+            std::sort (expected.begin (), expected.end ());
+
+            parallel_sort (threads, v.begin (), v.end ());
+            EXPECT_EQ (v, expected);
+
+            thread_pool pool {threads};
+            std::shuffle (v.begin (), v.end (), rng);
+            parallel_sort (pool, v.begin (), v.end (), std::greater<> {});
+            EXPECT_EQ (v, std::vector<int> (expected.rbegin (), expected.rend ()));
+        }
+
+        stack<int> s {};
+        list<int> l {};
+        cross<int> c {};
+        for (int i = 0; i < 50000; i++) {
+            int x = rng () % 100000;
+            s >>= x;
+            l <<= x;
+            c.push_back (x);
+        }
+
+        // data::sorted recurses once per element, which is too deep for these.
+        auto ss = sort (s, 4);
+        EXPECT_TRUE (std::is_sorted (ss.begin (), ss.end ()));
+        EXPECT_EQ (size (ss), 50000);
+
+        thread_pool pool {3};
+        auto ll = sort (l, pool);
+        EXPECT_TRUE (std::is_sorted (ll.begin (), ll.end ()));
+        EXPECT_EQ (size (ll), 50000);
+
+        auto cc = sort (c, pool);
+        EXPECT_TRUE (std::is_sorted (cc.begin (), cc.end ()));
+        std::sort (c.begin (), c.end ());
+        EXPECT_EQ (cc, c);
+
+        sort_test_case (list<int> {4, 5, 1, 3, 2}, sort (list<int> {4, 5, 1, 3, 2}, 2));
+
+    }
+
 }
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/tools/thread_pool.hpp>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    TEST (ThreadPool, NUMA) {
+        auto nodes = numa_nodes ();
+        EXPECT_GT (nodes.size (), 0);
+        for (const auto &n : nodes) EXPECT_GT (n.size (), 0);
+    }
+
+    TEST (ThreadPool, Run) {
+        for (placement p : {placement::none, placement::cores, placement::numa}) for (uint32 threads : {1, 3, 8}) {
+            thread_pool pool {thread_pool::options {threads, p}};
+            EXPECT_EQ (pool.size (), threads);
+            EXPECT_EQ (thread_pool::current (), nullptr);
+
+            std::atomic<uint64> count {0};
+            for (int i = 0; i < 1000; i++) pool.post ([&count] {
+                count++;
+            });
+
+            pool.wait ();
+            EXPECT_EQ (count.load (), 1000);
+
+            // tasks that post more tasks.
+            count = 0;
+            function<void (int)> tree = [&] (int depth) {
+                count++;
+                EXPECT_EQ (thread_pool::current (), &pool);
+                EXPECT_LT (thread_pool::current_index (), threads);
+                if (depth > 0) for (int i = 0; i < 2; i++) pool.post ([&tree, depth] {
+                    tree (depth - 1);
+                });
+            };
+
+            pool.post ([&tree] {
+                tree (10);
+            });
+
+            pool.wait ();
+            EXPECT_EQ (count.load (), 2047);
+            EXPECT_EQ (pool.completed (), 1000 + 2047);
+        }
+    }
+
+    TEST (ThreadPool, Exception) {
+        thread_pool pool {4};
+        std::atomic<uint64> count {0};
+        for (int i = 0; i < 100; i++) pool.post ([&count, i] {
+            count++;
+            if (i == 50) throw std::logic_error {"task failed"};
+        });
+
+        EXPECT_THROW (pool.wait (), std::logic_error);
+        EXPECT_TRUE (pool.stopped ());
+
+        // posting to a stopped pool does nothing.
+        pool.post ([&count] {
+            count += 1000;
+        });
+
+        EXPECT_LT (count.load (), 1000);
+    }
+
+}
@@ -164,6 +164,29 @@ namespace data {
         (void) (tree<int *> {} == tree<int const* const> {});
     }
 
+    template <typename alloc> void test_tree_storage () {
+        using type = linked_tree<int, alloc>;
+        static_assert (functional::buildable_tree<type>);
+
+        type t {1, type {2, type {3}, type {}}, type {4}};
+        EXPECT_EQ (t.size (), 4);
+        EXPECT_EQ (t.left ().size (), 2);
+        EXPECT_EQ (t.right ().root (), 4);
+        EXPECT_EQ (functional::values_infix<stack<int>> (t), (stack<int> {3, 2, 1, 4}));
+
+        RB::tree<int, linked_tree<RB::colored<int>, alloc>> rb {};
+        for (int i = 0; i < 100; i++) rb = rb.insert (i * 37 % 101);
+        EXPECT_EQ (rb.size (), 100);
+        EXPECT_TRUE (rb.contains (74));
+        EXPECT_FALSE (rb.contains (64));
+    }
+
+    TEST (Tree, Storage) {
+        test_tree_storage<pool::shared> ();
+        test_tree_storage<pool::local> ();
+        test_tree_storage<pool::concurrent> ();
+    }
+
     template <typename X>
     using bxt = binary_search_tree<X, linked_tree<X>>;
 
@@ -0,0 +1,155 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <data/list.hpp>
+#include <data/container.hpp>
+#include <data/string.hpp>
+#include <data/select.hpp>
+#include "gtest/gtest.h"
+
+namespace data {
+
+    template <typename X> using unrolled = unrolled_stack<X, 4>;
+
+    static_assert (Stack<unrolled<int>>);
+    static_assert (Stack<unrolled<const int>>);
+    static_assert (Stack<unrolled<int *>>);
+    static_assert (Stack<unrolled<int &>>);
+    static_assert (Stack<unrolled<const int &>>);
+    static_assert (Stack<unrolled<string>>);
+
+    static_assert (Container<unrolled<int>, int>);
+    static_assert (Container<const unrolled<int>, const int>);
+    static_assert (Container<unrolled<int &>, int &>);
+
+    static_assert (ConstIterable<unrolled<int>>);
+    static_assert (ConstIterable<unrolled<const int &>>);
+    static_assert (Iterable<unrolled<int>>);
+    static_assert (Iterable<unrolled<int &>>);
+
+    template <typename alloc> void test_unrolled (size_t n) {
+        using stack = unrolled_stack<int, 4, alloc>;
+        using compare = linked_stack<int>;
+
+        stack s {};
+        compare c {};
+        for (int i = 0; i < int (n); i++) {
+            s >>= i;
+            c >>= i;
+            EXPECT_EQ (s.size (), size_t (i + 1));
+            EXPECT_EQ (s.first (), i);
+        }
+
+        EXPECT_EQ (s, c);
+        EXPECT_TRUE (c == s);
+        for (size_t i = 0; i < n; i++) {
+            EXPECT_EQ (s[i], c[i]);
+            EXPECT_EQ (s.from (i), c.from (i));
+            EXPECT_EQ (drop (s, i), drop (c, i));
+        }
+
+        EXPECT_EQ (s.from (n), stack {});
+        EXPECT_EQ (reverse (s), reverse (c));
+        EXPECT_EQ (s + s, c + c);
+        EXPECT_FALSE (s.contains (int (n)));
+        if (n > 0) {
+            EXPECT_EQ (last (s), 0);
+            EXPECT_TRUE (s.contains (0));
+        } else EXPECT_THROW (last (s), empty_sequence_exception);
+
+        // walk down with rest.
+        stack r = s;
+        compare d = c;
+        while (!r.empty ()) {
+            EXPECT_EQ (r.first (), d.first ());
+            EXPECT_EQ (r.size (), d.size ());
+            r = r.rest ();
+            d = d.rest ();
+        }
+    }
+
+    TEST (UnrolledStack, Stack) {
+        for (size_t n : {0, 1, 3, 4, 5, 8, 9, 50}) {
+            test_unrolled<pool::shared> (n);
+            test_unrolled<pool::local> (n);
+            test_unrolled<pool::concurrent> (n);
+        }
+    }
+
+    TEST (UnrolledStack, Persistence) {
+        // stacks that prepend onto the same stack must not see each other's elements.
+        unrolled<int> a {1, 2, 3, 4, 5, 6};
+        unrolled<int> r = a.rest ();
+        unrolled<int> b = r >> 10;
+        unrolled<int> c = r >> 20;
+        unrolled<int> d = c >> 30;
+        unrolled<int> e = b >> 40;
+
+        EXPECT_EQ (a, (unrolled<int> {1, 2, 3, 4, 5, 6}));
+        EXPECT_EQ (b, (unrolled<int> {10, 2, 3, 4, 5, 6}));
+        EXPECT_EQ (c, (unrolled<int> {20, 2, 3, 4, 5, 6}));
+        EXPECT_EQ (d, (unrolled<int> {30, 20, 2, 3, 4, 5, 6}));
+        EXPECT_EQ (e, (unrolled<int> {40, 10, 2, 3, 4, 5, 6}));
+
+        // elements can be changed through a non-const stack.
+        unrolled<string> x {"a", "b", "c", "d", "e"};
+        unrolled<string> y = x.rest () >> string {"z"};
+        EXPECT_EQ (y, (unrolled<string> {"z", "b", "c", "d", "e"}));
+        EXPECT_EQ (x, (unrolled<string> {"a", "b", "c", "d", "e"}));
+        EXPECT_EQ (last (x), "e");
+    }
+
+    TEST (UnrolledStack, Reference) {
+        int i = 1, j = 2, k = 3;
+        unrolled<int &> x {i, j, k};
+        unrolled<const int &> y = x;
+        for (int &z : x) z *= 10;
+        EXPECT_EQ (y, (unrolled<int> {10, 20, 30}));
+        EXPECT_EQ (i, 10);
+    }
+
+    TEST (UnrolledStack, Queue) {
+        using queue = functional_queue<unrolled<int>, int>;
+        queue q {};
+        for (int i = 0; i < 20; i++) q = q << i;
+        for (int i = 0; i < 20; i++) {
+            EXPECT_EQ (q.first (), i);
+            q = q.rest ();
+        }
+
+        EXPECT_TRUE (q.empty ());
+
+        // unrolled_stack has no transient, so neither does the queue, and
+        // select builds its result without one.
+        static_assert (!meta::has_transient<queue>);
+        static_assert (meta::has_transient<functional_queue<stack<int>, int>>);
+        EXPECT_EQ (select (queue {1, 2, 3, 4, 5, 6}, [] (int x) {
+            return x % 2 == 0;
+        }), (queue {2, 4, 6}));
+    }
+
+    TEST (UnrolledStack, List) {
+        static_assert (Same<list<int, functional_queue, unrolled<int>>, functional_queue<unrolled<int>, int>>);
+        static_assert (Queue<list<int, functional_queue, unrolled<int>>>);
+        static_assert (Queue<list<int, realtime_queue, unrolled<int>>>);
+
+        list<int, functional_queue, unrolled<int>> a {1, 2, 3};
+        list<int, realtime_queue, unrolled<int>> b {1, 2, 3};
+        for (int i = 4; i <= 20; i++) {
+            a <<= i;
+            b <<= i;
+        }
+
+        for (int i = 1; i <= 20; i++) {
+            EXPECT_EQ (first (a), i);
+            EXPECT_EQ (first (b), i);
+            a = rest (a);
+            b = rest (b);
+        }
+
+        EXPECT_TRUE (empty (a));
+        EXPECT_TRUE (empty (b));
+    }
+
+}
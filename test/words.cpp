@@ -0,0 +1,107 @@
+// Copyright (c) 2025 Daniel Krawisz
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <random>
+#include <data/arithmetic/words.hpp>
+#include "gtest/gtest.h"
+
+namespace data::arithmetic {
+
+    // compare the limb kernels against the digit-by-digit
+    // algorithms for sizes on either side of a limb.
+    template <endian::order r, std::unsigned_integral digit> void test_word_limbs (std::mt19937_64 &gen, size_t an, size_t bn) {
+        constexpr size_t digit_bits = sizeof (digit) * 8;
+        std::vector<digit> x (an);
+        std::vector<digit> y (bn);
+        for (digit &d : x) d = static_cast<digit> (gen ());
+        for (digit &d : y) d = static_cast<digit> (gen ());
+
+        // numbers made of all ones carry all the way through.
+        if (gen () % 4 == 0) for (digit &d : x) d = ~digit {0};
+
+        Words<r, digit> a {slice<digit> (x)};
+        Words<r, digit> b {slice<digit> (y)};
+
+        std::vector<digit> expected (an);
+        std::vector<digit> given (an);
+        Words<r, digit> e {slice<digit> (expected)};
+        Words<r, digit> g {slice<digit> (given)};
+
+        {
+            auto io = e.begin ();
+            auto ia = a.begin ();
+            auto ib = b.begin ();
+            bool carry = add_with_carry<digit> (io + bn, io, ia, ib);
+            carry = add_with_carry<digit> (e.end (), io, ia, carry ? digit {1} : digit {0});
+            EXPECT_EQ (plus_limbs (g, a, b), carry ? 1 : 0) << an << " " << bn;
+            EXPECT_EQ (given, expected) << an << " " << bn;
+        }
+
+        {
+            auto io = e.begin ();
+            auto ia = a.begin ();
+            auto ib = b.begin ();
+            bool borrow = subtract_with_carry<digit> (io + bn, io, ia, ib);
+            borrow = subtract_with_carry<digit> (e.end (), io, ia, borrow ? digit {1} : digit {0});
+            EXPECT_EQ (minus_limbs (g, a, b), borrow ? 1 : 0) << an << " " << bn;
+            EXPECT_EQ (given, expected) << an << " " << bn;
+        }
+
+        {
+            std::vector<digit> z (an - bn, 0);
+            z.insert (r == endian::little ? z.begin () : z.end (), y.begin (), y.end ());
+            Words<r, digit> c {slice<digit> (z)};
+            EXPECT_EQ (compare_limbs (a, b), arithmetic::compare (a.rbegin (), a.rend (), c.rbegin ())) << an << " " << bn;
+            EXPECT_EQ (compare_limbs (a, a), std::strong_ordering::equal);
+        }
+
+        for (uint32 shift : {0, 1, 7, 8, 13, 64, 65, 200})
+            for (bool fill : {false, true}) for (bool left : {false, true}) {
+                given = x;
+                if (left) bit_shift_left_limbs (g, shift, fill);
+                else bit_shift_right_limbs (g, shift, fill);
+
+                for (size_t i = 0; i < an * digit_bits; i++) {
+                    int64 j = left ? int64 (i) - int64 (shift) : int64 (i) + int64 (shift);
+                    bool bit = j < 0 || j >= int64 (an * digit_bits) ? fill : (a[j / digit_bits] >> (j % digit_bits)) & 1;
+                    ASSERT_EQ (bool ((g[i / digit_bits] >> (i % digit_bits)) & 1), bit)
+                        << an << " " << shift << " " << fill << " " << left;
+                }
+            }
+
+        {
+            std::vector<digit> z (an);
+            for (digit &d : z) d = static_cast<digit> (gen ());
+            Words<r, digit> c {slice<digit> (z)};
+
+            for (size_t i = 0; i < an; i++) expected[i] = x[i] ^ z[i];
+            bit_xor<digit> (g.begin (), g.end (), a.begin (), c.begin ());
+            EXPECT_EQ (given, expected);
+
+            for (size_t i = 0; i < an; i++) expected[i] = x[i] & z[i];
+            bit_and<digit> (g.begin (), g.end (), a.begin (), c.begin ());
+            EXPECT_EQ (given, expected);
+
+            for (size_t i = 0; i < an; i++) expected[i] = x[i] | z[i];
+            bit_or<digit> (g.begin (), g.end (), a.begin (), c.begin ());
+            EXPECT_EQ (given, expected);
+
+            for (size_t i = 0; i < an; i++) expected[i] = ~x[i];
+            bit_negate<digit> (g.begin (), g.end (), a.begin ());
+            EXPECT_EQ (given, expected);
+        }
+    }
+
+    TEST (Words, Limbs) {
+        std::mt19937_64 gen {1};
+        for (size_t an : {1, 2, 3, 7, 8, 9, 15, 16, 17, 40})
+            for (size_t bn : {1, 2, 3, 7, 8, 9, 15, 16, 17, 40}) if (bn <= an) {
+                test_word_limbs<endian::little, byte> (gen, an, bn);
+                test_word_limbs<endian::big, byte> (gen, an, bn);
+                test_word_limbs<endian::little, uint32> (gen, an, bn);
+                test_word_limbs<endian::big, uint32> (gen, an, bn);
+            }
+    }
+
+}